@@ -10,6 +10,7 @@
 
 #include "MemoryModel/PointerAnalysis.h"
 #include "DDA/DDAVFSolver.h"
+#include "DDA/DDASummary.h"
 #include "Util/DPItem.h"
 #include "Util/DataFlowUtil.h"
 
@@ -33,9 +34,7 @@ public:
     virtual void initialize(SVFModule module);
 
     /// Finalize analysis
-    virtual inline void finalize() {
-        CondPTAImpl<ContextCond>::finalize();
-    }
+    virtual void finalize();
 
     /// dummy analyze method
     virtual void analyze(SVFModule mod) {}
@@ -46,9 +45,18 @@ public:
     /// Compute points-to set for a context-sensitive pointer
     const CxtPtSet& computeDDAPts(const CxtVar& cxtVar);
 
+    /// Create a solver answering queries concurrently with this one
+    virtual PointerAnalysis* createDDAWorker();
+
+    /// Copy the points-to of a query answered by a worker
+    virtual void mergeDDAPts(PointerAnalysis* worker, NodeID id);
+
     /// Handle out-of-budget dpm
     void handleOutOfBudgetDpm(const CxtLocDPItem& dpm);
 
+    /// Compute points-to, recording the dpms traversed to build a summary
+    virtual const CxtPtSet& findPT(const CxtLocDPItem& dpm);
+
     /// Override parent method
     CxtPtSet getConservativeCPts(const CxtLocDPItem& dpm) {
         const PointsTo& pts =  getAndersenAnalysis()->getPts(dpm.getCurNodeID());
@@ -87,9 +95,8 @@ public:
     inline virtual void popRecursiveCallSites(CxtLocDPItem& dpm) {
         ContextCond& cxtCond = dpm.getCond();
         cxtCond.setNonConcreteCxt();
-        CallStrCxt& cxt = cxtCond.getContexts();
-        while(!cxt.empty() && isEdgeInRecursion(cxt.back())) {
-            cxt.pop_back();
+        while(cxtCond.cxtSize() > 0 && cxtCond.back() != summaryCxtID && isEdgeInRecursion(cxtCond.back())) {
+            cxtCond.popContext();
         }
     }
     /// Whether call/return inside recursion
@@ -171,11 +178,40 @@ public:
         return "Context Sensitive DDA";
     }
 
+protected:
+    /// dpm transit during backward tracing, returns of functions are replaced by their summaries
+    virtual void backwardPropDpm(CxtPtSet& pts, NodeID ptr, const CxtLocDPItem& oldDpm, const SVFGEdge* edge);
+
+    /// Summaries of the returns of functions.
+    /// A summary is built by a traversal from the formal-ret whose contexts start with summaryCxtID,
+    /// so the traversal fails when it reaches the formal-ins of the function with the context of summaryCxtID only.
+    //@{
+    static const CallSiteID summaryCxtID = 0;
+    /// Whether this is the context of a dpm traversed to build a summary
+    inline bool isSummaryCxt(const ContextCond& cxt) const {
+        return cxt.cxtSize() > 0 && CallStrCxtTrie::front(cxt.getContexts()) == summaryCxtID;
+    }
+    /// Add the objects of a summary for a return edge, return false if there is no summary
+    bool applySummary(CxtPtSet& pts, NodeID ptr, const CxtLocDPItem& oldDpm, const SVFGEdge* edge);
+    /// Build the summary of a formal-ret, return false if its objects depend on the callers
+    bool buildSummary(const SVFGNode* formalRet, NodeID ptr);
+    /// Remove the dpms traversed to build a summary from the traversal states
+    void clearSummaryDpms();
+    /// Path of the summaries in the analysis cache
+    std::string getSummaryPath() const;
+    //@}
+
 private:
     ConstSVFGEdgeSet insensitveEdges;///< insensitive call-return edges
     FlowDDA* flowDDA;			///< downgrade to flowDDA if out-of-budget
     DDAClient* _client;			///< DDA client
     PTACFInfoBuilder loopInfoBuilder; ///< LoopInfo
+    bool useSummaries;			///< whether summaries are used by this solver
+    DDASummaryStore* summaryStore;	///< summaries of the returns of functions
+    const Function* summaryFun;	///< function whose summary is being built
+    DDASummary* curSummary;		///< summary being built
+    bool summaryFailed;			///< whether the summary being built depends on the callers
+    DPTItemSet summaryDpms;		///< dpms traversed to build the summary
 };
 
 
@@ -76,6 +76,8 @@ protected:
         if (pag->isValidTopLevelPtr(pag->getPAGNode(id)))
             candidateQueries.insert(id);
     }
+    /// Answer candidate queries using solvers running on numOfThreads threads
+    void answerQueriesConcurrently(PointerAnalysis* pta, u32_t numOfThreads);
 
     PAG*   pag;					///< PAG graph used by current DDA analysis
     SVFModule module;		///< LLVM module
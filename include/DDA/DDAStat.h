@@ -28,6 +28,9 @@ public:
     u32_t _NumOfStrongUpdates;
     u32_t _NumOfMustAliases;
     u32_t _NumOfInfeasiblePath;
+    u32_t _NumOfSummaryBuilt;
+    u32_t _NumOfSummaryApplied;
+    u32_t _NumOfSummaryRead;
 
     u64_t _NumOfStep;
     u64_t _NumOfStepInCycle;
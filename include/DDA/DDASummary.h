@@ -0,0 +1,169 @@
+//===- DDASummary.h -- Summaries of functions for demand-driven analysis-----//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * DDASummary.h
+ *
+ * Summaries of the returns of functions for context-sensitive DDA, which
+ * are reused within a run and stored for later runs on changed modules
+ */
+
+#ifndef DDASUMMARY_H_
+#define DDASUMMARY_H_
+
+#include "MSSA/SVFG.h"
+#include "Util/PTACallGraph.h"
+
+/*!
+ * Objects returned by a function. Only returns whose backward traversal never
+ * leaves the function through its formal-ins are summarised, so a summary does
+ * not depend on the callers of the function.
+ */
+class DDASummary {
+public:
+    /// An object allocated in the function or its callees, and the call string
+    /// from the function to the allocation
+    struct LocalObj {
+        NodeID obj;
+        CallStrCxt cxt;
+        bool concrete;
+
+        LocalObj(NodeID o, const CallStrCxt& c, bool con): obj(o), cxt(c), concrete(con) {
+        }
+        inline bool operator< (const LocalObj& rhs) const {
+            if (obj != rhs.obj)
+                return obj < rhs.obj;
+            if (concrete != rhs.concrete)
+                return concrete < rhs.concrete;
+            return cxt < rhs.cxt;
+        }
+    };
+    typedef std::set<LocalObj> LocalObjSet;
+    typedef PTACallGraph::FunctionSet FunctionSet;
+
+    /// Returned objects
+    inline const LocalObjSet& getLocalObjs() const {
+        return localObjs;
+    }
+    inline void addLocalObj(NodeID obj, const CallStrCxt& cxt, bool concrete) {
+        localObjs.insert(LocalObj(obj, cxt, concrete));
+    }
+    /// Functions whose statements are traversed, the summary is invalid once any of them changes
+    inline const FunctionSet& getFunctions() const {
+        return funs;
+    }
+    inline void addFunction(const Function* fun) {
+        funs.insert(fun);
+    }
+
+private:
+    LocalObjSet localObjs;
+    FunctionSet funs;
+};
+
+/*!
+ * Summaries keyed by the formal-ret SVFG nodes of functions.
+ *
+ * Summaries are stored as text, with functions, objects and call sites named by
+ * keys which do not change across runs:
+ *   summary <function>
+ *   fun <function> <hash of the function>        (one per traversed function)
+ *   obj <object> <0|1 concrete> <call site>*     (one per returned object)
+ *   end
+ * An object is @<global> or %<function>#<instruction index>, followed by
+ * +<field index>.<byte offset> for a field, or blackhole or constant.
+ * A call site is <caller>#<instruction index>><callee>.
+ *
+ * The file is shared by the runs on different programs, so the summaries read
+ * but not valid for this program are written back unless this program writes
+ * one of the same function with the same hash.
+ */
+class DDASummaryStore {
+public:
+    typedef std::map<NodeID, DDASummary> SummaryMap;
+
+    /// Constructor
+    DDASummaryStore(SVFModule mod, SVFG* g, PTACallGraph* cg):
+        module(mod), svfg(g), callgraph(cg), changed(false), indexed(false) {
+    }
+
+    /// Summary of the return of a function
+    //@{
+    inline bool hasSummary(NodeID formalRet) const {
+        return summaries.find(formalRet) != summaries.end();
+    }
+    inline const DDASummary& getSummary(NodeID formalRet) const {
+        SummaryMap::const_iterator it = summaries.find(formalRet);
+        assert(it != summaries.end() && "summary not found!");
+        return it->second;
+    }
+    inline void addSummary(NodeID formalRet, const DDASummary& summary) {
+        summaries[formalRet] = summary;
+        changed = true;
+    }
+    //@}
+
+    /// Read the summaries whose functions are unchanged, return the number of summaries read
+    u32_t read(const std::string& path);
+
+    /// Write the summaries if any has been added since they are read or written
+    void write(const std::string& path);
+
+private:
+    /// Keys of functions, objects and call sites
+    //@{
+    bool getFunctionKey(const Function* fun, std::string& key);
+    bool getValueKey(const Value* val, std::string& key);
+    bool getObjKey(NodeID id, std::string& key);
+    bool getObj(const std::string& key, NodeID& id);
+    bool getCallSiteKey(CallSiteID csId, std::string& key);
+    bool getCallSite(const std::string& key, CallSiteID& csId);
+    //@}
+
+    /// Index the instructions of a function
+    const std::vector<const Instruction*>& getInstructions(const Function* fun);
+    /// Index the base objects by their keys
+    void indexObjs();
+    /// Hash of a function computed once
+    const std::string& getFunctionHash(const Function* fun);
+    /// Whether a summary can be written, the callees of indirect calls depend on the whole program
+    bool isStorable(const DDASummary& summary);
+    /// Identity of a stored summary, its function key and the hash of the function
+    static inline std::string getSummaryIdentity(const std::string& funKey, const std::string& hash) {
+        return funKey + " " + hash;
+    }
+
+    SVFModule module;
+    SVFG* svfg;
+    PTACallGraph* callgraph;
+    SummaryMap summaries;
+    bool changed;		///< whether summaries are added since they are read or written
+    bool indexed;		///< whether keyToObj is built
+    llvm::StringMap<NodeID> keyToObj;	///< base object of a key
+    std::set<std::string> ambiguousKeys;	///< keys of more than one base object
+    std::map<const Function*, std::vector<const Instruction*> > funToInsts;
+    llvm::DenseMap<const Instruction*, u32_t> instToIndex;
+    std::map<const Function*, std::string> funToHash;
+    std::vector<std::pair<std::string, std::string> > otherSummaries;	///< (identity, text) of summaries read but not valid for this program
+};
+
+#endif /* DDASUMMARY_H_ */
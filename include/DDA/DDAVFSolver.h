@@ -12,7 +12,75 @@
 #include "MSSA/SVFGBuilder.h"
 #include "WPA/Andersen.h"
 #include "Util/SCC.h"
+#include "Util/DPItem.h"
 #include <algorithm>
+#include <mutex>
+
+/*!
+ * Points-to of resolved dpms shared by solvers answering queries concurrently.
+ * Dpms are spread over stripes, each of which is guarded by its own lock.
+ * Every solver builds its own SVFG, so dpms are keyed by the IDs of their
+ * locations, which are the same in all of them, rather than by the nodes.
+ */
+template<class DPIm, class CPtSet>
+class DPMPtsCache {
+public:
+    /// Order dpms by (location ID, var, condition) without comparing pointers
+    struct DPMKeyLess {
+        inline bool operator()(const DPIm& lhs, const DPIm& rhs) const {
+            if (lhs.getLoc()->getId() != rhs.getLoc()->getId())
+                return lhs.getLoc()->getId() < rhs.getLoc()->getId();
+            if (lhs.getCurNodeID() != rhs.getCurNodeID())
+                return lhs.getCurNodeID() < rhs.getCurNodeID();
+            return condLess(lhs, rhs);
+        }
+        template<class LocCond>
+        static inline bool condLess(const StmtDPItem<LocCond>&, const StmtDPItem<LocCond>&) {
+            return false;
+        }
+        template<class LocCond>
+        static inline bool condLess(const CxtStmtDPItem<LocCond>& lhs, const CxtStmtDPItem<LocCond>& rhs) {
+            return lhs.getCond() < rhs.getCond();
+        }
+    };
+    typedef std::map<DPIm, CPtSet, DPMKeyLess> DPImToCPtSetMap;
+
+    /// Constructor
+    DPMPtsCache(u32_t numOfStripes = 64): stripes(numOfStripes) {
+    }
+
+    /// Copy the points-to of a resolved dpm into pts, return false if it is not resolved yet
+    bool find(const DPIm& dpm, bool topLevel, CPtSet& pts) {
+        Stripe& stripe = getStripe(dpm);
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        const DPImToCPtSetMap& dpmToPts = topLevel ? stripe.tlPts : stripe.adPts;
+        typename DPImToCPtSetMap::const_iterator it = dpmToPts.find(dpm);
+        if (it == dpmToPts.end())
+            return false;
+        pts = it->second;
+        return true;
+    }
+    /// Add the points-to of a resolved dpm
+    void add(const DPIm& dpm, bool topLevel, const CPtSet& pts) {
+        Stripe& stripe = getStripe(dpm);
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        DPImToCPtSetMap& dpmToPts = topLevel ? stripe.tlPts : stripe.adPts;
+        dpmToPts[dpm] |= pts;
+    }
+
+private:
+    struct Stripe {
+        std::mutex mutex;
+        DPImToCPtSetMap tlPts;	///< top-level vars
+        DPImToCPtSetMap adPts;	///< address-taken vars
+    };
+
+    inline Stripe& getStripe(const DPIm& dpm) {
+        return stripes[(dpm.getLoc()->getId() * 31 + dpm.getCurNodeID()) % stripes.size()];
+    }
+
+    std::vector<Stripe> stripes;
+};
 
 /*!
  * Value-Flow Based Demand-Driven Points-to Analysis
@@ -33,9 +101,11 @@ public:
     typedef std::set<const SVFGEdge* > ConstSVFGEdgeSet;
     typedef SVFGEdge::SVFGEdgeSetTy SVFGEdgeSet;
     typedef std::map<const SVFGNode*, DPTItemSet> StoreToPMSetMap;
+    typedef DPMPtsCache<DPIm, CPtSet> SharedPtsCache;
 
     ///Constructor
-    DDAVFSolver(): outOfBudgetQuery(false),_pag(NULL),_svfg(NULL),_ander(NULL),_callGraph(NULL), _callGraphSCC(NULL), _svfgSCC(NULL), ddaStat(NULL) {
+    DDAVFSolver(): outOfBudgetQuery(false),_pag(NULL),_svfg(NULL),_ander(NULL),_callGraph(NULL), _callGraphSCC(NULL), _svfgSCC(NULL), ddaStat(NULL),
+        sharedCache(NULL), ownSharedCache(false) {
     }
     /// Destructor
     virtual ~DDAVFSolver() {
@@ -55,6 +125,10 @@ public:
 
         _callGraph = NULL;
         _callGraphSCC = NULL;
+
+        if (ownSharedCache)
+            delete sharedCache;
+        sharedCache = NULL;
     }
     /// Return candidate pointers for DDA
     inline NodeBS& getCandidateQueries() {
@@ -73,6 +147,48 @@ public:
     virtual void addDDAPts(CPtSet& pts, const CVar& var) {
         pts.set(var);
     }
+    /// Points-to cache shared by solvers answering queries concurrently
+    //@{
+    /// Return the cache owned by this solver, which is created on the first call
+    inline SharedPtsCache* shareCache() {
+        if (sharedCache == NULL) {
+            createFieldObjs();
+            /// workers only read the pre-analysis after its points-to of every node is created here
+            for (PAG::iterator it = _pag->begin(), eit = _pag->end(); it != eit; ++it)
+                _ander->getPts(it->first);
+            sharedCache = new SharedPtsCache();
+            ownSharedCache = true;
+        }
+        return sharedCache;
+    }
+    /// Use the cache owned by another solver
+    inline void setSharedCache(SharedPtsCache* cache) {
+        sharedCache = cache;
+        ownSharedCache = false;
+    }
+    //@}
+    /// Create the field objects a gep can reach, i.e., those of the objects in the
+    /// pre-analysis points-to of its pointer, so that solvers answering queries
+    /// concurrently find them in the PAG instead of adding them
+    void createFieldObjs() {
+        PAGEdge::PAGEdgeSetTy& variantGeps = _pag->getEdgeSet(PAGEdge::VariantGep);
+        for (PAGEdge::PAGEdgeSetTy::iterator it = variantGeps.begin(), eit = variantGeps.end(); it != eit; ++it) {
+            const PointsTo& pts = _ander->getPts((*it)->getSrcID());
+            for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit) {
+                if (!_pag->isBlkObjOrConstantObj(*pit))
+                    const_cast<MemObj*>(_pag->getBaseObj(*pit))->setFieldInsensitive();
+            }
+        }
+        PAGEdge::PAGEdgeSetTy& normalGeps = _pag->getEdgeSet(PAGEdge::NormalGep);
+        for (PAGEdge::PAGEdgeSetTy::iterator it = normalGeps.begin(), eit = normalGeps.end(); it != eit; ++it) {
+            const NormalGepPE* gep = SVFUtil::cast<NormalGepPE>(*it);
+            const PointsTo& pts = _ander->getPts(gep->getSrcID());
+            for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit) {
+                if (!_pag->isBlkObjOrConstantObj(*pit))
+                    _pag->getGepObjNode(*pit, gep->getLocationSet());
+            }
+        }
+    }
     /// Return SVFG
     inline SVFG* getSVFG() const {
         return _svfg;
@@ -101,6 +217,10 @@ public:
             return cpts;
         }
 
+        /// reuse the points-to resolved by another solver
+        if(sharedCache && findSharedPointsTo(dpm))
+            return getCachedPointsTo(dpm);
+
         DBOUT(DDDA, SVFUtil::outs() << "\t backward visit dpm: ");
         DBOUT(DDDA, dpm.dump());
         markbkVisited(dpm);
@@ -254,6 +374,26 @@ protected:
         outOfBudgetQuery = false;
         ddaStat->_NumOfStep = 0;
     }
+    /// Take the points-to of a dpm resolved by another solver, which is then treated as visited
+    inline bool findSharedPointsTo(const DPIm& dpm) {
+        CPtSet pts;
+        if (sharedCache->find(dpm, isTopLevelPtrStmt(dpm.getLoc()), pts) == false)
+            return false;
+        unionDDAPts(getCachedPointsTo(dpm), pts);
+        markbkVisited(dpm);
+        return true;
+    }
+    /// Share the points-to of dpms resolved by the current query if it is within budget
+    inline void sharePointsToOfQuery() {
+        if (sharedCache == NULL || outOfBudgetQuery)
+            return;
+        for(typename LocToDPMVecMap::const_iterator it = locToDpmSetMap.begin(),eit = locToDpmSetMap.end(); it!=eit; ++it) {
+            for(typename DPTItemSet::const_iterator dit = it->second.begin(),deit=it->second.end(); dit!=deit; ++dit) {
+                if(isOutOfBudgetDpm(*dit)==false)
+                    sharedCache->add(*dit, isTopLevelPtrStmt(dit->getLoc()), getCachedPointsTo(*dit));
+            }
+        }
+    }
     /// Reset visited map if the current query is out-of-budget
     inline void OOBResetVisited() {
         for(typename LocToDPMVecMap::const_iterator it = locToDpmSetMap.begin(),eit = locToDpmSetMap.end(); it!=eit; ++it) {
@@ -651,6 +791,8 @@ protected:
     StoreToPMSetMap storeToDPMs;	///< map store to set of DPM which have been stong updated there
     DDAStat* ddaStat;				///< DDA stat
     SVFGBuilder svfgBuilder;			///< SVFG Builder
+    SharedPtsCache* sharedCache;	///< points-to shared with solvers answering queries concurrently
+    bool ownSharedCache;			///< whether sharedCache is released by this solver
 };
 
 
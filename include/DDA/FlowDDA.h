@@ -39,6 +39,12 @@ public:
     /// Compute points-to set for all top variable
     void computeDDAPts(NodeID id);
 
+    /// Create a solver answering queries concurrently with this one
+    virtual PointerAnalysis* createDDAWorker();
+
+    /// Copy the points-to of a query answered by a worker
+    virtual void mergeDDAPts(PointerAnalysis* worker, NodeID id);
+
     /// Handle out-of-budget dpm
     void handleOutOfBudgetDpm(const LocDPItem& dpm);
 
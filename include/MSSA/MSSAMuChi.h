@@ -54,6 +54,16 @@ public:
     MRVer(const MemRegion* m, VERSION v, MSSADef* d) :
         mr(m), version(v), vid(totalVERNum++),def(d) {
     }
+    /// Constructor of a version whose ID is assigned later by assignID,
+    /// used when versions are created concurrently
+    MRVer(const MemRegion* m, VERSION v, MSSADef* d, bool deferID) :
+        mr(m), version(v), vid(deferID ? 0 : totalVERNum++),def(d) {
+    }
+
+    /// Assign the next ID to a version created with a deferred ID
+    inline void assignID() {
+        vid = totalVERNum++;
+    }
 
     /// Return the memory region
     inline const MemRegion* getMR() const {
@@ -398,6 +398,12 @@ public:
     inline MRSet& getStoreMRSet(const StorePE* store) {
         return storesToMRsMap[store];
     }
+    inline bool hasLoadMRSet(const LoadPE* load) const {
+        return loadsToMRsMap.find(load)!=loadsToMRsMap.end();
+    }
+    inline bool hasStoreMRSet(const StorePE* store) const {
+        return storesToMRsMap.find(store)!=storesToMRsMap.end();
+    }
     inline bool hasRefMRSet(CallSite cs) {
         return callsiteToRefMRsMap.find(cs)!=callsiteToRefMRsMap.end();
     }
@@ -37,6 +37,22 @@
 
 class PointerAnalysis;
 class MemSSAStat;
+
+/*!
+ * Dominator frontier used in MSSA
+ */
+class MemSSADF : public DominanceFrontier {
+public:
+    MemSSADF() : DominanceFrontier()
+    {}
+
+    bool runOnDT(DominatorTree& dt) {
+        releaseMemory();
+        analyze(dt);
+        return false;
+    }
+};
+
 /*
  * Memory SSA implementation on top of partial SSA
  */
@@ -92,12 +108,17 @@ public:
     /// PAG edge list
     typedef PAG::PAGEdgeList PAGEdgeList;
 
+    /// Functions whose memory SSA is built concurrently
+    typedef std::vector<const Function*> FunctionList;
+    typedef std::set<const Function*> FunctionSet;
+
     /// Statistics
     //@{
     static double timeOfGeneratingMemRegions;	///< Time for allocating regions
     static double timeOfCreateMUCHI;	///< Time for generating mu/chi for load/store/calls
     static double timeOfInsertingPHI;	///< Time for inserting phis
     static double timeOfSSARenaming;	///< Time for SSA rename
+    static double timeOfParallelBuild;	///< Time for building functions concurrently
     //@}
 
 protected:
@@ -139,9 +160,56 @@ private:
     MRSet varKills;
     //@}
 
+    /// What a worker creates and looks up while building a function, which is
+    /// committed in the order of the functions after all workers finish
+    struct FunBuildRecord {
+        std::vector<MRVer*> vers;	///< versions whose IDs are not assigned yet
+        std::vector<const LoadPE*> loadsWithoutMR;	///< loads not in the MRGenerator
+        std::vector<const StorePE*> storesWithoutMR;	///< stores not in the MRGenerator
+    };
+
+    /// Worker state, set only when this builds functions for another memory SSA
+    //@{
+    bool worker;
+    FunBuildRecord* funRecord;	///< record of the function being built
+    const FunctionSet* noRetFuns;	///< functions without a reachable return
+    //@}
+
+    /// Constructor of a worker, which shares the pointer analysis and regions of mssa
+    MemSSA(MemSSA* mssa, const FunctionSet* noRet);
+
+    /// Move the mus/chis/phis built by a worker into this memory SSA
+    void mergeWorker(MemSSA* w);
+
     /// Release the memory
     void destroy();
 
+    /// Regions of a load/store. A worker does not insert into the shared MRGenerator,
+    /// a load/store without regions is recorded and inserted when it is committed
+    //@{
+    inline const MRSet& getLoadMRSet(const LoadPE* load) {
+        if (!worker || mrGen->hasLoadMRSet(load))
+            return mrGen->getLoadMRSet(load);
+        static const MRSet emptyMRSet;
+        funRecord->loadsWithoutMR.push_back(load);
+        return emptyMRSet;
+    }
+    inline const MRSet& getStoreMRSet(const StorePE* store) {
+        if (!worker || mrGen->hasStoreMRSet(store))
+            return mrGen->getStoreMRSet(store);
+        static const MRSet emptyMRSet;
+        funRecord->storesWithoutMR.push_back(store);
+        return emptyMRSet;
+    }
+    //@}
+
+    /// Whether a function has no reachable return instruction from its entry
+    inline bool doesNotRet(const Function& fun) const {
+        if (worker)
+            return noRetFuns->count(&fun);
+        return SVFUtil::functionDoesNotRet(&fun);
+    }
+
     /// Get a new SSA name of a memory region
     MRVer* newSSAName(const MemRegion* mr, MSSADEF* def);
 
@@ -289,6 +357,10 @@ public:
     /// We start from here
     virtual void buildMemSSA(const Function& fun,DominanceFrontier*, DominatorTree*);
 
+    /// Build memory SSA for functions using numOfThreads threads.
+    /// The result is the same as calling buildMemSSA for each function in order
+    void buildMemSSA(const FunctionList& funs, u32_t numOfThreads);
+
     /// Perform statistics
     void performStat();
 
@@ -32,21 +32,6 @@
 
 #include "MSSA/SVFGOPT.h"
 
-/*!
- * Dominator frontier used in MSSA
- */
-class MemSSADF : public DominanceFrontier {
-public:
-    MemSSADF() : DominanceFrontier()
-    {}
-
-    bool runOnDT(DominatorTree& dt) {
-        releaseMemory();
-        analyze(dt);
-        return false;
-    }
-};
-
 /*!
  * SVFG Builder
  */
@@ -66,6 +51,9 @@ public:
 
     static SVFG* globalSvfg;
 
+    /// Whether a single SVFG is shared by all analyses (-singleVFG)
+    static bool isSingleVFG();
+
 	SVFG* buildPTROnlySVFG(BVDataPTAImpl* pta);
     SVFG* buildPTROnlySVFGWithoutOPT(BVDataPTAImpl* pta);
 	SVFG* buildFullSVFG(BVDataPTAImpl* pta);
@@ -51,6 +51,7 @@ public:
     static const char* TimeOfCreateMUCHI;	///< Time for generating mu/chi for load/store/calls
     static const char* TimeOfInsertingPHI;	///< Time for inserting phis
     static const char* TimeOfSSARenaming;	///< Time for SSA rename
+    static const char* TimeOfParallelBuild;	///< Time for building functions concurrently
 
     static const char* NumOfMaxRegion;	///< Number of max points-to set in region.
     static const char* NumOfAveragePtsInRegion;	///< Number of average points-to set in region.
@@ -15,6 +15,7 @@
 
 class MHP;
 class LockAnalysis;
+class PCG;
 
 /*!
  * SVFG builder for DDA
@@ -44,6 +45,7 @@ public:
     static u32_t numOfNewSVFGEdges;
     static u32_t numOfRemovedSVFGEdges;
     static u32_t numOfRemovedPTS;
+    static u32_t numOfCandidatePairs;	///< (store, load) and (store, store) pairs checked for MHP
 
 protected:
     /// Re-write create SVFG method
@@ -60,6 +62,10 @@ private:
     SVFGEdge* addTDEdges(NodeID srcId, NodeID dstId, PointsTo& pts);
     /// Connect MHP indirect value-flow edges for two nodes that may-happen-in-parallel
     void connectMHPEdges(PointerAnalysis* pta);
+    /// Check every (store, load) and (store, store) pair
+    void connectAllPairs(PointerAnalysis* pta, PCG* pcg);
+    /// Check only the pairs accessing a common object, found by indexing loads and stores by objects
+    void connectAliasedPairs(PointerAnalysis* pta);
 
     void handleStoreLoadNonSparse(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
     void handleStoreStoreNonSparse(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
@@ -67,6 +73,10 @@ private:
     void handleStoreLoad(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
     void handleStoreStore(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
 
+    /// Add the edges of a may-happen-in-parallel pair accessing pts, taking locks into account
+    void addStoreLoadEdges(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointsTo& pts);
+    void addStoreStoreEdges(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointsTo& pts);
+
     void handleStoreLoadWithLockPrecisely(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
     void handleStoreStoreWithLockPrecisely(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
 
@@ -118,7 +118,7 @@ public:
     /// Context-sensitive locks
     //@{
     /// Add inter-procedural context-sensitive lock
-    inline void addCxtLock(const CallStrCxt& cxt,const Instruction* inst) {
+    inline void addCxtLock(CallStrCxtID cxt,const Instruction* inst) {
         CxtLock cxtlock(cxt,inst);
         cxtLockset.insert(cxtlock);
         DBOUT(DMTA, SVFUtil::outs() << "LockAnalysis Process new lock "; cxtlock.dump());
@@ -350,9 +350,9 @@ private:
     //@}
 
     /// Push calling context
-    void pushCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee);
+    void pushCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee);
     /// Match context
-    bool matchCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee);
+    bool matchCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee);
 
     void validateResults();
 
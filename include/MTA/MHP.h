@@ -17,6 +17,64 @@
 class ForkJoinAnalysis;
 class LockAnalysis;
 
+/*!
+ * All-pairs MHP relation of a set of instructions.
+ * Instructions whose thread statements have the same (thread, interleaving) signature
+ * always get the same MHP answer, so the relation is stored as a bit matrix over
+ * signature groups plus a map from each instruction to its group.
+ */
+class MHPMatrix {
+public:
+    typedef llvm::DenseMap<const Instruction*, u32_t> InstToGroupMap;
+    typedef std::vector<NodeBS> GroupMatrix;
+
+    /// Group of instructions that are not executed by any thread
+    static const u32_t NoGroup = ~0U;
+
+    MHPMatrix(): numOfMHPPairs(0) {
+    }
+
+    /// Whether two instructions of the matrix may happen in parallel
+    inline bool mayHappenInParallel(const Instruction* i1, const Instruction* i2) const {
+        u32_t g1 = getGroup(i1);
+        u32_t g2 = getGroup(i2);
+        if (g1 == NoGroup || g2 == NoGroup)
+            return false;
+        return groupRel[g1].test(g2);
+    }
+
+    /// Get the signature group of an instruction
+    inline u32_t getGroup(const Instruction* inst) const {
+        InstToGroupMap::const_iterator it = instToGroup.find(inst);
+        assert(it != instToGroup.end() && "instruction is not in the matrix!");
+        return it->second;
+    }
+    inline bool hasInst(const Instruction* inst) const {
+        return instToGroup.find(inst) != instToGroup.end();
+    }
+
+    /// Statistics
+    //@{
+    inline u32_t getNumOfInsts() const {
+        return instToGroup.size();
+    }
+    inline u32_t getNumOfGroups() const {
+        return groupRel.size();
+    }
+    /// Number of MHP group pairs, counting (g1,g2) and (g2,g1) once
+    inline u32_t getNumOfMHPGroupPairs() const {
+        return numOfMHPPairs;
+    }
+    //@}
+
+private:
+    InstToGroupMap instToGroup;	///< instruction to its signature group
+    GroupMatrix groupRel;		///< row g is the set of groups that may happen in parallel with g
+    u32_t numOfMHPPairs;
+
+    friend class MHP;
+};
+
 /*!
  * This class serves as a base may-happen in parallel analysis for multithreaded program
  * Given a statement under an abstract thread, it tells which abstract threads may be alive at the same time (May-happen-in-parallel).
@@ -80,6 +138,9 @@ public:
     virtual bool mayHappenInParallelInst(const Instruction* i1, const Instruction* i2);
     virtual bool executedByTheSameThread(const Instruction* i1, const Instruction* i2);
 
+    /// Compute the MHP relation of all pairs of instructions in insts in one pass
+    void computeMHPMatrix(const InstSet& insts, MHPMatrix& matrix);
+
     /// Get interleaving thread for statement inst
     //@{
     inline const NodeBS& getInterleavingThreads(const CxtThreadStmt& cts) {
@@ -180,11 +241,11 @@ private:
         tct->getNextInsts(inst,instVec);
     }
     /// Push calling context
-    inline void pushCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee) {
+    inline void pushCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee) {
         tct->pushCxt(cxt,call,callee);
     }
     /// Match context
-    inline bool matchCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee) {
+    inline bool matchCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee) {
         return tct->matchCxt(cxt,call,callee);
     }
 
@@ -208,10 +269,10 @@ private:
     }
 
     /// Return thread id(s) which are directly or indirectly joined at this join site
-    NodeBS getDirAndIndJoinedTid(const CallStrCxt& cxt, const Instruction* call);
+    NodeBS getDirAndIndJoinedTid(CallStrCxtID cxt, const Instruction* call);
 
     /// Whether a context-sensitive join satisfies symmetric loop pattern
-    const Loop* isJoinInSymmetricLoop(const CallStrCxt& cxt, const Instruction* call) const;
+    const Loop* isJoinInSymmetricLoop(CallStrCxtID cxt, const Instruction* call) const;
 
     /// Whether thread t1 happens before t2 based on ForkJoin Analysis
     bool isHBPair(NodeID tid1, NodeID tid2);
@@ -230,6 +291,7 @@ public:
     u32_t numOfMHPQueries;			///< Number of queries are answered as may-happen-in-parallel
     double interleavingTime;
     double interleavingQueriesTime;
+    double bulkQueriesTime;
 };
 
 
@@ -399,11 +461,11 @@ private:
         tct->getNextInsts(inst,instSet);
     }
     /// Push calling context
-    inline void pushCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee) {
+    inline void pushCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee) {
         tct->pushCxt(cxt,call,callee);
     }
     /// Match context
-    inline bool matchCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee) {
+    inline bool matchCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee) {
         return tct->matchCxt(cxt,call,callee);
     }
 
@@ -47,7 +47,7 @@ protected:
     // Get special arguments of given call sites
     NodeID getIntArg(const Instruction* inst, unsigned int arg_num);
     std::vector<std::string> getStringArg(const Instruction* inst, unsigned int arg_num);
-    CallStrCxt getCxtArg(const Instruction* inst, unsigned int arg_num);
+    CallStrCxtID getCxtArg(const Instruction* inst, unsigned int arg_num);
 
     /*
      * Get the previous LoadInst or StoreInst from Instruction "I" in the
@@ -56,10 +56,10 @@ protected:
     const Instruction *getPreviousMemoryAccessInst(const Instruction *I);
 
     // Compare two cxts
-    bool matchCxt(const CallStrCxt cxt1, const CallStrCxt cxt2) const;
+    bool matchCxt(CallStrCxtID cxt1, CallStrCxtID cxt2) const;
 
     // Dump calling context information
-    void dumpCxt(const CallStrCxt& cxt) const;
+    void dumpCxt(CallStrCxtID cxt) const;
 
     void dumpInterlev(NodeBS& lev);
 
@@ -111,7 +111,7 @@ protected:
 private:
 
     std::map<NodeID, const CallInst*> csnumToInstMap;
-    std::map<NodeID, CallStrCxt> vthdToCxt;
+    std::map<NodeID, CallStrCxtID> vthdToCxt;
     std::map<NodeID, NodeID> vthdTorthd;
     std::map<NodeID, NodeID> rthdTovthd;
 
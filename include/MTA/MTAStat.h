@@ -24,7 +24,8 @@ public:
     typedef std::set<const Instruction*> InstSet;
 
     /// Constructor
-    MTAStat():PTAStat(NULL),TCTTime(0),MHPTime(0),FSMPTATime(0),AnnotationTime(0) {
+    MTAStat():PTAStat(NULL),TCTTime(0),MHPTime(0),FSMPTATime(0),AnnotationTime(0),numOfMHPGroups(0),bulkMHPPairs(0),
+        allPairMHPTime(0),allPairBulkMHPTime(0) {
     }
     /// Statistics for thread call graph
     void performThreadCallGraphStat(ThreadCallGraph* tcg);
@@ -39,6 +40,12 @@ public:
     double MHPTime;
     double FSMPTATime;
     double AnnotationTime;
+
+    /// Statistics of the bulk all-pairs MHP matrix
+    u32_t numOfMHPGroups;
+    u32_t bulkMHPPairs;
+    double allPairMHPTime;		///< time of answering the all pairs by per-pair queries
+    double allPairBulkMHPTime;	///< time of answering the same pairs by the matrix, including building it
 };
 
 
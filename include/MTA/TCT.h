@@ -105,7 +105,7 @@ public:
     typedef std::set<const Instruction*> InstSet;
     typedef std::set<const PTACallGraphNode*> PTACGNodeSet;
     typedef std::map<const CxtThread,TCTNode*> CxtThreadToNodeMap;
-    typedef std::map<const CxtThread,CallStrCxt> CxtThreadToForkCxt;
+    typedef std::map<const CxtThread,CallStrCxtID> CxtThreadToForkCxt;
     typedef std::map<const CxtThread,const Function*> CxtThreadToFun;
     typedef std::map<const Instruction*, const Loop*> InstToLoopMap;
     typedef FIFOWorkList<CxtThreadProc> CxtThreadProcVec;
@@ -255,7 +255,7 @@ public:
     //@}
 
     /// get the context of a thread at its spawning site (fork site)
-    const CallStrCxt& getCxtOfCxtThread(const CxtThread& ct) const {
+    CallStrCxtID getCxtOfCxtThread(const CxtThread& ct) const {
         CxtThreadToForkCxt::const_iterator it = ctToForkCxtMap.find(ct);
         assert(it!=ctToForkCxtMap.end() && "Cxt Thread not found!!");
         return it->second;
@@ -292,14 +292,14 @@ public:
     /// Get the next instructions following control flow
     void getNextInsts(const Instruction* inst, InstVec& instSet);
     /// Push calling context
-    void pushCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee);
+    void pushCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee);
     /// Match context
-    bool matchCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee);
+    bool matchCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee);
 
-    inline void pushCxt(CallStrCxt& cxt, CallSiteID csId) {
-		cxt.push_back(csId);
-		if (cxt.size() > MaxCxtSize)
-			MaxCxtSize = cxt.size();
+    inline void pushCxt(CallStrCxtID& cxt, CallSiteID csId) {
+		cxt = CallStrCxtTrie::push(cxt, csId);
+		if (CallStrCxtTrie::size(cxt) > MaxCxtSize)
+			MaxCxtSize = CallStrCxtTrie::size(cxt);
     }
     /// Whether a join site is in recursion
     inline bool isJoinSiteInRecursion(const Instruction* join) const {
@@ -307,7 +307,7 @@ public:
         return inRecurJoinSites.find(join)!=inRecurJoinSites.end();
     }
     /// Dump calling context
-    void dumpCxt(CallStrCxt& cxt);
+    void dumpCxt(CallStrCxtID cxt);
 
     /// Dump the graph
     void dump(const std::string& filename);
@@ -383,7 +383,7 @@ private:
 
     /// Get or create a tct node based on CxtThread
     //@{
-    inline TCTNode* getOrCreateTCTNode(const CallStrCxt& cxt, const CallInst* fork,const CallStrCxt& oldCxt, const Function* routine) {
+    inline TCTNode* getOrCreateTCTNode(CallStrCxtID cxt, const CallInst* fork,CallStrCxtID oldCxt, const Function* routine) {
         CxtThread ct(cxt,fork);
         CxtThreadToNodeMap::const_iterator it = ctpToNodeMap.find(ct);
         if(it!=ctpToNodeMap.end()) {
@@ -413,7 +413,7 @@ private:
     }
 
     /// Add context for a thread at its spawning site (fork site)
-    void addCxtOfCxtThread(const CallStrCxt& cxt, const CxtThread& ct) {
+    void addCxtOfCxtThread(CallStrCxtID cxt, const CxtThread& ct) {
         ctToForkCxtMap[ct] = cxt;
     }
     /// Add start routine function of a cxt thread
@@ -31,6 +31,7 @@
 #define GENERICGRAPH_H_
 
 #include "Util/BasicTypes.h"
+#include <algorithm>
 
 /*!
  * Generic edge on the graph as base class
@@ -73,6 +74,9 @@ public:
     inline GEdgeKind getEdgeKind() const {
         return (EdgeKindMask & edgeFlag);
     }
+    inline GEdgeFlag getEdgeFlag() const {
+        return edgeFlag;
+    }
     NodeType* getSrcNode() const {
         return src;
     }
@@ -107,6 +111,207 @@ protected:
 };
 
 
+/*!
+ * Edge set of a node. It is an ordered set of edges while the graph is being
+ * built, and a sorted range of a compact edge array owned by the graph once the
+ * graph is frozen (see GenericGraph::freeze), which saves the tree node of each
+ * edge and keeps the edges of a node contiguous for traversal.
+ * A frozen set turns back into an ordered set when it is modified, and an
+ * iterator taken before still compares equal to one taken after at the same
+ * edge or at the end, as iterators of a std::set stay valid on insertion.
+ */
+template<class EdgeTy, class Compare>
+class GEdgeSet {
+
+public:
+    typedef EdgeTy* value_type;
+    typedef EdgeTy* key_type;
+    typedef std::set<EdgeTy*, Compare> TreeTy;
+
+    /// Iterator over either representation, edges are read-only as in std::set
+    class const_iterator {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef EdgeTy* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef EdgeTy* const* pointer;
+        typedef EdgeTy* const& reference;
+
+        const_iterator(): tree(NULL), packedIt(NULL), packedEnd(NULL), packed(false) {
+        }
+        const_iterator(typename TreeTy::const_iterator it, const TreeTy* t):
+            treeIt(it), tree(t), packedIt(NULL), packedEnd(NULL), packed(false) {
+        }
+        const_iterator(EdgeTy* const* it, EdgeTy* const* last):
+            tree(NULL), packedIt(it), packedEnd(last), packed(true) {
+        }
+
+        inline reference operator*() const {
+            return packed ? *packedIt : *treeIt;
+        }
+        inline pointer operator->() const {
+            return &**this;
+        }
+        inline const_iterator& operator++() {
+            if (packed)
+                ++packedIt;
+            else
+                ++treeIt;
+            return *this;
+        }
+        inline const_iterator operator++(int) {
+            const_iterator it = *this;
+            ++*this;
+            return it;
+        }
+        inline const_iterator& operator--() {
+            if (packed)
+                --packedIt;
+            else
+                --treeIt;
+            return *this;
+        }
+        inline const_iterator operator--(int) {
+            const_iterator it = *this;
+            --*this;
+            return it;
+        }
+        inline bool operator==(const const_iterator& rhs) const {
+            if (packed == rhs.packed)
+                return packed ? packedIt == rhs.packedIt : treeIt == rhs.treeIt;
+            /// one of them was taken before the set is thawed
+            const const_iterator& p = packed ? *this : rhs;
+            const const_iterator& t = packed ? rhs : *this;
+            if (t.tree == NULL)
+                return false;
+            bool pEnd = (p.packedIt == p.packedEnd);
+            bool tEnd = (t.treeIt == t.tree->end());
+            if (pEnd || tEnd)
+                return pEnd && tEnd;
+            return *p.packedIt == *t.treeIt;
+        }
+        inline bool operator!=(const const_iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+    private:
+        typename TreeTy::const_iterator treeIt;
+        const TreeTy* tree;			///< set of treeIt
+        EdgeTy* const* packedIt;
+        EdgeTy* const* packedEnd;	///< end of the edge array range of packedIt
+        bool packed;
+    };
+    typedef const_iterator iterator;
+
+    /// Constructors, a copy is never frozen as it does not own the edge array
+    //@{
+    GEdgeSet(): packedBegin(NULL), packedSize(0), packed(false) {
+    }
+    GEdgeSet(const GEdgeSet& rhs): tree(rhs.begin(), rhs.end()), packedBegin(NULL), packedSize(0), packed(false) {
+    }
+    GEdgeSet& operator=(const GEdgeSet& rhs) {
+        if (this != &rhs) {
+            TreeTy copy(rhs.begin(), rhs.end());
+            tree.swap(copy);
+            packed = false;
+        }
+        return *this;
+    }
+    //@}
+
+    ///  iterators
+    //@{
+    inline const_iterator begin() const {
+        return packed ? const_iterator(packedBegin, packedBegin + packedSize) : const_iterator(tree.begin(), &tree);
+    }
+    inline const_iterator end() const {
+        return packed ? const_iterator(packedBegin + packedSize, packedBegin + packedSize) : const_iterator(tree.end(), &tree);
+    }
+    //@}
+
+    inline Size_t size() const {
+        return packed ? packedSize : tree.size();
+    }
+    inline bool empty() const {
+        return size() == 0;
+    }
+    inline bool isFrozen() const {
+        return packed;
+    }
+
+    /// Lookup, by binary search over a frozen set
+    //@{
+    inline const_iterator find(EdgeTy* edge) const {
+        if (!packed)
+            return const_iterator(tree.find(edge), &tree);
+        EdgeTy* const* last = packedBegin + packedSize;
+        EdgeTy* const* it = std::lower_bound(packedBegin, last, edge, Compare());
+        if (it != last && !Compare()(edge, *it))
+            return const_iterator(it, last);
+        return const_iterator(last, last);
+    }
+    inline Size_t count(EdgeTy* edge) const {
+        return find(edge) != end() ? 1 : 0;
+    }
+    //@}
+
+    /// Modifications, which thaw a frozen set first
+    //@{
+    inline std::pair<const_iterator, bool> insert(EdgeTy* edge) {
+        thaw();
+        std::pair<typename TreeTy::iterator, bool> res = tree.insert(edge);
+        return std::make_pair(const_iterator(res.first, &tree), res.second);
+    }
+    inline const_iterator insert(const_iterator, EdgeTy* edge) {
+        return insert(edge).first;
+    }
+    template<class InputIt>
+    inline void insert(InputIt first, InputIt last) {
+        thaw();
+        tree.insert(first, last);
+    }
+    inline Size_t erase(EdgeTy* edge) {
+        thaw();
+        return tree.erase(edge);
+    }
+    inline const_iterator erase(const_iterator pos) {
+        EdgeTy* edge = *pos;
+        thaw();
+        return const_iterator(tree.erase(tree.find(edge)), &tree);
+    }
+    inline void clear() {
+        tree.clear();
+        packed = false;
+    }
+    //@}
+
+    /// Move the edges into buf and refer to them there, return the next free slot
+    inline EdgeTy** freeze(EdgeTy** buf) {
+        Size_t num = size();
+        std::copy(begin(), end(), buf);
+        tree.clear();
+        packed = (num != 0);
+        packedBegin = buf;
+        packedSize = num;
+        return buf + num;
+    }
+
+private:
+    /// Turn a frozen set back into an ordered set
+    inline void thaw() {
+        if (!packed)
+            return;
+        for (EdgeTy* const* it = packedBegin, * const* eit = packedBegin + packedSize; it != eit; ++it)
+            tree.insert(tree.end(), *it);
+        packed = false;
+    }
+
+    TreeTy tree;				///< edges while the set is not frozen
+    EdgeTy* const* packedBegin;	///< edges of a frozen set in the edge array of the graph
+    Size_t packedSize;			///< number of edges of a frozen set
+    bool packed;				///< whether the set is frozen
+};
+
 /*!
  * Generic node on the graph as base class
  */
@@ -118,7 +323,7 @@ public:
     typedef EdgeTy EdgeType;
     /// Edge kind
     typedef s32_t GNodeK;
-    typedef std::set<EdgeType*, typename EdgeType::equalGEdge> GEdgeSetTy;
+    typedef GEdgeSet<EdgeType, typename EdgeType::equalGEdge> GEdgeSetTy;
     /// Edge iterator
     ///@{
     typedef typename GEdgeSetTy::iterator iterator;
@@ -255,6 +460,12 @@ public:
     }
     ///@}
 
+    /// Move incoming and outgoing edges into buf, return the next free slot
+    inline EdgeType** freezeEdges(EdgeType** buf) {
+        buf = InEdges.freeze(buf);
+        return OutEdges.freeze(buf);
+    }
+
     /// Find incoming and outgoing edges
     //@{
     inline EdgeType* hasIncomingEdge(EdgeType* edge) const {
@@ -355,6 +566,26 @@ public:
         IDToNodeMap.erase(it);
     }
 
+    /// Store the edges of all nodes in one array, ordered by node ID, once the
+    /// graph is built. Edge sets modified afterwards are thawed individually.
+    void freeze() {
+        std::vector<NodeType*> nodes;
+        Size_t num = 0;
+        for (const_iterator it = IDToNodeMap.begin(), eit = IDToNodeMap.end(); it != eit; ++it) {
+            nodes.push_back(it->second);
+            num += it->second->getInEdges().size() + it->second->getOutEdges().size();
+        }
+        std::sort(nodes.begin(), nodes.end(), [](const NodeType* lhs, const NodeType* rhs) {
+            return lhs->getId() < rhs->getId();
+        });
+
+        std::vector<EdgeType*> edges(num);
+        EdgeType** buf = edges.data();
+        for (NodeType* node : nodes)
+            buf = node->freezeEdges(buf);
+        frozenEdges.swap(edges);
+    }
+
     /// Get total number of node/edge
     inline Size_t getTotalNodeNum() const {
         return nodeNum;
@@ -372,6 +603,7 @@ public:
 
 protected:
     IDToNodeMapTy IDToNodeMap; ///< node map
+    std::vector<EdgeType*> frozenEdges; ///< edges of frozen edge sets
 
 public:
     Size_t edgeNum;		///< total num of node
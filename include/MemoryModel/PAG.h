@@ -66,6 +66,8 @@ public:
     typedef llvm::DenseMap<NodeOffset,NodeID,llvm::DenseMapInfo<std::pair<NodeID,Size_t> > > NodeOffsetMap;
     typedef std::map<NodeLocationSet,NodeID> NodeLocationSetMap;
     typedef std::map<NodePair,NodeID> NodePairSetMap;
+    typedef llvm::DenseSet<const Function*> FunSet;
+    typedef std::vector<PAGEdge*> PAGEdgeVector;
 
 private:
     SymbolTableInfo* symInfo;
@@ -96,9 +98,13 @@ private:
     /// this set of candidate pointers can change during pointer resolution (e.g. adding new object nodes)
     NodeSet candidatePointers;
     NodeID nodeNumAfterPAGBuild; // initial node number after building PAG, excluding later added nodes, e.g., gepobj nodes
+    bool reachableOnly;	///< Whether only the functions reachable from program entries are built
+    FunSet builtFuns;	///< Functions whose PAG edges are built if reachableOnly
+    PAGEdgeVector onTheFlyPTAEdges;	///< PTA edges of the functions built after the initial PAG build
 
     /// Constructor
-    PAG(bool buildFromFile) : fromFile(buildFromFile), curBB(NULL),curVal(NULL), totalPTAPAGEdge(0),nodeNumAfterPAGBuild(0) {
+    PAG(bool buildFromFile) : fromFile(buildFromFile), curBB(NULL),curVal(NULL), totalPTAPAGEdge(0),nodeNumAfterPAGBuild(0),
+        reachableOnly(false) {
         symInfo = SymbolTableInfo::Symbolnfo();
     }
 
@@ -518,6 +524,31 @@ public:
         nodeNumAfterPAGBuild = num;
     }
 
+    /// Functions built when only the functions reachable from program entries are built
+    //@{
+    inline bool isReachableOnly() const {
+        return reachableOnly;
+    }
+    inline void setReachableOnly(bool b) {
+        reachableOnly = b;
+    }
+    /// Whether the PAG edges of a function are built, always true unless reachableOnly
+    inline bool isBuiltFunction(const Function* fun) const {
+        return !reachableOnly || builtFuns.count(fun);
+    }
+    inline bool addBuiltFunction(const Function* fun) {
+        return builtFuns.insert(fun).second;
+    }
+    inline u32_t getNumOfBuiltFunctions() const {
+        return builtFuns.size();
+    }
+    /// PTA edges added by the functions built after the initial PAG build,
+    /// to be added to the constraint graph by the analysis reaching them
+    inline PAGEdgeVector& getOnTheFlyPTAEdges() {
+        return onTheFlyPTAEdges;
+    }
+    //@}
+
     /// Base and Offset methods for Value and Object node
     //@{
     /// Get a base pointer node given a field pointer
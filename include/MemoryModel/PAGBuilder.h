@@ -38,12 +38,38 @@ class SVFModule;
  *  PAG Builder
  */
 class PAGBuilder: public llvm::InstVisitor<PAGBuilder> {
+public:
+    /// Kinds of the PAG updates made when visiting an instruction
+    enum InstEdgeKind {
+        AddrInstEdge, CopyInstEdge, LoadInstEdge, StoreInstEdge, BlackHoleInstEdge,
+        PhiInstEdge, BinaryInstEdge, CmpInstEdge
+    };
+    /// A PAG update of an instruction, recorded by a worker and applied when merging
+    struct InstEdge {
+        InstEdgeKind kind;
+        NodeID src;
+        NodeID dst;
+        const BasicBlock* bb;	///< incoming block of a phi
+    };
+    /// PAG updates of the instructions of a function in their visiting order
+    struct FunInstEdges {
+        std::vector<InstEdge> edges;
+        std::vector<u32_t> numOfEdges;	///< number of edges of each instruction, or DeferredInst
+    };
+    /// Instructions visited sequentially when merging
+    static const u32_t DeferredInst = ~0U;
+    typedef std::vector<const Function*> FunctionList;
+
 private:
     PAG* pag;
     SVFModule svfMod;
+    FunInstEdges* recorder;		///< updates are recorded here instead of applied if this builder is a worker
+    bool recordFailed;			///< the instruction being recorded can not be handled by a worker
+    FunctionList reachedFuns;	///< direct callees and start routines reached by the functions being built
+
 public:
     /// Constructor
-    PAGBuilder(): pag(PAG::getPAG()) {
+    PAGBuilder(): pag(PAG::getPAG()), recorder(NULL), recordFailed(false) {
     }
     /// Destructor
     virtual ~PAGBuilder() {
@@ -52,6 +78,11 @@ public:
     /// Start building PAG here
     PAG* build(SVFModule svfModule);
 
+    /// Build the functions in worklist and those reachable from them through direct
+    /// calls and thread forks, if only reachable functions are built (-reachable-funs).
+    /// The functions built are appended to built.
+    void buildReachableFunctions(SVFModule svfModule, FunctionList& worklist, FunctionList& built);
+
     /// Return PAG
     PAG* getPAG() const {
         return pag;
@@ -67,10 +98,48 @@ public:
     /// Sanity check for PAG
     void sanityCheck();
 
+    /// Entry functions of -reachable-funs
+    void collectEntryFunctions(SVFModule svfModule, FunctionList& entries);
+
+    /// Record a function reached by the function being built
+    inline void addReachedFunction(const Function* fun) {
+        if (pag->isReachableOnly() && !pag->isBuiltFunction(fun) && !SVFUtil::isExtCall(fun))
+            reachedFuns.push_back(fun);
+    }
+
+    /// Visit the instructions of functions, recording their PAG updates concurrently
+    /// and then applying them in program order, so that node and edge IDs are the
+    /// same as those of a sequential build
+    //@{
+    void visitFunctions(const std::vector<Function*>& funs, u32_t numOfThreads);
+    void recordFunction(Function& fun, FunInstEdges& funEdges);
+    bool isRecordable(const Instruction& inst) const;
+    //@}
+
+    /// Add the PAG updates of an instruction, recorded instead if this builder is a worker
+    //@{
+    inline void addInstEdge(InstEdgeKind kind, NodeID src, NodeID dst, const BasicBlock* bb = NULL) {
+        InstEdge edge = {kind, src, dst, bb};
+        if (recorder)
+            recorder->edges.push_back(edge);
+        else
+            applyInstEdge(edge);
+    }
+    inline void addBlackHoleAddrEdge(NodeID dst) {
+        addInstEdge(BlackHoleInstEdge, 0, dst);
+    }
+    void applyInstEdge(const InstEdge& edge);
+    //@}
+
     /// Get different kinds of node
     //@{
     // GetValNode - Return the value node according to a LLVM Value.
     NodeID getValueNode(const Value *V) {
+        // constant expressions add edges out of the program order, leave them to sequential visiting
+        if (recorder && SVFUtil::isa<ConstantExpr>(V)) {
+            recordFailed = true;
+            return pag->getBlkPtr();
+        }
         // first handle gep edge if val if a constant expression
         processCE(V);
 
@@ -141,7 +210,7 @@ public:
     void visitSelectInst(SelectInst &I);
     void visitExtractValueInst(ExtractValueInst  &EVI);
     void visitInsertValueInst(InsertValueInst &I) {
-		pag->addBlackHoleAddrEdge(getValueNode(&I));
+        addBlackHoleAddrEdge(getValueNode(&I));
     }
     // TerminatorInst and UnwindInst have been removed since llvm-8.0.0
     // void visitTerminatorInst(TerminatorInst &TI) {}
@@ -156,13 +225,13 @@ public:
     void visitExtractElementInst(ExtractElementInst &I);
 
     void visitInsertElementInst(InsertElementInst &I) {
-		pag->addBlackHoleAddrEdge(getValueNode(&I));
+        addBlackHoleAddrEdge(getValueNode(&I));
     }
     void visitShuffleVectorInst(ShuffleVectorInst &I) {
-		pag->addBlackHoleAddrEdge(getValueNode(&I));
+        addBlackHoleAddrEdge(getValueNode(&I));
     }
     void visitLandingPadInst(LandingPadInst &I) {
-		pag->addBlackHoleAddrEdge(getValueNode(&I));
+        addBlackHoleAddrEdge(getValueNode(&I));
     }
 
     /// Instruction not that often
@@ -171,13 +240,13 @@ public:
     void visitUnreachableInst(UnreachableInst &I) { /*returns void*/
     }
     void visitFenceInst(FenceInst &I) { /*returns void*/
-		pag->addBlackHoleAddrEdge(getValueNode(&I));
+        addBlackHoleAddrEdge(getValueNode(&I));
     }
     void visitAtomicCmpXchgInst(AtomicCmpXchgInst &I) {
-		pag->addBlackHoleAddrEdge(getValueNode(&I));
+        addBlackHoleAddrEdge(getValueNode(&I));
     }
     void visitAtomicRMWInst(AtomicRMWInst &I) {
-		pag->addBlackHoleAddrEdge(getValueNode(&I));
+        addBlackHoleAddrEdge(getValueNode(&I));
     }
 
     /// Provide base case for our instruction visit.
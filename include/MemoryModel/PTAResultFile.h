@@ -0,0 +1,156 @@
+//===- PTAResultFile.h -- Binary storage of points-to results-----------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PTAResultFile.h
+ *
+ *  Binary format used by -write-ander/-read-ander.
+ *
+ *  Layout (integers in host byte order, every section is 8-byte aligned):
+ *    Header
+ *    Index      numOfVars entries {var, numOfTargets, offset}, sorted by var
+ *    Targets    object IDs of all points-to sets, referred to by the index
+ *    GepObjs    numOfGepObjs entries {id, base, offset}, sorted by id
+ *    FIObjs     IDs of the base objects which are field-insensitive
+ *
+ *  The reader maps the file into memory and only decodes the index entry and
+ *  targets of a variable when its points-to set is first accessed, gep objects
+ *  and field-insensitive objects are restored when the file is read.
+ */
+
+#ifndef PTARESULTFILE_H_
+#define PTARESULTFILE_H_
+
+#include "MemoryModel/PAG.h"
+#include "MemoryModel/PointsToDS.h"
+#include <llvm/Support/MemoryBuffer.h>
+
+/*!
+ * Common definitions of the binary points-to result file
+ */
+class PTAResultFile {
+public:
+    static const char Magic[8];
+    static const u32_t Version = 1;
+
+    struct Header {
+        char magic[8];
+        u32_t version;
+        u32_t reserved;
+        u64_t numOfVars;
+        u64_t indexOffset;
+        u64_t numOfTargets;
+        u64_t targetsOffset;
+        u64_t numOfGepObjs;
+        u64_t gepObjsOffset;
+        u64_t numOfFIObjs;
+        u64_t fiObjsOffset;
+    };
+
+    struct IndexEntry {
+        u32_t var;
+        u32_t numOfTargets;
+        u64_t offset;	///< index of the first target in the Targets section
+    };
+
+    struct GepObjEntry {
+        u32_t id;
+        u32_t base;
+        u64_t offset;	///< LocationSet offset (stored as two's complement)
+    };
+
+    /// Whether a file starts with the magic of this format
+    static bool isBinaryFile(const std::string& filename);
+};
+
+/*!
+ * Collect points-to sets and write them together with the gep objects and
+ * field-sensitivity of the PAG
+ */
+class PTAResultFileWriter : public PTAResultFile {
+public:
+    PTAResultFileWriter(PAG* p): pag(p) {}
+
+    /// Add the points-to set of a variable, each variable is added once
+    void addPts(NodeID var, const PointsTo& pts);
+
+    /// Write everything collected, return false on I/O error
+    bool write(const std::string& filename);
+
+private:
+    PAG* pag;
+    std::vector<IndexEntry> index;
+    std::vector<u32_t> targets;
+};
+
+/*!
+ * Memory-mapped reader, a points-to set is decoded from the mapped targets without copying the file
+ */
+class PTAResultFileReader : public PTAResultFile, public PtsLazySource<PointsTo> {
+public:
+    PTAResultFileReader(): header(NULL), index(NULL), targets(NULL), gepObjs(NULL), fiObjs(NULL) {}
+
+    /// Map a file into memory and validate its header
+    bool open(const std::string& filename);
+
+    /// Points-to sets
+    //@{
+    inline u64_t getNumOfVars() const {
+        return header->numOfVars;
+    }
+    inline NodeID getVar(u64_t i) const {
+        return index[i].var;
+    }
+    /// Union the targets of the i-th index entry into pts, return false if they are out of the file
+    bool readPtsAt(u64_t i, PointsTo& pts) const;
+    /// Union the targets of var into pts, return false if var is not in the file
+    bool readPts(NodeID var, PointsTo& pts) const;
+    /// Decode the points-to set of var when it is first accessed
+    virtual void load(u32_t var, PointsTo& pts);
+    //@}
+
+    /// Gep objects and field-insensitive objects
+    //@{
+    inline u64_t getNumOfGepObjs() const {
+        return header->numOfGepObjs;
+    }
+    inline const GepObjEntry& getGepObj(u64_t i) const {
+        return gepObjs[i];
+    }
+    inline u64_t getNumOfFIObjs() const {
+        return header->numOfFIObjs;
+    }
+    inline NodeID getFIObj(u64_t i) const {
+        return fiObjs[i];
+    }
+    //@}
+
+private:
+    std::unique_ptr<llvm::MemoryBuffer> buffer;
+    const Header* header;
+    const IndexEntry* index;
+    const u32_t* targets;
+    const GepObjEntry* gepObjs;
+    const u32_t* fiObjs;
+};
+
+#endif /* PTARESULTFILE_H_ */
@@ -33,10 +33,12 @@
 #include "MemoryModel/PAG.h"
 #include "MemoryModel/ConditionalPT.h"
 #include "MemoryModel/PointsToDS.h"
+#include "MemoryModel/PTAResultFile.h"
 #include "Util/PTACallGraph.h"
 #include "Util/SCC.h"
 #include "Util/PathCondAllocator.h"
 #include "MemoryModel/PointsToDFDS.h"
+#include "MemoryModel/PointsToTable.h"
 
 class CHGraph;
 class CHNode;
@@ -62,10 +64,12 @@ public:
         AndersenSFR_WPA,    ///< Stride-based field representation
         AndersenWaveDiff_WPA,	///< Diff wave propagation andersen-style WPA
         AndersenWaveDiffWithType_WPA,	///< Diff wave propagation with type info andersen-style WPA
+        AndersenWaveDiffPar_WPA,	///< Parallel diff wave propagation andersen-style WPA
         CSCallString_WPA,	///< Call string based context sensitive WPA
         CSSummary_WPA,		///< Summary based context sensitive WPA
         FSDATAFLOW_WPA,	///< Traditional Dataflow-based flow sensitive WPA
         FSSPARSE_WPA,		///< Sparse flow sensitive WPA
+        FSSPARSEPar_WPA,	///< Parallel sparse flow sensitive WPA
         FSCS_WPA,			///< Flow-, context- sensitive WPA
         FSCSPS_WPA,		///< Flow-, context-, path- sensitive WPA
         ADAPTFSCS_WPA,		///< Adaptive Flow-, context-, sensitive WPA
@@ -186,6 +190,12 @@ public:
 
     /// Compute points-to results on-demand, overridden by derived classes
     virtual void computeDDAPts(NodeID id) {}
+    /// Create a solver of the same demand-driven analysis answering queries concurrently with this one
+    virtual PointerAnalysis* createDDAWorker() {
+        return NULL;
+    }
+    /// Copy the points-to of a query answered by a solver created by createDDAWorker
+    virtual void mergeDDAPts(PointerAnalysis* worker, NodeID id) {}
 
     /// Interface exposed to users of our pointer analysis, given Location infos
     virtual AliasResult alias(const MemoryLocation &LocA,
@@ -272,9 +282,11 @@ public:
     inline const NodeBS& getAllFieldsObjNode(NodeID id) {
         return pag->getAllFieldsObjNode(id);
     }
+    /// An object which is already field-insensitive is not written, e.g., by concurrent DDA solvers
     inline void setObjFieldInsensitive(NodeID id) {
         MemObj* mem =  const_cast<MemObj*>(pag->getBaseObj(id));
-        mem->setFieldInsensitive();
+        if (!mem->isFieldInsensitive())
+            mem->setFieldInsensitive();
     }
     inline bool isFieldInsensitive(NodeID id) const {
         const MemObj* mem =  pag->getBaseObj(id);
@@ -400,8 +412,8 @@ class BVDataPTAImpl : public PointerAnalysis {
 public:
     typedef PTData<NodeID,PointsTo> PTDataTy;	/// Points-to data structure type
     typedef DiffPTData<NodeID,PointsTo,EdgeID> DiffPTDataTy;	/// Points-to data structure type
-    typedef DFPTData<NodeID,PointsTo> DFPTDataTy;	/// Points-to data structure type
-    typedef IncDFPTData<NodeID,PointsTo> IncDFPTDataTy;	/// Points-to data structure type
+    typedef DFPTData<NodeID,PointsTo,InternedPointsTo> DFPTDataTy;	/// Points-to data structure type (IN/OUT sets are shared)
+    typedef IncDFPTData<NodeID,PointsTo,InternedPointsTo> IncDFPTDataTy;	/// Points-to data structure type (IN/OUT sets are shared)
 
     /// Constructor
     BVDataPTAImpl(PointerAnalysis::PTATY type);
@@ -412,10 +424,7 @@ public:
     }
 
     /// Release memory
-    inline void destroy() {
-        delete ptD;
-        ptD = NULL;
-    }
+    void destroy();
 
     /// Get points-to and reverse points-to
     ///@{
@@ -423,6 +432,8 @@ public:
         return ptD->getPts(id);
     }
     virtual inline PointsTo& getRevPts(NodeID nodeId) {
+        if (ptsFileRevPending)
+            loadRevPtsOfFile();
         return ptD->getRevPts(nodeId);
     }
     //@}
@@ -431,11 +442,37 @@ public:
     void expandFIObjs(const PointsTo& pts, PointsTo& expandedPts);
 
     /// Interface for analysis result storage on filesystem.
+    /// Results are written in the binary format unless the text format is requested,
+    /// and the format of a file to be read is detected from its content.
     //@{
     virtual void writeToFile(const std::string& filename);
     virtual bool readFromFile(const std::string& filename);
     //@}
 
+    /// Interface for the on-disk analysis cache (-analysis-cache).
+    /// Results of a stage are stored in the binary format under a hash of the input modules.
+    //@{
+    bool readFromCache(const std::string& stage, const std::string& stageOptions);
+    void writeToCache(const std::string& stage, const std::string& stageOptions);
+    //@}
+
+    /// Store of the points-to sets spilled under the memory budget (-pts-mem-budget),
+    /// NULL if the budget is not enabled
+    inline const PtsSpillStore* getPtsSpillStore() const {
+        return ptsSpill;
+    }
+
+private:
+    /// Text and binary result files
+    //@{
+    void writeToTextFile(const std::string& filename);
+    bool readFromTextFile(const std::string& filename);
+    bool writeToBinaryFile(const std::string& filename);
+    bool readFromBinaryFile(const std::string& filename);
+    /// Record the reverse points-to of the sets in ptsFile, which needs all of them
+    void loadRevPtsOfFile();
+    //@}
+
 protected:
 
     /// Update callgraph. This should be implemented by its subclass.
@@ -455,6 +492,18 @@ protected:
         return SVFUtil::cast<IncDFPTDataTy>(ptD);
     }
 
+    /// Spill cold points-to sets under the memory budget
+    //@{
+    /// Whether the memory usage is due to be checked, true every few calls if the budget is enabled
+    inline bool isPtsSpillDue() {
+        return ptsSpill && ptsSpill->isCheckDue();
+    }
+    /// Spill cold points-to sets if the memory usage is over the budget, sets of the nodes
+    /// for which isHot returns true stay in memory. No points-to set may be referenced
+    /// by the caller, as spilling clears the data of the sets.
+    void spillPtsOverBudget(const PTDataTy::SpillHotFn& isHot);
+    //@}
+
     /// Union/add points-to. Add the reverse points-to for node collapse purpose
     /// To be noted that adding reverse pts might incur 10% total overhead during solving
     //@{
@@ -472,6 +521,7 @@ protected:
     /// Clear all data
     virtual inline void clearPts() {
         ptD->clear();
+        ptsFileRevPending = false;
     }
 
     /// On the fly call graph construction
@@ -480,6 +530,12 @@ protected:
 private:
     /// Points-to data
     PTDataTy* ptD;
+    /// Store of spilled points-to sets
+    PtsSpillStore* ptsSpill;
+    /// Binary result file whose points-to sets are loaded when they are first accessed
+    std::unique_ptr<PTAResultFileReader> ptsFile;
+    /// Whether the reverse points-to of the sets in ptsFile are not recorded yet
+    bool ptsFileRevPending;
 
 public:
     /// Interface expose to users of our pointer analysis, given Location infos
@@ -37,14 +37,15 @@
  * Data-flow points-to data structure, points-to is maintained for each program point (statement)
  * For address-taken variables, every program point has two sets IN and OUT points-to sets
  * For top-level variables, their points-to sets are maintained in a flow-insensitive manner via getPts(var).
+ * The IN/OUT sets are of type DFData, which may differ from Data (e.g., InternedPointsTo to share equal sets).
  */
-template<class Key, class Data>
+template<class Key, class Data, class DFData = Data>
 class DFPTData : public PTData<Key,Data> {
 public:
     typedef NodeID LocID;
-    typedef typename PTData<Key,Data>::PtsMap PtsMap;
-    typedef typename PTData<Key,Data>::PtsMapConstIter PtsMapConstIter;
-    typedef std::map<LocID, PtsMap> DFPtsMap;	///< Data-flow point-to map
+    typedef std::map<const Key, DFData> LocPtsMap;	///< Points-to of variables at a program point
+    typedef typename LocPtsMap::const_iterator LocPtsMapConstIter;
+    typedef std::map<LocID, LocPtsMap> DFPtsMap;	///< Data-flow point-to map
     typedef typename DFPtsMap::iterator DFPtsMapIter;
     typedef typename DFPtsMap::const_iterator DFPtsMapconstIter;
     typedef typename PTData<Key,Data>::PTDataTY PTDataTy;
@@ -70,20 +71,20 @@ public:
         DFPtsMapconstIter it = dfInPtsMap.find(loc);
         if ( it == dfInPtsMap.end())
             return false;
-        const PtsMap& ptsMap = it->second;
+        const LocPtsMap& ptsMap = it->second;
         return (ptsMap.find(var) != ptsMap.end());
     }
     inline bool hasDFOutSet(LocID loc,const Key& var) const {
         DFPtsMapconstIter it = dfOutPtsMap.find(loc);
         if ( it == dfOutPtsMap.end())
             return false;
-        const PtsMap& ptsMap = it->second;
+        const LocPtsMap& ptsMap = it->second;
         return (ptsMap.find(var) != ptsMap.end());
     }
-    inline const PtsMap& getDFInPtsMap(LocID loc)  {
+    inline const LocPtsMap& getDFInPtsMap(LocID loc)  {
         return dfInPtsMap[loc];
     }
-    inline const PtsMap& getDFOutPtsMap(LocID loc)  {
+    inline const LocPtsMap& getDFOutPtsMap(LocID loc)  {
         return dfOutPtsMap[loc];
     }
     inline const DFPtsMap& getDFIn()  {
@@ -96,16 +97,58 @@ public:
 
     /// Get points-to from data-flow IN/OUT set
     ///@{
-    inline Data& getDFInPtsSet(LocID loc, const Key& var) {
-        PtsMap& inSet = dfInPtsMap[loc];
+    inline DFData& getDFInPtsSet(LocID loc, const Key& var) {
+        LocPtsMap& inSet = dfInPtsMap[loc];
         return inSet[var];
     }
-    inline Data& getDFOutPtsSet(LocID loc, const Key& var) {
-        PtsMap& outSet = dfOutPtsMap[loc];
+    inline DFData& getDFOutPtsSet(LocID loc, const Key& var) {
+        LocPtsMap& outSet = dfOutPtsMap[loc];
         return outSet[var];
     }
     ///@}
 
+    /// Read-only queries which never create an entry (NULL if there is no set).
+    /// They may be called by several threads as long as no set is updated meanwhile.
+    //@{
+    inline const DFData* findDFInPtsSet(LocID loc, const Key& var) const {
+        return findPtsSet(dfInPtsMap, loc, var);
+    }
+    inline const DFData* findDFOutPtsSet(LocID loc, const Key& var) const {
+        return findPtsSet(dfOutPtsMap, loc, var);
+    }
+    /// Whether IN[loc:var] or OUT[loc:var] has points-to which is not propagated yet
+    virtual inline bool hasNewDFInPts(LocID loc, const Key& var) const {
+        return true;
+    }
+    virtual inline bool hasNewDFOutPts(LocID loc, const Key& var) const {
+        return true;
+    }
+    /// Variables in IN[loc] whose points-to is not propagated to OUT[loc] yet
+    virtual inline void getNewDFInVars(LocID loc, std::vector<Key>& vars) const {
+        DFPtsMapconstIter it = dfInPtsMap.find(loc);
+        if (it == dfInPtsMap.end())
+            return;
+        for (LocPtsMapConstIter ptsIt = it->second.begin(), ptsEit = it->second.end(); ptsIt != ptsEit; ++ptsIt)
+            vars.push_back(ptsIt->first);
+    }
+    //@}
+
+    /// Update IN/OUT sets with points-to computed outside of this data structure
+    /// (e.g., by worker threads of a parallel solver) and the flags of the above queries
+    //@{
+    /// union (IN[loc:var], pts)
+    virtual inline bool unionDFInPts(LocID loc, const Key& var, const Data& pts) {
+        return this->unionPts(getDFInPtsSet(loc,var), pts);
+    }
+    /// union (OUT[loc:var], pts)
+    virtual inline bool unionDFOutPts(LocID loc, const Key& var, const Data& pts) {
+        return this->unionPts(getDFOutPtsSet(loc,var), pts);
+    }
+    /// IN[loc:var] has been propagated
+    virtual inline void clearDFInUpdatedVar(LocID loc, const Key& var) {
+    }
+    //@}
+
     /// Update points-to for IN/OUT set
     /// IN[loc:var] represents the points-to of variable var from IN set of location loc
     /// union(ptsDst,ptsSrc) represents union ptsSrc to ptsDst
@@ -138,8 +181,8 @@ public:
         bool changed = false;
         if (this->hasDFInSet(loc)) {
             /// Only variables has new pts from IN set need to be updated.
-            const PtsMap & ptsMap = getDFInPtsMap(loc);
-            for (typename PtsMap::const_iterator ptsIt = ptsMap.begin(), ptsEit = ptsMap.end(); ptsIt != ptsEit; ++ptsIt) {
+            const LocPtsMap & ptsMap = getDFInPtsMap(loc);
+            for (typename LocPtsMap::const_iterator ptsIt = ptsMap.begin(), ptsEit = ptsMap.end(); ptsIt != ptsEit; ++ptsIt) {
                 const Key var = ptsIt->first;
                 /// Enable strong updates if it is required to do so
                 if (strongUpdates && var == singleton)
@@ -163,7 +206,7 @@ public:
     //@}
 
     //@{ Methods for support type inquiry through isa, cast, and dyn_cast:
-    static inline bool classof(const DFPTData<Key,Data> *) {
+    static inline bool classof(const DFPTData<Key,Data,DFData> *) {
         return true;
     }
     static inline bool classof(const PTData<Key,Data>* ptd) {
@@ -186,10 +229,21 @@ public:
     //@}
 
 protected:
-    /// Union two points-to sets
-    inline bool unionPts(Data& dstData, const Data& srcData) {
+    /// Union two points-to sets, either top-level (Data) or address-taken (DFData)
+    template<class DstData, class SrcData>
+    inline bool unionPts(DstData& dstData, const SrcData& srcData) {
         return dstData |= srcData;
     }
+    /// Find the set of var at loc without creating it
+    static inline const DFData* findPtsSet(const DFPtsMap& dfMap, LocID loc, const Key& var) {
+        DFPtsMapconstIter it = dfMap.find(loc);
+        if (it == dfMap.end())
+            return NULL;
+        LocPtsMapConstIter ptsIt = it->second.find(var);
+        if (ptsIt == it->second.end())
+            return NULL;
+        return &ptsIt->second;
+    }
 
 public:
     /// Dump the DF IN/OUT set information for debugging purpose
@@ -234,8 +288,8 @@ public:
         F.os().clear_error();
     }
 
-    virtual inline void dumpPts(const PtsMap & ptsSet,raw_ostream & O = SVFUtil::outs()) const {
-        for (PtsMapConstIter nodeIt = ptsSet.begin(); nodeIt != ptsSet.end(); nodeIt++) {
+    virtual inline void dumpPts(const LocPtsMap & ptsSet,raw_ostream & O = SVFUtil::outs()) const {
+        for (LocPtsMapConstIter nodeIt = ptsSet.begin(); nodeIt != ptsSet.end(); nodeIt++) {
             const Key& var = nodeIt->first;
             const Data & pts = nodeIt->second;
             if (pts.empty())
@@ -252,10 +306,10 @@ public:
 /*!
  * Incremental data-flow points-to data version
  */
-template<class Key, class Data>
-class IncDFPTData : public DFPTData<Key,Data> {
+template<class Key, class Data, class DFData = Data>
+class IncDFPTData : public DFPTData<Key,Data,DFData> {
 public:
-    typedef typename DFPTData<Key,Data>::LocID LocID;
+    typedef typename DFPTData<Key,Data,DFData>::LocID LocID;
     typedef std::map<LocID, Data> UpdatedVarMap;	///< for propagating only newly added variable in IN/OUT set
     typedef typename UpdatedVarMap::iterator UpdatedVarMapIter;
     typedef typename UpdatedVarMap::const_iterator UpdatedVarconstIter;
@@ -267,7 +321,7 @@ private:
 
 public:
     /// Constructor
-    IncDFPTData(PTDataTy ty = (PTData<Key,Data>::IncDFPTD)): DFPTData<Key,Data>(ty) {
+    IncDFPTData(PTDataTy ty = (PTData<Key,Data>::IncDFPTD)): DFPTData<Key,Data,DFData>(ty) {
     }
     /// Destructor
     virtual ~IncDFPTData() {
@@ -361,12 +415,52 @@ public:
     }
     //@}
 
+    /// Read-only queries of the updated flags, see DFPTData
+    //@{
+    inline bool hasNewDFInPts(LocID loc, const Key& var) const {
+        UpdatedVarconstIter it = inUpdatedVarMap.find(loc);
+        return it != inUpdatedVarMap.end() && it->second.test(var);
+    }
+    inline bool hasNewDFOutPts(LocID loc, const Key& var) const {
+        UpdatedVarconstIter it = outUpdatedVarMap.find(loc);
+        return it != outUpdatedVarMap.end() && it->second.test(var);
+    }
+    inline void getNewDFInVars(LocID loc, std::vector<Key>& vars) const {
+        UpdatedVarconstIter it = inUpdatedVarMap.find(loc);
+        if (it == inUpdatedVarMap.end())
+            return;
+        for (DataIter ptsIt = it->second.begin(), ptsEit = it->second.end(); ptsIt != ptsEit; ++ptsIt)
+            vars.push_back(*ptsIt);
+    }
+    //@}
+
+    /// Update IN/OUT sets with points-to computed outside of this data structure
+    //@{
+    inline bool unionDFInPts(LocID loc, const Key& var, const Data& pts) {
+        if (this->unionPts(this->getDFInPtsSet(loc,var), pts)) {
+            setVarDFInSetUpdated(loc,var);
+            return true;
+        }
+        return false;
+    }
+    inline bool unionDFOutPts(LocID loc, const Key& var, const Data& pts) {
+        if (this->unionPts(this->getDFOutPtsSet(loc,var), pts)) {
+            setVarDFOutSetUpdated(loc,var);
+            return true;
+        }
+        return false;
+    }
+    inline void clearDFInUpdatedVar(LocID loc, const Key& var) {
+        removeVarFromDFInUpdatedSet(loc,var);
+    }
+    //@}
+
     ///Methods for support type inquiry through isa, cast, and dyn_cast:
     //@{
-    static inline bool classof(const IncDFPTData<Key,Data> *) {
+    static inline bool classof(const IncDFPTData<Key,Data,DFData> *) {
         return true;
     }
-    static inline bool classof(const DFPTData<Key,Data> * ptd) {
+    static inline bool classof(const DFPTData<Key,Data,DFData> * ptd) {
         return ptd->getPTDTY() == PTData<Key,Data>::IncDFPTD;
     }
     static inline bool classof(const PTData<Key,Data>* ptd) {
@@ -33,7 +33,15 @@
 #define POINTSTO_H_
 
 #include "MemoryModel/ConditionalPT.h"
+#include "MemoryModel/PtsSpillStore.h"
 #include "Util/SVFUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
 
 /// Overloading operator << for dumping conditional variable
 //@{
@@ -44,6 +52,334 @@ raw_ostream& operator<< (raw_ostream &o, const CondVar<Cond> &cvar) {
 }
 //@}
 
+/*!
+ * Source of the data of keys which is decoded when the keys are first accessed,
+ * e.g., the points-to sets of a result file read by -read-ander
+ */
+template<class Data>
+class PtsLazySource {
+public:
+    virtual ~PtsLazySource() {
+    }
+    /// Decode the data of a key into data
+    virtual void load(u32_t key, Data& data) = 0;
+};
+
+/*!
+ * Points-to map indexed directly by dense integer keys (NodeID/EdgeID).
+ * It offers the subset of the std::map interface used by PTData.
+ * Entries are stored in fixed-size chunks, hence references to the data
+ * are never invalidated when the map grows, the same as std::map.
+ * A key is present once it has been accessed via operator[], and the
+ * iteration visits present keys in ascending order.
+ * The data of cold keys can be spilled to a PtsSpillStore, it is faulted
+ * back in transparently when the key is accessed again.
+ * The data of keys added by addLazy is loaded from a PtsLazySource on their
+ * first access, which may happen in threads reading the map concurrently.
+ */
+template<class Data>
+class DenseIDPtsMap {
+public:
+    typedef u32_t Key;
+    typedef std::pair<const Key, Data> value_type;
+
+private:
+    static const u32_t ChunkBits = 9;
+    static const u32_t ChunkSize = 1 << ChunkBits;
+    static const u32_t ChunkMask = ChunkSize - 1;
+    static const Key InvalidKey = ~0U;
+
+    /// A slot is constructed when its key is first accessed, so a chunk
+    /// of a few present keys only initialises the data of those keys
+    struct Chunk {
+        typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type slots[ChunkSize];
+        u64_t present[ChunkSize / 64];
+        u64_t spilled[ChunkSize / 64];	///< keys whose data is in spillSlots
+        u64_t touched[ChunkSize / 64];	///< keys accessed since the last spill round
+        std::atomic<u64_t> lazy[ChunkSize / 64];	///< keys whose data is not loaded from lazySource yet
+        std::unique_ptr<PtsSpillStore::Slot[]> spillSlots;
+
+        Chunk() {
+            std::fill(present, present + ChunkSize / 64, 0);
+            std::fill(spilled, spilled + ChunkSize / 64, 0);
+            std::fill(touched, touched + ChunkSize / 64, 0);
+            for (u32_t i = 0; i < ChunkSize / 64; ++i)
+                lazy[i].store(0, std::memory_order_relaxed);
+        }
+        ~Chunk() {
+            for (u32_t i = 0; i < ChunkSize; ++i) {
+                if ((present[i >> 6] >> (i & 63)) & 1)
+                    slot(i).~value_type();
+            }
+        }
+        inline value_type& slot(u32_t i) {
+            return *reinterpret_cast<value_type*>(&slots[i]);
+        }
+        /// Construct the slot of the i-th key, return true if it is not present before
+        inline bool add(Key base, u32_t i) {
+            u64_t bit = (u64_t)1 << (i & 63);
+            if (present[i >> 6] & bit)
+                return false;
+            new (&slots[i]) value_type(base + i, Data());
+            present[i >> 6] |= bit;
+            return true;
+        }
+    };
+    typedef std::vector<std::unique_ptr<Chunk> > ChunkVector;
+
+    ChunkVector chunks;
+    u32_t numOfKeys;
+    PtsSpillStore* spillStore;	///< store of spilled data, NULL if spilling is not enabled
+    PtsLazySource<Data>* lazySource;	///< source of the data of lazy keys, NULL if there is none
+
+public:
+    /// Iterator over present keys, the end iterator stays valid when the map grows
+    template<class MapTy, class ValueTy>
+    class IteratorImpl {
+    public:
+        IteratorImpl(MapTy* m, Key k): map(m), key(k) {}
+        inline ValueTy& operator*() const {
+            return map->slot(key);
+        }
+        inline ValueTy* operator->() const {
+            return &map->slot(key);
+        }
+        inline IteratorImpl& operator++() {
+            key = map->nextKey(key + 1);
+            return *this;
+        }
+        inline IteratorImpl operator++(int) {
+            IteratorImpl tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        inline bool operator==(const IteratorImpl& rhs) const {
+            return key == rhs.key;
+        }
+        inline bool operator!=(const IteratorImpl& rhs) const {
+            return key != rhs.key;
+        }
+    private:
+        MapTy* map;
+        Key key;
+    };
+    typedef IteratorImpl<DenseIDPtsMap, value_type> iterator;
+    typedef IteratorImpl<const DenseIDPtsMap, const value_type> const_iterator;
+
+    DenseIDPtsMap(): numOfKeys(0), spillStore(NULL), lazySource(NULL) {}
+
+    /// Return the data of a key, the key is added if it is not present
+    inline Data& operator[](Key key) {
+        Chunk* chunk = getOrAddChunk(key);
+        u32_t i = key & ChunkMask;
+        if (chunk->add(key & ~ChunkMask, i))
+            numOfKeys++;
+        if (spillStore || lazySource)
+            touch(chunk, i);
+        return chunk->slot(i).second;
+    }
+
+    /// Add a key whose data is loaded from source when the key is first accessed,
+    /// the key must not be present
+    inline void addLazy(Key key, PtsLazySource<Data>* source) {
+        Chunk* chunk = getOrAddChunk(key);
+        u32_t i = key & ChunkMask;
+        bool added = chunk->add(key & ~ChunkMask, i);
+        assert(added && "data of a present key is loaded lazily!");
+        (void)added;
+        numOfKeys++;
+        chunk->lazy[i >> 6].fetch_or((u64_t)1 << (i & 63), std::memory_order_relaxed);
+        lazySource = source;
+    }
+
+    inline bool count(Key key) const {
+        u32_t c = key >> ChunkBits;
+        if (c >= chunks.size() || chunks[c] == nullptr)
+            return false;
+        u32_t i = key & ChunkMask;
+        return (chunks[c]->present[i >> 6] >> (i & 63)) & 1;
+    }
+    inline iterator find(Key key) {
+        return count(key) ? iterator(this, key) : end();
+    }
+    inline const_iterator find(Key key) const {
+        return count(key) ? const_iterator(this, key) : end();
+    }
+
+    inline iterator begin() {
+        return iterator(this, nextKey(0));
+    }
+    inline iterator end() {
+        return iterator(this, InvalidKey);
+    }
+    inline const_iterator begin() const {
+        return const_iterator(this, nextKey(0));
+    }
+    inline const_iterator end() const {
+        return const_iterator(this, InvalidKey);
+    }
+
+    inline u32_t size() const {
+        return numOfKeys;
+    }
+    inline bool empty() const {
+        return numOfKeys == 0;
+    }
+    inline void clear() {
+        chunks.clear();
+        numOfKeys = 0;
+        lazySource = NULL;
+    }
+
+    /// Spill the data of keys to store from now on
+    inline void enableSpill(PtsSpillStore* store) {
+        spillStore = store;
+    }
+
+    /// Spill the non-empty data of keys which have not been accessed since the last
+    /// call and for which isHot returns false, until target bytes are released.
+    /// Return the number of released bytes.
+    template<class HotFn>
+    u64_t spillCold(u64_t target, const HotFn& isHot) {
+        u64_t released = 0;
+        for (u32_t c = 0; c < chunks.size() && released < target; ++c) {
+            Chunk* chunk = chunks[c].get();
+            if (chunk == nullptr)
+                continue;
+            for (u32_t i = 0; i < ChunkSize; ++i) {
+                u64_t word = chunk->present[i >> 6] & ~(chunk->spilled[i >> 6] | chunk->touched[i >> 6]);
+                if (word == 0) {
+                    i |= 63;
+                    continue;
+                }
+                if (((word >> (i & 63)) & 1) == 0)
+                    continue;
+                Data& data = chunk->slot(i).second;
+                if (data.empty() || isHot((c << ChunkBits) + i))
+                    continue;
+                if (chunk->spillSlots == nullptr)
+                    chunk->spillSlots.reset(new PtsSpillStore::Slot[ChunkSize]);
+                if (!spillStore->spill(data, chunk->spillSlots[i], released))
+                    return released;
+                data.clear();
+                chunk->spilled[i >> 6] |= (u64_t)1 << (i & 63);
+            }
+            std::fill(chunk->touched, chunk->touched + ChunkSize / 64, 0);
+        }
+        return released;
+    }
+
+private:
+    inline Chunk* getOrAddChunk(Key key) {
+        u32_t c = key >> ChunkBits;
+        if (c >= chunks.size())
+            chunks.resize(c + 1);
+        if (chunks[c] == nullptr)
+            chunks[c].reset(new Chunk());
+        return chunks[c].get();
+    }
+
+    inline value_type& slot(Key key) {
+        Chunk* chunk = chunks[key >> ChunkBits].get();
+        if (spillStore || lazySource)
+            touch(chunk, key & ChunkMask);
+        return chunk->slot(key & ChunkMask);
+    }
+    inline const value_type& slot(Key key) const {
+        return const_cast<DenseIDPtsMap*>(this)->slot(key);
+    }
+
+    /// Record an access of the i-th key of a chunk, its data is faulted back in
+    /// if spilled, or loaded from lazySource if it is not loaded yet
+    inline void touch(Chunk* chunk, u32_t i) {
+        u64_t bit = (u64_t)1 << (i & 63);
+        if (lazySource && (chunk->lazy[i >> 6].load(std::memory_order_acquire) & bit))
+            load(chunk, i);
+        if (spillStore == NULL)
+            return;
+        chunk->touched[i >> 6] |= bit;
+        if (chunk->spilled[i >> 6] & bit) {
+            chunk->spilled[i >> 6] &= ~bit;
+            spillStore->fault(chunk->spillSlots[i], chunk->slot(i).second);
+        }
+    }
+
+    /// Load the data of the i-th key of a chunk from lazySource. The key is
+    /// marked as loaded after its data is complete, so that a thread seeing
+    /// the mark also sees the data.
+    void load(Chunk* chunk, u32_t i) {
+        static std::mutex loadMutex;
+        std::lock_guard<std::mutex> lock(loadMutex);
+        u64_t bit = (u64_t)1 << (i & 63);
+        if ((chunk->lazy[i >> 6].load(std::memory_order_relaxed) & bit) == 0)
+            return;
+        value_type& kv = chunk->slot(i);
+        lazySource->load(kv.first, kv.second);
+        chunk->lazy[i >> 6].fetch_and(~bit, std::memory_order_release);
+    }
+
+    /// The smallest present key which is not less than from
+    Key nextKey(Key from) const {
+        for (u32_t c = from >> ChunkBits; c < chunks.size(); ++c) {
+            const Chunk* chunk = chunks[c].get();
+            u32_t i = (c == (from >> ChunkBits)) ? (from & ChunkMask) : 0;
+            if (chunk == nullptr)
+                continue;
+            for (; i < ChunkSize; ++i) {
+                u64_t word = chunk->present[i >> 6] >> (i & 63);
+                if (word == 0) {
+                    i |= 63;
+                    continue;
+                }
+                while ((word & 1) == 0) {
+                    word >>= 1;
+                    ++i;
+                }
+                return (c << ChunkBits) + i;
+            }
+        }
+        return InvalidKey;
+    }
+};
+
+/*!
+ * Storage of the points-to maps of PTData.
+ * Dense integer keys (NodeID/EdgeID) are indexed directly, other keys use std::map.
+ */
+template<class Key, class Data>
+struct PtsMapTrait {
+    typedef std::map<const Key, Data> PtsMap;
+
+    /// Only the data of dense maps is spilled
+    //@{
+    static inline void enableSpill(PtsMap&, PtsSpillStore*) {
+    }
+    template<class HotFn>
+    static inline u64_t spillCold(PtsMap&, u64_t, const HotFn&) {
+        return 0;
+    }
+    //@}
+    /// Data of other maps is loaded at once
+    static inline void addLazy(PtsMap& map, const Key& key, PtsLazySource<Data>* source) {
+        source->load(key, map[key]);
+    }
+};
+template<class Data>
+struct PtsMapTrait<u32_t, Data> {
+    typedef DenseIDPtsMap<Data> PtsMap;
+
+    static inline void enableSpill(PtsMap& map, PtsSpillStore* store) {
+        map.enableSpill(store);
+    }
+    template<class HotFn>
+    static inline u64_t spillCold(PtsMap& map, u64_t target, const HotFn& isHot) {
+        return map.spillCold(target, isHot);
+    }
+    static inline void addLazy(PtsMap& map, u32_t key, PtsLazySource<Data>* source) {
+        map.addLazy(key, source);
+    }
+};
+
 /*!
  * Basic points-to data structure
  * Given a key (variable/condition variable), return its points-to data (pts/condition pts)
@@ -56,10 +392,12 @@ raw_ostream& operator<< (raw_ostream &o, const CondVar<Cond> &cvar) {
 template<class Key, class Data>
 class PTData {
 public:
-    typedef std::map<const Key, Data> PtsMap;
+    typedef PtsMapTrait<Key,Data> PtsMapTraitTy;
+    typedef typename PtsMapTrait<Key,Data>::PtsMap PtsMap;
     typedef typename PtsMap::iterator PtsMapIter;
     typedef typename PtsMap::const_iterator PtsMapConstIter;
     typedef typename Data::iterator iterator;
+    typedef std::function<bool(u32_t)> SpillHotFn;	///< whether the data of a dense key is hot
 
     /// Types of a points-to data structure
     enum PTDataTY {
@@ -116,6 +454,33 @@ public:
         addRevPts(srcData,dstKey);
         return unionPts(getPts(dstKey),srcData);
     }
+    //@}
+
+    /// Record reverse points-to of a union which has been performed directly on
+    /// the data returned by getPts (e.g., by worker threads of a parallel solver)
+    inline void updateRevPts(const Key& dstKey, const Data& srcData) {
+        addRevPts(srcData,dstKey);
+    }
+
+    /// Add a key whose points-to is loaded from source when it is first accessed.
+    /// Its reverse points-to is not recorded.
+    inline void addLazyPts(const Key& var, PtsLazySource<Data>* source) {
+        PtsMapTraitTy::addLazy(ptsMap, var, source);
+    }
+
+    /// Spill cold points-to sets to store, see DenseIDPtsMap::spillCold
+    //@{
+    virtual void enableSpill(PtsSpillStore* store) {
+        PtsMapTraitTy::enableSpill(ptsMap, store);
+        PtsMapTraitTy::enableSpill(revPtsMap, store);
+    }
+    virtual u64_t spillColdPts(u64_t target, const SpillHotFn& isHot) {
+        u64_t released = PtsMapTraitTy::spillCold(revPtsMap, target, isHot);
+        if (released < target)
+            released += PtsMapTraitTy::spillCold(ptsMap, target - released, isHot);
+        return released;
+    }
+    //@}
 
 protected:
     PtsMap ptsMap;
@@ -176,6 +541,9 @@ public:
     typedef typename PTData<Key,Data>::PtsMap PtsMap;
     typedef typename PTData<CacheKey,Data>::PtsMap CahcePtsMap;
     typedef typename PTData<Key,Data>::PTDataTY PTDataTy;
+    typedef typename PTData<Key,Data>::PtsMapTraitTy PtsMapTraitTy;
+    typedef typename PTData<CacheKey,Data>::PtsMapTraitTy CachePtsMapTraitTy;
+    typedef typename PTData<Key,Data>::SpillHotFn SpillHotFn;
     /// Constructor
     DiffPTData(PTDataTy ty = (PTData<Key,Data>::DiffPTD)): PTData<Key,Data>(ty) {
     }
@@ -233,6 +601,29 @@ public:
         CacheMap[cache] |= data;
     }
 
+    /// Spill cold propagated, diff and cached points-to sets before the base ones.
+    /// Cached sets are keyed by edges, they are cold if not accessed since the last round.
+    //@{
+    virtual void enableSpill(PtsSpillStore* store) {
+        PTData<Key,Data>::enableSpill(store);
+        PtsMapTraitTy::enableSpill(diffPtsMap, store);
+        PtsMapTraitTy::enableSpill(propaPtsMap, store);
+        CachePtsMapTraitTy::enableSpill(CacheMap, store);
+    }
+    virtual u64_t spillColdPts(u64_t target, const SpillHotFn& isHot) {
+        u64_t released = PtsMapTraitTy::spillCold(propaPtsMap, target, isHot);
+        if (released < target)
+            released += PtsMapTraitTy::spillCold(diffPtsMap, target - released, isHot);
+        if (released < target)
+            released += CachePtsMapTraitTy::spillCold(CacheMap, target - released, [](u32_t) {
+            return false;
+        });
+        if (released < target)
+            released += PTData<Key,Data>::spillColdPts(target - released, isHot);
+        return released;
+    }
+    //@}
+
     /// Methods for support type inquiry through isa, cast, and dyn_cast:
     //@{
     static inline bool classof(const DiffPTData<Key,Data,CacheKey> *) {
@@ -0,0 +1,266 @@
+//===- PointsToTable.h -- Hash-consed points-to sets -------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PointsToTable.h
+ *
+ *  Every distinct points-to set is stored once in the PointsToTable and is
+ *  referred to by a reference-counted ID. Union, intersection and complement
+ *  of two IDs are memoised, so repeating the same operation costs a lookup.
+ *
+ *  InternedPointsTo wraps an ID with the PointsTo interface used by PTData,
+ *  DiffPTData and DFPTData, so that it can be used as their Data type.
+ */
+
+#ifndef POINTSTOTABLE_H_
+#define POINTSTOTABLE_H_
+
+#include "Util/BasicTypes.h"
+#include <deque>
+#include <unordered_map>
+
+/*!
+ * Table of distinct points-to sets
+ */
+class PointsToTable {
+public:
+    typedef u32_t PtsID;
+    typedef std::pair<PtsID, PtsID> PtsIDPair;
+    typedef llvm::DenseMap<PtsIDPair, PtsID> MemoMap;
+
+    /// ID of the empty set, which is never released
+    static const PtsID EmptyPts = 0;
+
+    /// The table shared by all interned points-to sets
+    static PointsToTable& getTable();
+
+    /// Return the ID of pts with one reference added
+    PtsID intern(const PointsTo& pts);
+
+    /// Reference counting
+    //@{
+    inline void retain(PtsID id) {
+        if (id == EmptyPts)
+            return;
+        entries[id].refCount++;
+        numOfRefs++;
+    }
+    void release(PtsID id);
+    //@}
+
+    /// Get the points-to set of an ID
+    inline const PointsTo& getPts(PtsID id) const {
+        return entries[id].pts;
+    }
+
+    /// Memoised operations, the returned ID has one reference added
+    //@{
+    PtsID unionPts(PtsID lhs, PtsID rhs);
+    PtsID intersectPts(PtsID lhs, PtsID rhs);
+    /// lhs - rhs
+    PtsID complementPts(PtsID lhs, PtsID rhs);
+    //@}
+
+    /// Add/remove a single element, the returned ID has one reference added
+    //@{
+    PtsID addElement(PtsID id, NodeID elem);
+    PtsID removeElement(PtsID id, NodeID elem);
+    //@}
+
+    /// Release the references held by the memo tables
+    void clearMemo();
+
+    /// Statistics
+    //@{
+    /// Number of distinct non-empty sets alive
+    inline u32_t getNumOfDistinctPts() const {
+        return entries.size() - 1 - freeIDs.size();
+    }
+    /// Number of references to non-empty sets, not counting those held by the memo tables
+    inline u64_t getNumOfPtsRefs() const {
+        return numOfRefs - numOfMemoRefs;
+    }
+    /// Average number of references sharing a distinct set, where both
+    /// the references and the sets held only by the memo tables are excluded
+    double getSharingRatio() const;
+    inline u64_t getNumOfMemoHits() const {
+        return numOfMemoHits;
+    }
+    inline u64_t getNumOfMemoMisses() const {
+        return numOfMemoMisses;
+    }
+    //@}
+
+private:
+    struct Entry {
+        PointsTo pts;
+        size_t hash;
+        u32_t refCount;
+        u32_t memoRefCount;	///< references held by the memo tables
+    };
+
+    PointsToTable();
+
+    /// Hash of the elements of a set
+    static size_t hashPts(const PointsTo& pts);
+
+    /// Look up a memoised result, the result has one reference added if found
+    bool lookupMemo(MemoMap& memo, PtsID lhs, PtsID rhs, PtsID& res);
+    /// Memoise a result, the memo table holds a reference to each ID
+    void addMemo(MemoMap& memo, PtsID lhs, PtsID rhs, PtsID res);
+    /// Add/drop a reference held by a memo table
+    //@{
+    void retainMemo(PtsID id);
+    void releaseMemo(PtsID id);
+    //@}
+
+    std::deque<Entry> entries;	///< a deque never moves its elements, so sets can be referenced
+    std::unordered_multimap<size_t, PtsID> hashToIDs;
+    std::vector<PtsID> freeIDs;
+
+    MemoMap unionMemo;
+    MemoMap intersectMemo;
+    MemoMap complementMemo;
+
+    u64_t numOfRefs;
+    u64_t numOfMemoRefs;
+    u64_t numOfMemoHits;
+    u64_t numOfMemoMisses;
+};
+
+/*!
+ * A points-to set stored in the PointsToTable.
+ * Copying is a reference count update, and the set is read-only via getPts().
+ */
+class InternedPointsTo {
+public:
+    typedef PointsToTable::PtsID PtsID;
+    typedef PointsTo::iterator iterator;
+
+    /// Constructors and destructor
+    //@{
+    InternedPointsTo(): id(PointsToTable::EmptyPts) {
+    }
+    InternedPointsTo(const InternedPointsTo& rhs): id(rhs.id) {
+        table().retain(id);
+    }
+    explicit InternedPointsTo(const PointsTo& pts): id(table().intern(pts)) {
+    }
+    ~InternedPointsTo() {
+        table().release(id);
+    }
+    inline InternedPointsTo& operator=(const InternedPointsTo& rhs) {
+        table().retain(rhs.id);
+        assign(rhs.id);
+        return *this;
+    }
+    //@}
+
+    /// Read the set
+    //@{
+    inline PtsID getID() const {
+        return id;
+    }
+    inline const PointsTo& getPts() const {
+        return table().getPts(id);
+    }
+    inline operator const PointsTo&() const {
+        return getPts();
+    }
+    inline iterator begin() const {
+        return getPts().begin();
+    }
+    inline iterator end() const {
+        return getPts().end();
+    }
+    inline bool empty() const {
+        return id == PointsToTable::EmptyPts;
+    }
+    inline unsigned count() const {
+        return getPts().count();
+    }
+    inline bool test(NodeID elem) const {
+        return getPts().test(elem);
+    }
+    inline bool operator==(const InternedPointsTo& rhs) const {
+        return id == rhs.id;
+    }
+    inline bool operator!=(const InternedPointsTo& rhs) const {
+        return id != rhs.id;
+    }
+    //@}
+
+    /// Update the set, the same as the PointsTo operations
+    //@{
+    inline void set(NodeID elem) {
+        test_and_set(elem);
+    }
+    inline bool test_and_set(NodeID elem) {
+        if (test(elem))
+            return false;
+        assign(table().addElement(id, elem));
+        return true;
+    }
+    inline void reset(NodeID elem) {
+        if (test(elem))
+            assign(table().removeElement(id, elem));
+    }
+    inline void clear() {
+        assign(PointsToTable::EmptyPts);
+    }
+    inline bool operator|=(const InternedPointsTo& rhs) {
+        return update(table().unionPts(id, rhs.id));
+    }
+    inline bool operator|=(const PointsTo& rhs) {
+        InternedPointsTo interned(rhs);
+        return *this |= interned;
+    }
+    inline bool operator&=(const InternedPointsTo& rhs) {
+        return update(table().intersectPts(id, rhs.id));
+    }
+    /// this = lhs - rhs
+    inline void intersectWithComplement(const InternedPointsTo& lhs, const InternedPointsTo& rhs) {
+        assign(table().complementPts(lhs.id, rhs.id));
+    }
+    //@}
+
+private:
+    static inline PointsToTable& table() {
+        return PointsToTable::getTable();
+    }
+    /// Replace the ID, the reference of newID is taken over
+    inline void assign(PtsID newID) {
+        PtsID oldID = id;
+        id = newID;
+        table().release(oldID);
+    }
+    /// Replace the ID, return true if the set has changed
+    inline bool update(PtsID newID) {
+        bool changed = (newID != id);
+        assign(newID);
+        return changed;
+    }
+
+    PtsID id;
+};
+
+#endif /* POINTSTOTABLE_H_ */
@@ -0,0 +1,123 @@
+//===- PtsSpillStore.h -- Out-of-core storage of points-to sets--------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PtsSpillStore.h
+ *
+ *  Storage of the cold points-to sets spilled when the memory budget of a
+ *  bit-vector based analysis is exceeded (-pts-mem-budget).
+ *
+ *  A spilled set is encoded as the delta-coded list of its members, or as its
+ *  raw 128-bit elements if that is smaller, and appended to an arena. The arena
+ *  is anonymous memory, or a memory-mapped file created in -pts-spill-dir whose
+ *  pages are written back and dropped from the resident set after every spill
+ *  round. The space of a set faulted back in is not reused.
+ */
+
+#ifndef PTSSPILLSTORE_H_
+#define PTSSPILLSTORE_H_
+
+#include "Util/BasicTypes.h"
+#include <string>
+#include <vector>
+
+class PtsSpillStore {
+public:
+    /// Location of an encoded set in the arena
+    struct Slot {
+        u64_t offset;
+        u32_t size;
+    };
+
+    /// Constructor, the arena is a file in dir unless dir is empty
+    PtsSpillStore(const std::string& dir);
+
+    /// Destructor
+    ~PtsSpillStore();
+
+    /// Create a store if the memory budget is enabled, otherwise return NULL
+    static PtsSpillStore* create();
+
+    /// Whether the memory usage is over the budget, overBytes is set to the
+    /// number of bytes to release to get back under the budget with some margin
+    static bool isOverBudget(u64_t& overBytes);
+
+    /// Encode pts into the arena, return false if the arena is exhausted.
+    /// The estimated memory held by pts is added to releasedBytes.
+    bool spill(const PointsTo& pts, Slot& slot, u64_t& releasedBytes);
+
+    /// Decode the set of a slot into pts
+    void fault(const Slot& slot, PointsTo& pts);
+
+    /// Finish a spill round, spilled pages are written back and
+    /// freed memory is returned to the system
+    void endRound();
+
+    /// Return true once every CheckInterval calls, for checking the memory usage
+    inline bool isCheckDue() {
+        return (++numOfChecks & (CheckInterval - 1)) == 0;
+    }
+
+    /// Statistics
+    //@{
+    inline u64_t getNumOfSpills() const {
+        return numOfSpills;
+    }
+    inline u64_t getNumOfFaults() const {
+        return numOfFaults;
+    }
+    inline u64_t getNumOfRounds() const {
+        return numOfRounds;
+    }
+    inline u64_t getSpilledBytes() const {
+        return used;
+    }
+    inline u64_t getReleasedBytes() const {
+        return releasedBytes;
+    }
+    inline bool isFileBacked() const {
+        return fd >= 0;
+    }
+    //@}
+
+private:
+    static const u32_t CheckInterval = 1024;
+
+    /// Make the arena hold size more bytes
+    bool reserve(u64_t size);
+
+    unsigned char* base;	///< start of the arena
+    u64_t capacity;			///< size of the address range of the arena
+    u64_t committed;		///< size of the spill file
+    u64_t used;				///< bytes of encoded sets in the arena
+    u64_t written;			///< bytes of the file already written back
+    int fd;					///< spill file, -1 for anonymous memory
+    std::vector<unsigned char> buffer;	///< encoding buffer
+
+    u64_t numOfChecks;
+    u64_t numOfSpills;
+    u64_t numOfFaults;
+    u64_t numOfRounds;
+    u64_t releasedBytes;
+};
+
+#endif /* PTSSPILLSTORE_H_ */
@@ -169,6 +169,11 @@ public:
     /// Annotate program according to final condition
     void annotatePaths();
 
+    /// Move the conditions of the slice into the BDD manager of pa, which computes
+    /// or reports them afterwards. Only the final condition and the conditions of
+    /// the sinks are kept
+    void transferConds(PathCondAllocator* pa);
+
 private:
     inline const SVFG* getSVFG() const {
         return svfg;
@@ -38,26 +38,86 @@
 
 typedef CFLSolver<SVFG*,CxtDPItem> CFLSrcSnkSolver;
 
+class SrcSnkDDA;
+
 /*!
- * General source-sink analysis, which serves as a base analysis to be extended for various clients
+ * Forward and backward traversal computing the program slice of a single source.
+ * Every traversal owns its worklist and visited items, hence the slices of
+ * different sources can be computed concurrently.
  */
-class SrcSnkDDA : public CFLSrcSnkSolver {
+class SrcSnkSliceSolver : public CFLSrcSnkSolver {
 
 public:
     typedef ProgSlice::SVFGNodeSet SVFGNodeSet;
-    typedef std::map<const SVFGNode*,ProgSlice*> SVFGNodeToSliceMap;
     typedef SVFGNodeSet::iterator SVFGNodeSetIter;
     typedef CxtDPItem DPIm;
     typedef std::set<DPIm> DPImSet;							///< dpitem set
     typedef std::map<const SVFGNode*, DPImSet> SVFGNodeToDPItemsMap; 	///< map a SVFGNode to its visited dpitems
 
+    /// Constructor
+    SrcSnkSliceSolver(SrcSnkDDA* d, ProgSlice* s);
+
+    /// Compute the forward slice from the source, then the backward slice
+    /// from the sinks reached unless the forward slice reaches globals
+    void solve();
+
+protected:
+    /// Forward traverse
+    virtual void forwardProcess(const DPIm& item);
+    /// Backward traverse
+    virtual inline void backwardProcess(const DPIm& item) {
+        const SVFGNode* node = getNode(item.getCurNodeID());
+        if(slice->inForwardSlice(node)) {
+            slice->addToBackwardSlice(node);
+        }
+    }
+    /// Propagate information forward by matching context
+    virtual void forwardpropagate(const DPIm& item, SVFGEdge* edge);
+    /// Propagate information backward without matching context, as forward analysis already did it
+    virtual void backwardpropagate(const DPIm& item, SVFGEdge* edge);
+    /// Whether has been visited or not, in order to avoid recursion on SVFG
+    //@{
+    inline bool forwardVisited(const SVFGNode* node, const DPIm& item) {
+        SVFGNodeToDPItemsMap::iterator it = nodeToDPItemsMap.find(node);
+        if(it!=nodeToDPItemsMap.end())
+            return it->second.find(item)!=it->second.end();
+        else
+            return false;
+    }
+    inline void addForwardVisited(const SVFGNode* node, const DPIm& item) {
+        nodeToDPItemsMap[node].insert(item);
+    }
+    inline bool backwardVisited(const SVFGNode* node) {
+        return visitedSet.find(node)!=visitedSet.end();
+    }
+    inline void addBackwardVisited(const SVFGNode* node) {
+        visitedSet.insert(node);
+    }
+    //@}
+
+private:
+    SrcSnkDDA* dda;		///< the analysis providing sources, sinks and globals
+    ProgSlice* slice;	///< the slice being computed
+    SVFGNodeToDPItemsMap nodeToDPItemsMap;	///<  record forward visited dpitems
+    SVFGNodeSet visitedSet;	///<  record backward visited nodes
+};
+
+/*!
+ * General source-sink analysis, which serves as a base analysis to be extended for various clients
+ */
+class SrcSnkDDA {
+
+public:
+    typedef ProgSlice::SVFGNodeSet SVFGNodeSet;
+    typedef std::map<const SVFGNode*,ProgSlice*> SVFGNodeToSliceMap;
+    typedef SVFGNodeSet::iterator SVFGNodeSetIter;
+    typedef std::vector<const SVFGNode*> SVFGNodeVector;
+
 private:
     ProgSlice* _curSlice;		/// current program slice
     SVFGNodeSet sources;		/// source nodes
     SVFGNodeSet sinks;		/// source nodes
     PathCondAllocator* pathCondAllocator;
-    SVFGNodeToDPItemsMap nodeToDPItemsMap;	///<  record forward visited dpitems
-    SVFGNodeSet visitedSet;	///<  record backward visited nodes
     SaberSVFGBuilder memSSA;
     SVFG* svfg;
     PTACallGraph* ptaCallGraph;
@@ -90,7 +150,6 @@ public:
         ptaCallGraph = new PTACallGraph(module);
         AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(module);
         svfg =  memSSA.buildPTROnlySVFG(ander);
-        setGraph(memSSA.getSVFG());
         //AndersenWaveDiff::releaseAndersenWaveDiff();
         /// allocate control-flow graph branch conditions
         getPathAllocator()->allocate(module);
@@ -106,7 +165,7 @@ public:
 
     /// Get SVFG
     inline const SVFG* getSVFG() const {
-        return graph();
+        return svfg;
     }
 
     /// Whether this svfg node may access global variable
@@ -115,27 +174,12 @@ public:
     }
     /// Slice operations
     //@{
-    void setCurSlice(const SVFGNode* src);
-
+    inline void setCurSlice(ProgSlice* slice) {
+        _curSlice = slice;
+    }
     inline ProgSlice* getCurSlice() const {
         return _curSlice;
     }
-    inline void addSinkToCurSlice(const SVFGNode* node) {
-        _curSlice->addToSinks(node);
-        addToCurForwardSlice(node);
-    }
-    inline bool isInCurForwardSlice(const SVFGNode* node) {
-        return _curSlice->inForwardSlice(node);
-    }
-    inline bool isInCurBackwardSlice(const SVFGNode* node) {
-        return _curSlice->inBackwardSlice(node);
-    }
-    inline void addToCurForwardSlice(const SVFGNode* node) {
-        _curSlice->addToForwardSlice(node);
-    }
-    inline void addToCurBackwardSlice(const SVFGNode* node) {
-        _curSlice->addToBackwardSlice(node);
-    }
     //@}
 
     /// Initialize sources and sinks
@@ -185,54 +229,10 @@ public:
     }
 
 protected:
-    /// Forward traverse
-    virtual inline void forwardProcess(const DPIm& item) {
-        const SVFGNode* node = getNode(item.getCurNodeID());
-        if(isSink(node)) {
-            addSinkToCurSlice(node);
-            _curSlice->setPartialReachable();
-        }
-        else
-            addToCurForwardSlice(node);
-    }
-    /// Backward traverse
-    virtual inline void backwardProcess(const DPIm& item) {
-        const SVFGNode* node = getNode(item.getCurNodeID());
-        if(isInCurForwardSlice(node)) {
-            addToCurBackwardSlice(node);
-        }
-    }
-    /// Propagate information forward by matching context
-    virtual void forwardpropagate(const DPIm& item, SVFGEdge* edge);
-    /// Propagate information backward without matching context, as forward analysis already did it
-    virtual void backwardpropagate(const DPIm& item, SVFGEdge* edge);
-    /// Whether has been visited or not, in order to avoid recursion on SVFG
-    //@{
-    inline bool forwardVisited(const SVFGNode* node, const DPIm& item) {
-        SVFGNodeToDPItemsMap::iterator it = nodeToDPItemsMap.find(node);
-        if(it!=nodeToDPItemsMap.end())
-            return it->second.find(item)!=it->second.end();
-        else
-            return false;
-    }
-    inline void addForwardVisited(const SVFGNode* node, const DPIm& item) {
-        nodeToDPItemsMap[node].insert(item);
-    }
-    inline bool backwardVisited(const SVFGNode* node) {
-        return visitedSet.find(node)!=visitedSet.end();
-    }
-    inline void addBackwardVisited(const SVFGNode* node) {
-        visitedSet.insert(node);
-    }
-    inline void clearVisitedMap() {
-        nodeToDPItemsMap.clear();
-        visitedSet.clear();
-    }
-    //@}
-
     /// Guarded reachability search
     //@{
     virtual void AllPathReachability();
+    void solveGuards(ProgSlice* slice);
     inline bool isSatisfiableForAll(ProgSlice* slice) {
         return slice->isSatisfiableForAll();
     }
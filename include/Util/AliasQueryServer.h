@@ -0,0 +1,106 @@
+//===- AliasQueryServer.h -- Resident server of alias queries----------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+
+/*
+ * AliasQueryServer.h
+ *
+ *  A resident server answering queries on an analysed module (-query-server),
+ *  so that the PAG, the pre-analysis and the SVFG are built once for many queries.
+ *  Requests and responses are single lines, read from stdin and written to stdout,
+ *  or exchanged over the UNIX socket given by -query-socket=<path>.
+ *
+ *    pts <value>             points-to set of a value as PAG node IDs
+ *    alias <value> <value>   NoAlias, MayAlias, MustAlias or PartialAlias
+ *    callees <inst>          names of the functions called at a callsite
+ *    mhp <inst> <inst>       whether two instructions may happen in parallel
+ *    quit                    stop the server
+ *
+ *  A value is a PAG node ID, @name of a global or a function, or fun:%name of
+ *  an argument or an instruction. An instruction is fun:%name or fun:#n, the
+ *  n-th instruction of fun counted from 0. A response is "ok" followed by the
+ *  answer, or "error" followed by a message.
+ */
+
+#ifndef ALIASQUERYSERVER_H_
+#define ALIASQUERYSERVER_H_
+
+#include "Util/BasicTypes.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+class PointerAnalysis;
+
+class AliasQueryServer {
+public:
+    /// Whether two instructions may happen in parallel, provided by the MTA side
+    /// so that no MTA code is linked with the server
+    typedef std::function<bool(const Instruction*, const Instruction*)> MHPQuery;
+
+    /// Constructor. Queries of PAG nodes which are not top-level pointers are
+    /// answered by fallback if given, mhp queries are answered only if m is given
+    AliasQueryServer(PointerAnalysis* p, PointerAnalysis* f = NULL, MHPQuery m = MHPQuery()):
+        pta(p), fallback(f), mhp(m) {
+    }
+
+    /// Whether the server mode is enabled
+    static bool isEnabled();
+
+    /// Serve requests until the input ends or quit is received
+    void run();
+
+    /// Answer a request line
+    std::string answer(const std::string& request);
+
+private:
+    /// Serve the stdin/stdout or the socket
+    void runServer();
+
+    /// Serve the requests read from inFd, return true if quit is received
+    bool serve(int inFd, int outFd);
+
+    /// The analysis answering the queries of a PAG node, demand-driven
+    /// points-to of the node is computed here
+    PointerAnalysis* getPTA(NodeID id);
+
+    /// Resolve a value or an instruction reference, set err if not found
+    //@{
+    bool resolveValue(const std::string& ref, NodeID& id, std::string& err);
+    const Instruction* resolveInst(const std::string& ref, std::string& err);
+    const Value* resolveLocal(const std::string& ref);
+    //@}
+
+    /// Answer requests
+    //@{
+    std::string answerPts(const std::vector<std::string>& args);
+    std::string answerAlias(const std::vector<std::string>& args);
+    std::string answerCallees(const std::vector<std::string>& args);
+    std::string answerMHP(const std::vector<std::string>& args);
+    //@}
+
+    PointerAnalysis* pta;		///< analysis answering queries
+    PointerAnalysis* fallback;	///< analysis answering queries pta cannot
+    MHPQuery mhp;				///< may-happen-in-parallel queries
+};
+
+#endif /* ALIASQUERYSERVER_H_ */
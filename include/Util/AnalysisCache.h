@@ -0,0 +1,77 @@
+//===- AnalysisCache.h -- On-disk cache of analysis results------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+
+/*
+ * AnalysisCache.h
+ *
+ *  A directory of analysis artifacts (-analysis-cache=<dir>).
+ *  An artifact is named after a hash of the input modules, the name of the
+ *  stage that produced it and a hash of the options that affect its result,
+ *  so runs of different tools on the same bitcode can reuse each other's work.
+ */
+
+#ifndef ANALYSISCACHE_H_
+#define ANALYSISCACHE_H_
+
+#include "Util/SVFModule.h"
+
+class AnalysisCache {
+public:
+    /// Whether a cache directory is given
+    static bool isEnabled();
+
+    /// Path of the artifact of a stage, the options given are those that
+    /// affect the result of the stage besides the PAG building options
+    static std::string getArtifactPath(SVFModule module, const std::string& stage,
+                                       const std::string& stageOptions);
+
+    /// Path of an artifact shared by runs on any input modules, for artifacts
+    /// whose parts are checked against the modules when they are read
+    static std::string getStorePath(const std::string& stage, const std::string& stageOptions);
+
+    /// Hash of the instructions of a function, which is not changed by
+    /// changes elsewhere in its module
+    static std::string getFunctionHash(const Function* fun);
+
+    /// Whether an artifact has been stored
+    static bool hasArtifact(const std::string& path);
+
+    /// Artifacts are written to a temporary file first, and moved to their
+    /// path when complete, so concurrent runs never see a partial artifact
+    //@{
+    static std::string getTempPath(const std::string& path);
+    static bool commitArtifact(const std::string& tempPath, const std::string& path);
+    //@}
+
+    /// Hash of the bitcode of all input modules
+    static const std::string& getModuleHash(SVFModule module);
+
+private:
+    /// Create the cache directory and return the path of an artifact in it
+    static std::string getPathInCache(const std::string& name);
+
+    /// Values of the options that change how the PAG is built
+    static std::string getPAGOptions();
+};
+
+#endif /* ANALYSISCACHE_H_ */
@@ -96,6 +96,7 @@ typedef llvm::SmallVector<u32_t,16> SmallVector16;
 typedef llvm::SmallVector<u32_t,8> SmallVector8;
 typedef NodeSet EdgeSet;
 typedef SmallVector16 CallStrCxt;
+typedef u32_t CallStrCxtID;	///< interned call string context, see CallStrCxtTrie
 typedef llvm::StringMap<u32_t> StringMap;
 
 /// LLVM debug macros, define type of your DEBUG model of each pass
@@ -0,0 +1,151 @@
+//===- CallStrCxtTrie.h -- Interned call string contexts---------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CallStrCxtTrie.h
+ *
+ * Call string contexts interned in a trie, so that a context is a 32-bit ID,
+ * and pushing, popping, comparing and hashing a context take constant time.
+ */
+
+#ifndef INCLUDE_UTIL_CALLSTRCXTTRIE_H_
+#define INCLUDE_UTIL_CALLSTRCXTTRIE_H_
+
+#include "Util/BasicTypes.h"
+#include <atomic>
+#include <mutex>
+
+/*!
+ * Trie of the call string contexts shared by all analyses.
+ * A node of the trie is a context whose parent is the context with its last
+ * call site popped, and the root is the empty context.
+ *
+ * Nodes are never removed, so IDs are valid during the whole run and the same
+ * call string always has the same ID. Nodes are kept in chunks which are never
+ * moved, so a node is read without locking while other threads (e.g., DDA
+ * workers) push new contexts. Children are looked up in maps sharded by the
+ * hash of (parent, call site), each with its own lock, so threads pushing
+ * different contexts rarely wait for each other.
+ *
+ * IDs are given in the order contexts are first pushed, which depends on
+ * thread scheduling when contexts are pushed by concurrent workers. Hence
+ * contexts are ordered by their call strings (less), not by their IDs, so
+ * that sets and maps keyed by contexts (e.g., ContextCond, CxtStmt) are
+ * iterated in the same order in every run. IDs are only used for equality
+ * and hashing.
+ */
+class CallStrCxtTrie {
+public:
+    /// The empty context
+    static const CallStrCxtID emptyCxt = 0;
+
+    /// Context with a call site pushed, the context is created if not yet
+    static CallStrCxtID push(CallStrCxtID cxt, CallSiteID csId);
+
+    /// Context with its last call site popped
+    static inline CallStrCxtID pop(CallStrCxtID cxt) {
+        return getNode(cxt).parent;
+    }
+    /// Context with its first call site dropped
+    static CallStrCxtID popFront(CallStrCxtID cxt);
+
+    /// Last (most recent) call site of a context
+    static inline CallSiteID back(CallStrCxtID cxt) {
+        return getNode(cxt).csId;
+    }
+    /// First call site of a context
+    static inline CallSiteID front(CallStrCxtID cxt) {
+        return getNode(cxt).front;
+    }
+    /// Number of call sites in a context
+    static inline u32_t size(CallStrCxtID cxt) {
+        return cxt == emptyCxt ? 0 : getNode(cxt).size;
+    }
+    static inline bool empty(CallStrCxtID cxt) {
+        return cxt == emptyCxt;
+    }
+
+    /// Whether a context contains a call site
+    static bool contains(CallStrCxtID cxt, CallSiteID csId);
+
+    /// Whether the call string of cxt1 is lexicographically less than that of cxt2,
+    /// the same order as comparing CallStrCxt, in time linear in their sizes
+    static bool less(CallStrCxtID cxt1, CallStrCxtID cxt2);
+
+    /// Whether the last call sites of two contexts are the same up to the shorter one,
+    /// e.g., [1 2 3] matches [1 2 3] and [2 3] but not [4 2 3]
+    static bool matchSuffix(CallStrCxtID cxt1, CallStrCxtID cxt2);
+
+    /// Convert between call strings and their contexts
+    //@{
+    static CallStrCxtID getCxtID(const CallStrCxt& callStr);
+    static CallStrCxt getCallStr(CallStrCxtID cxt);
+    //@}
+
+    /// Return context in string format
+    static std::string toString(CallStrCxtID cxt);
+
+    /// Number of contexts created, including the empty context
+    static u32_t getNumOfCxts();
+
+private:
+    /// A context in the trie
+    struct CxtNode {
+        CallStrCxtID parent;
+        CallSiteID csId;
+        CallSiteID front;
+        u32_t size;
+    };
+
+    static const u32_t chunkBits = 16;
+    static const u32_t chunkSize = 1U << chunkBits;
+    static const u32_t maxChunks = 1U << (32 - chunkBits);
+
+    static inline const CxtNode& getNode(CallStrCxtID cxt) {
+        assert(cxt != emptyCxt && "empty context has no call site!");
+        return chunks[cxt >> chunkBits][cxt & (chunkSize - 1)];
+    }
+    /// Key of a child in the trie
+    static inline u64_t getChildKey(CallStrCxtID parent, CallSiteID csId) {
+        return ((u64_t)parent << 32) | csId;
+    }
+
+    /// Children of the keys of the same hash, on a cache line of its own
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        llvm::DenseMap<u64_t, CallStrCxtID> children;	///< (parent, call site) to child
+    };
+    static const u32_t shardBits = 6;
+    static const u32_t numOfShards = 1U << shardBits;
+
+    static inline Shard& getShard(u64_t key) {
+        u32_t hash = (u32_t)(key ^ (key >> 32)) * 0x9e3779b1U;
+        return shards[hash >> (32 - shardBits)];
+    }
+
+    static CxtNode* chunks[maxChunks];	///< nodes, chunks are allocated on demand
+    static std::atomic<u32_t> numOfCxts;	///< next ID to create, ID 0 is the root
+    static Shard shards[numOfShards];	///< children of nodes
+    static std::mutex chunkMutex;		///< guards allocating chunks
+};
+
+#endif /* INCLUDE_UTIL_CALLSTRCXTTRIE_H_ */
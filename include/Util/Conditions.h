@@ -41,10 +41,8 @@ class BddCondManager {
 public:
     typedef std::map<unsigned,DdNode*> IndexToDDNodeMap;
 
-    /// Constructor
-    BddCondManager() {
-        m_bdd_mgr = Cudd_Init(0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
-    }
+    /// Constructor, the sizes of the unique table and the cache are configurable
+    BddCondManager();
 
     /// Destructor
     ~BddCondManager() {
@@ -86,6 +84,13 @@ public:
     inline void markForRelease(DdNode* cond) {
         Cudd_RecursiveDeref(m_bdd_mgr,cond);
     }
+    /// Enable dynamic variable reordering (-bdd-reorder) until its time budget is used up.
+    /// Reordering in CUDD keeps global state, so it is only enabled for a manager
+    /// which is never used concurrently with another one
+    void enableReordering();
+    /// Copy a condition of another manager into this one, which allows conditions
+    /// computed concurrently by different managers to be combined
+    DdNode* transfer(DdNode* cond, const BddCondManager* from);
     /// Operations on conditions.
     //@{
     DdNode* AND(DdNode* lhs, DdNode* rhs);
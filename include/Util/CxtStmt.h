@@ -30,7 +30,7 @@
 #ifndef INCLUDE_UTIL_CXTSTMT_H_
 #define INCLUDE_UTIL_CXTSTMT_H_
 
-#include "Util/BasicTypes.h"
+#include "Util/CallStrCxtTrie.h"
 
 /*!
  * Context-sensitive thread statement <c,s>
@@ -38,7 +38,7 @@
 class CxtStmt  {
 public:
     /// Constructor
-    CxtStmt(const CallStrCxt& c, const Instruction* f) :cxt(c), inst(f) {
+    CxtStmt(CallStrCxtID c, const Instruction* f) :cxt(c), inst(f) {
     }
     /// Copy constructor
     CxtStmt(const CxtStmt& ctm) : cxt(ctm.getContext()),inst(ctm.getStmt()) {
@@ -47,7 +47,7 @@ public:
     virtual ~CxtStmt() {
     }
     /// Return current context
-    inline const CallStrCxt& getContext() const {
+    inline CallStrCxtID getContext() const {
         return cxt;
     }
     /// Return current statement
@@ -55,12 +55,12 @@ public:
         return inst;
     }
     /// Enable compare operator to avoid duplicated item insertion in map or set
-    /// to be noted that two vectors can also overload operator()
+    /// to be noted that contexts are compared by their IDs in CallStrCxtTrie
     inline bool operator< (const CxtStmt& rhs) const {
         if(inst!=rhs.getStmt())
             return inst < rhs.getStmt();
         else
-            return cxt < rhs.getContext();
+            return CallStrCxtTrie::less(cxt, rhs.getContext());
     }
     /// Overloading operator=
     inline CxtStmt& operator= (const CxtStmt& rhs) {
@@ -80,14 +80,7 @@ public:
     }
     /// Return context in string format
     inline std::string cxtToStr() const {
-        std::string str;
-        raw_string_ostream rawstr(str);
-        rawstr << "[:";
-        for(CallStrCxt::const_iterator it = cxt.begin(), eit = cxt.end(); it!=eit; ++it) {
-            rawstr << *it << " ";
-        }
-        rawstr << " ]";
-        return rawstr.str();
+        return CallStrCxtTrie::toString(cxt);
     }
     /// Dump CxtStmt
     inline void dump() const {
@@ -95,7 +88,7 @@ public:
     }
 
 protected:
-    CallStrCxt cxt;
+    CallStrCxtID cxt;
     const Instruction* inst;
 };
 
@@ -106,7 +99,7 @@ protected:
 class CxtThreadStmt : public CxtStmt {
 public:
     /// Constructor
-    CxtThreadStmt(NodeID t, const CallStrCxt& c, const Instruction* f) :CxtStmt(c,f), tid(t) {
+    CxtThreadStmt(NodeID t, CallStrCxtID c, const Instruction* f) :CxtStmt(c,f), tid(t) {
     }
     /// Copy constructor
     CxtThreadStmt(const CxtThreadStmt& ctm) :CxtStmt(ctm), tid(ctm.getTid()) {
@@ -119,14 +112,14 @@ public:
         return tid;
     }
     /// Enable compare operator to avoid duplicated item insertion in map or set
-    /// to be noted that two vectors can also overload operator()
+    /// to be noted that contexts are compared by their IDs in CallStrCxtTrie
     inline bool operator< (const CxtThreadStmt& rhs) const {
         if (tid != rhs.getTid())
             return tid < rhs.getTid();
         else if(inst!=rhs.getStmt())
             return inst < rhs.getStmt();
         else
-            return cxt < rhs.getContext();
+            return CallStrCxtTrie::less(cxt, rhs.getContext());
     }
     /// Overloading operator=
     inline CxtThreadStmt& operator= (const CxtThreadStmt& rhs) {
@@ -160,7 +153,7 @@ private:
 class CxtThread {
 public:
     /// Constructor
-    CxtThread(const CallStrCxt& c, const CallInst* fork) : cxt(c), forksite(fork), inloop(false), incycle(false)  {
+    CxtThread(CallStrCxtID c, const CallInst* fork) : cxt(c), forksite(fork), inloop(false), incycle(false)  {
     }
     /// Copy constructor
     CxtThread(const CxtThread& ct) :
@@ -170,7 +163,7 @@ public:
     virtual ~CxtThread() {
     }
     /// Return context of the thread
-    inline const CallStrCxt& getContext() const {
+    inline CallStrCxtID getContext() const {
         return cxt;
     }
     /// Return forksite
@@ -178,12 +171,12 @@ public:
         return forksite;
     }
     /// Enable compare operator to avoid duplicated item insertion in map or set
-    /// to be noted that two vectors can also overload operator()
+    /// to be noted that contexts are compared by their IDs in CallStrCxtTrie
     inline bool operator< (const CxtThread& rhs) const {
         if (forksite != rhs.getThread())
             return forksite < rhs.getThread();
         else
-            return cxt < rhs.getContext();
+            return CallStrCxtTrie::less(cxt, rhs.getContext());
     }
     /// Overloading operator=
     inline CxtThread& operator= (const CxtThread& rhs) {
@@ -203,14 +196,7 @@ public:
     }
     /// Return context in string format
     inline std::string cxtToStr() const {
-        std::string str;
-        raw_string_ostream rawstr(str);
-        rawstr << "[:";
-        for(CallStrCxt::const_iterator it = cxt.begin(), eit = cxt.end(); it!=eit; ++it) {
-            rawstr << *it << " ";
-        }
-        rawstr << " ]";
-        return rawstr.str();
+        return CallStrCxtTrie::toString(cxt);
     }
 
     /// inloop, incycle attributes
@@ -242,7 +228,7 @@ public:
                          << loop << cycle <<"  ]\n";
     }
 protected:
-    CallStrCxt cxt;
+    CallStrCxtID cxt;
     const CallInst* forksite;
     bool inloop;
     bool incycle;
@@ -257,7 +243,7 @@ protected:
 class CxtProc {
 public:
     /// Constructor
-    CxtProc(const CallStrCxt& c, const Function* f) :
+    CxtProc(CallStrCxtID c, const Function* f) :
         cxt(c), fun(f) {
     }
     /// Copy constructor
@@ -272,16 +258,16 @@ public:
         return fun;
     }
     /// Return current context
-    inline const CallStrCxt& getContext() const {
+    inline CallStrCxtID getContext() const {
         return cxt;
     }
     /// Enable compare operator to avoid duplicated item insertion in map or set
-    /// to be noted that two vectors can also overload operator()
+    /// to be noted that contexts are compared by their IDs in CallStrCxtTrie
     inline bool operator<(const CxtProc& rhs) const {
         if (fun != rhs.getProc())
             return fun < rhs.getProc();
         else
-            return cxt < rhs.getContext();
+            return CallStrCxtTrie::less(cxt, rhs.getContext());
     }
     /// Overloading operator=
     inline CxtProc& operator=(const CxtProc& rhs) {
@@ -301,14 +287,7 @@ public:
     }
     /// Return context in string format
     inline std::string cxtToStr() const {
-        std::string str;
-        raw_string_ostream rawstr(str);
-        rawstr << "[:";
-        for (CallStrCxt::const_iterator it = cxt.begin(), eit = cxt.end(); it != eit; ++it) {
-            rawstr << *it << " ";
-        }
-        rawstr << " ]";
-        return rawstr.str();
+        return CallStrCxtTrie::toString(cxt);
     }
     /// Dump CxtProc
     inline void dump() const {
@@ -316,7 +295,7 @@ public:
     }
 
 protected:
-    CallStrCxt cxt;
+    CallStrCxtID cxt;
     const Function* fun;
 };
 
@@ -330,7 +309,7 @@ protected:
 class CxtThreadProc : public CxtProc {
 public:
     /// Constructor
-    CxtThreadProc(NodeID t, const CallStrCxt& c, const Function* f) :CxtProc(c,f),tid(t) {
+    CxtThreadProc(NodeID t, CallStrCxtID c, const Function* f) :CxtProc(c,f),tid(t) {
     }
     /// Copy constructor
     CxtThreadProc(const CxtThreadProc& ctm) : CxtProc(ctm.getContext(),ctm.getProc()), tid(ctm.getTid()) {
@@ -343,14 +322,14 @@ public:
         return tid;
     }
     /// Enable compare operator to avoid duplicated item insertion in map or set
-    /// to be noted that two vectors can also overload operator()
+    /// to be noted that contexts are compared by their IDs in CallStrCxtTrie
     inline bool operator< (const CxtThreadProc& rhs) const {
         if (tid != rhs.getTid())
             return tid < rhs.getTid();
         else if(fun!=rhs.getProc())
             return fun < rhs.getProc();
         else
-            return cxt < rhs.getContext();
+            return CallStrCxtTrie::less(cxt, rhs.getContext());
     }
     /// Overloading operator=
     inline CxtThreadProc& operator= (const CxtThreadProc& rhs) {
@@ -31,9 +31,11 @@
 #define DPITEM_H_
 
 #include "Util/PathCondAllocator.h"
+#include "Util/CallStrCxtTrie.h"
 #include "MemoryModel/ConditionalPT.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>    // std::sort
+#include <atomic>
 
 /*!
  * Dynamic programming item for CFL researchability search
@@ -43,7 +45,8 @@
 class DPItem {
 protected:
     NodeID cur;
-    static u64_t maximumBudget;
+    /// per thread, since solvers answering queries concurrently each set their own budget
+    static thread_local u64_t maximumBudget;
 
 public:
     /// Constructor
@@ -160,12 +163,12 @@ public:
 
 /*!
  * Context Condition
+ * The call string is interned in CallStrCxtTrie, so copying and comparing conditions take constant time
  */
 class ContextCond {
 public:
-    typedef CallStrCxt::const_iterator const_iterator;
     /// Constructor
-    ContextCond():concreteCxt(true) {
+    ContextCond():context(CallStrCxtTrie::emptyCxt), concreteCxt(true) {
     }
     /// Copy Constructor
     ContextCond(const ContextCond& cond): context(cond.getContexts()), concreteCxt(cond.isConcreteCxt()) {
@@ -174,12 +177,16 @@ public:
     virtual ~ContextCond() {
     }
     /// Get context
-    inline const CallStrCxt& getContexts() const {
+    inline CallStrCxtID getContexts() const {
         return context;
     }
-    /// Get context
-    inline CallStrCxt& getContexts() {
-        return context;
+    /// Set context
+    inline void setContexts(CallStrCxtID cxt) {
+        context = cxt;
+    }
+    /// Get the call string of context
+    inline CallStrCxt getCallStr() const {
+        return CallStrCxtTrie::getCallStr(context);
     }
     /// Whether it is an concrete context
     inline bool isConcreteCxt() const {
@@ -191,31 +198,36 @@ public:
     }
     /// Whether contains callstring cxt
     inline bool containCallStr(NodeID cxt) const {
-        return std::find(context.begin(),context.end(),cxt) != context.end();
+        return CallStrCxtTrie::contains(context,cxt);
     }
     /// Get context size
     inline u32_t cxtSize() const {
-        return context.size();
+        return CallStrCxtTrie::size(context);
     }
     /// set max context limit
     static inline void setMaxCxtLen(u32_t max) {
         maximumCxtLen = max;
     }
+    /// get max context limit
+    static inline u32_t getMaxCxtLen() {
+        return maximumCxtLen;
+    }
     /// Push context
     inline virtual bool pushContext(NodeID ctx) {
 
-        if(context.size() < maximumCxtLen) {
-            context.push_back(ctx);
+        u32_t size = cxtSize();
+        if(size < maximumCxtLen) {
+            context = CallStrCxtTrie::push(context,ctx);
 
-            if(context.size() > maximumCxt)
-                maximumCxt = context.size();
+            /// solvers answering queries concurrently push contexts at the same time
+            u32_t maxCxt = maximumCxt.load(std::memory_order_relaxed);
+            while(size + 1 > maxCxt && !maximumCxt.compare_exchange_weak(maxCxt, size + 1, std::memory_order_relaxed));
             return true;
         }
         else { /// handle out of context limit case
-            if(!context.empty()) {
+            if(size != 0) {
                 setNonConcreteCxt();
-                context.erase(context.begin());
-                context.push_back(ctx);
+                context = CallStrCxtTrie::push(CallStrCxtTrie::popFront(context),ctx);
             }
             return false;
         }
@@ -224,25 +236,28 @@ public:
     /// Match context
     inline virtual bool matchContext(NodeID ctx) {
         /// if context is empty, then it is the unbalanced parentheses match
-        if(context.empty())
+        if(CallStrCxtTrie::empty(context))
             return true;
         /// otherwise, we perform balanced parentheses matching
-        else if(context.back() == ctx) {
-            context.pop_back();
+        else if(CallStrCxtTrie::back(context) == ctx) {
+            context = CallStrCxtTrie::pop(context);
             return true;
         }
         return false;
     }
+    /// Most recent call site of context
+    inline NodeID back() const {
+        return CallStrCxtTrie::back(context);
+    }
+    /// Pop the most recent call site of context
+    inline void popContext() {
+        context = CallStrCxtTrie::pop(context);
+    }
 
     /// Enable compare operator to avoid duplicated item insertion in map or set
-    /// to be noted that two vectors can also overload operator()
+    /// to be noted that contexts are ordered by their call strings rather than IDs
     inline bool operator< (const ContextCond& rhs) const {
-        return context < rhs.context;
-    }
-    /// Overloading operator[]
-    inline NodeID operator[] (const u32_t index) const {
-        assert(index < context.size());
-        return context[index];
+        return CallStrCxtTrie::less(context, rhs.context);
     }
     /// Overloading operator=
     inline ContextCond& operator= (const ContextCond& rhs) {
@@ -260,32 +275,17 @@ public:
     inline bool operator!= (const ContextCond& rhs) const {
         return !(*this==rhs);
     }
-    /// Begin iterators
-    inline const_iterator begin() const {
-        return context.begin();
-    }
-    /// End iterators
-    inline const_iterator end() const {
-        return context.end();
-    }
     /// Dump context condition
     inline std::string toString() const {
-        std::string str;
-        raw_string_ostream rawstr(str);
-        rawstr << "[:";
-        for(CallStrCxt::const_iterator it = context.begin(), eit = context.end(); it!=eit; ++it) {
-            rawstr << *it << " ";
-        }
-        rawstr << " ]";
-        return rawstr.str();
+        return CallStrCxtTrie::toString(context);
     }
 protected:
-    CallStrCxt context;
+    CallStrCxtID context;
 private:
     static u32_t maximumCxtLen;
     bool concreteCxt;
 public:
-    static u32_t maximumCxt;
+    static std::atomic<u32_t> maximumCxt;
 };
 
 /*!
@@ -463,7 +463,7 @@ public:
         if(path != rhs.path)
             return path < rhs.path;
         else
-            return context < rhs.context;
+            return CallStrCxtTrie::less(context, rhs.context);
     }
     /// Overloading operator=
     inline VFPathCond& operator= (const VFPathCond& rhs) {
@@ -495,8 +495,9 @@ public:
     inline std::string toString() const {
         std::string str;
         raw_string_ostream rawstr(str);
+        CallStrCxt callStr = getCallStr();
         rawstr << "[:";
-        for(CallStrCxt::const_iterator it = context.begin(), eit = context.end(); it!=eit; ++it) {
+        for(CallStrCxt::const_iterator it = callStr.begin(), eit = callStr.end(); it!=eit; ++it) {
             rawstr << *it << " ";
         }
         rawstr << " | ";
@@ -0,0 +1,259 @@
+//===- GraphExportFile.h -- Binary graph export format-----------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * GraphExportFile.h
+ *
+ *  Binary format used by -export-pag, -export-consG, -export-svfg and -export-icfg.
+ *
+ *  Layout (integers in host byte order):
+ *    Header     magic, version and the kind of the exported graph
+ *    Chunks     {type, numOfRecords, size} followed by size bytes of records
+ *      Node     {id, kind} of nodes
+ *      Edge     {src, dst, flag} of edges, the lower 4 bits of flag are the
+ *               edge kind and the others its label (e.g., a callsite ID)
+ *      Pts      {node, numOfTargets, targets...} of points-to sets
+ *      End      total numbers of nodes, edges and points-to sets
+ *
+ *  Kinds are the values of the node/edge kind enums of the graph classes.
+ *  Chunks are written as soon as they are full, so chunks of different tables
+ *  interleave and an edge may precede the nodes it connects. The reader only
+ *  holds one chunk in memory at a time.
+ *
+ *  This file and GraphExportFile.cpp only use the standard library, so tools
+ *  reading exported graphs can be built without LLVM and SVF.
+ */
+
+#ifndef GRAPHEXPORTFILE_H_
+#define GRAPHEXPORTFILE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/*!
+ * Common definitions of the binary graph file
+ */
+class GraphExportFile {
+public:
+    static const char Magic[8];
+    static const uint32_t Version = 1;
+    /// Payload size at which a chunk is written
+    static const uint32_t ChunkBytes = 1 << 20;
+
+    enum GraphKind {
+        PAGKind,
+        ConsGKind,
+        SVFGKind,
+        ICFGKind
+    };
+
+    enum ChunkType {
+        NodeChunk,
+        EdgeChunk,
+        PtsChunk,
+        EndChunk
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t graphKind;
+    };
+
+    struct ChunkHeader {
+        uint32_t type;
+        uint32_t numOfRecords;
+        uint64_t size;
+    };
+
+    struct NodeRecord {
+        uint32_t id;
+        int32_t kind;
+    };
+
+    struct EdgeRecord {
+        uint32_t src;
+        uint32_t dst;
+        uint64_t flag;
+    };
+
+    struct Totals {
+        uint64_t numOfNodes;
+        uint64_t numOfEdges;
+        uint64_t numOfPts;
+    };
+
+    /// Kind and label of an edge
+    //@{
+    static inline int32_t getEdgeKind(const EdgeRecord& edge) {
+        return edge.flag & 0xf;
+    }
+    static inline uint64_t getEdgeLabel(const EdgeRecord& edge) {
+        return edge.flag >> 4;
+    }
+    //@}
+};
+
+/*!
+ * Write a graph chunk by chunk
+ */
+class GraphExportWriter : public GraphExportFile {
+public:
+    GraphExportWriter(): file(NULL), error(false) {
+        std::fill(numOfRecords, numOfRecords + EndChunk, 0);
+        totals.numOfNodes = totals.numOfEdges = totals.numOfPts = 0;
+    }
+
+    ~GraphExportWriter() {
+        close();
+    }
+
+    /// Create the file and write its header
+    bool open(const std::string& filename, GraphKind kind);
+
+    /// Write the remaining chunks and the end chunk, return false on errors
+    bool close();
+
+    /// Add records, a chunk is written when it is full
+    //@{
+    inline void addNode(uint32_t id, int32_t kind) {
+        NodeRecord rec = {id, kind};
+        append(nodes, &rec, sizeof(rec));
+        numOfRecords[NodeChunk]++;
+        totals.numOfNodes++;
+        if (nodes.size() >= ChunkBytes)
+            writeChunk(NodeChunk, nodes);
+    }
+    inline void addEdge(uint32_t src, uint32_t dst, uint64_t flag) {
+        EdgeRecord rec = {src, dst, flag};
+        append(edges, &rec, sizeof(rec));
+        numOfRecords[EdgeChunk]++;
+        totals.numOfEdges++;
+        if (edges.size() >= ChunkBytes)
+            writeChunk(EdgeChunk, edges);
+    }
+    /// Add the points-to set of a node, Set is any set of integers with begin/end
+    template<class Set>
+    void addPts(uint32_t node, const Set& targets) {
+        size_t start = pts.size();
+        uint32_t header[2] = {node, 0};
+        append(pts, header, sizeof(header));
+        for (typename Set::iterator it = targets.begin(), eit = targets.end(); it != eit; ++it) {
+            uint32_t target = *it;
+            append(pts, &target, sizeof(target));
+            header[1]++;
+        }
+        std::copy((const char*)header, (const char*)header + sizeof(header), pts.begin() + start);
+        numOfRecords[PtsChunk]++;
+        totals.numOfPts++;
+        if (pts.size() >= ChunkBytes)
+            writeChunk(PtsChunk, pts);
+    }
+    //@}
+
+private:
+    static inline void append(std::vector<char>& buf, const void* data, size_t size) {
+        buf.insert(buf.end(), (const char*)data, (const char*)data + size);
+    }
+    /// Write the records of a chunk type buffered in buf
+    void writeChunk(ChunkType type, std::vector<char>& buf);
+    void write(const void* data, size_t size);
+
+    FILE* file;
+    bool error;
+    std::vector<char> nodes;
+    std::vector<char> edges;
+    std::vector<char> pts;
+    uint32_t numOfRecords[EndChunk];
+    Totals totals;
+};
+
+/*!
+ * Read a graph chunk by chunk
+ */
+class GraphExportReader : public GraphExportFile {
+public:
+    GraphExportReader(): file(NULL), graphKind(0), complete(false) {
+        chunk.type = EndChunk;
+        chunk.numOfRecords = 0;
+        chunk.size = 0;
+        totals.numOfNodes = totals.numOfEdges = totals.numOfPts = 0;
+    }
+
+    ~GraphExportReader() {
+        if (file)
+            fclose(file);
+    }
+
+    /// Open a file and check its header
+    bool open(const std::string& filename);
+
+    /// Read the next chunk, return false at the end chunk, the end of the file or on errors
+    bool nextChunk();
+
+    /// Whether the end chunk has been read and the totals match the records read
+    inline bool isComplete() const {
+        return complete;
+    }
+
+    inline GraphKind getGraphKind() const {
+        return (GraphKind)graphKind;
+    }
+
+    /// The current chunk
+    //@{
+    inline ChunkType getChunkType() const {
+        return (ChunkType)chunk.type;
+    }
+    inline uint32_t getNumOfRecords() const {
+        return chunk.numOfRecords;
+    }
+    inline const NodeRecord* getNodes() const {
+        return (const NodeRecord*)data.data();
+    }
+    inline const EdgeRecord* getEdges() const {
+        return (const EdgeRecord*)data.data();
+    }
+    /// Call fn(node, targets, numOfTargets) for every points-to set of a points-to chunk
+    template<class Fn>
+    void forEachPts(Fn fn) const {
+        const uint32_t* p = (const uint32_t*)data.data();
+        for (uint32_t i = 0; i < chunk.numOfRecords; ++i) {
+            fn(p[0], p + 2, p[1]);
+            p += 2 + p[1];
+        }
+    }
+    //@}
+
+private:
+    FILE* file;
+    uint32_t graphKind;
+    bool complete;
+    ChunkHeader chunk;
+    std::vector<char> data;
+    Totals totals;	///< records read so far
+};
+
+#endif /* GRAPHEXPORTFILE_H_ */
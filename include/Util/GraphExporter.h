@@ -0,0 +1,100 @@
+//===- GraphExporter.h -- Export graphs in the binary graph format-----------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * GraphExporter.h
+ *
+ *  Export of PAG, constraint graph, SVFG and ICFG in the format of
+ *  GraphExportFile, an alternative to the dot files of GraphPrinter
+ *  for graphs too large to render.
+ */
+
+#ifndef GRAPHEXPORTER_H_
+#define GRAPHEXPORTER_H_
+
+#include "Util/GraphExportFile.h"
+#include "MemoryModel/PointerAnalysis.h"
+
+class ConstraintGraph;
+class SVFG;
+class ICFG;
+
+class GraphExporter {
+
+public:
+    /// Export a graph to the file given by its option (-export-pag, -export-consG,
+    /// -export-svfg, -export-icfg), if any. Points-to sets of the nodes are
+    /// exported as well if -export-pts is given.
+    //@{
+    static void exportPAG(PAG* pag, PointerAnalysis* pta);
+    static void exportConsG(ConstraintGraph* consCG, PointerAnalysis* pta);
+    static void exportSVFG(SVFG* svfg);
+    static void exportICFG(ICFG* icfg);
+    //@}
+
+    /*!
+     * Stream the nodes, the out-edges of the nodes and the points-to sets
+     * computed by pta if given. Return false on errors.
+     */
+    template<class GraphType>
+    static bool exportGraph(const std::string& filename, GraphExportFile::GraphKind kind,
+                            GraphType* graph, PointerAnalysis* pta = NULL) {
+        GraphExportWriter writer;
+        if (!writer.open(filename, kind))
+            return false;
+
+        typedef typename GraphType::NodeType NodeType;
+        typedef typename GraphType::EdgeType EdgeType;
+        for (typename GraphType::iterator it = graph->begin(), eit = graph->end(); it != eit; ++it)
+            writer.addNode(it->first, it->second->getNodeKind());
+        for (typename GraphType::iterator it = graph->begin(), eit = graph->end(); it != eit; ++it) {
+            const NodeType* node = it->second;
+            for (const EdgeType* edge : node->getOutEdges())
+                writer.addEdge(edge->getSrcID(), edge->getDstID(), edge->getEdgeFlag());
+        }
+        if (pta) {
+            for (typename GraphType::iterator it = graph->begin(), eit = graph->end(); it != eit; ++it) {
+                const PointsTo& pts = pta->getPts(it->first);
+                if (!pts.empty())
+                    writer.addPts(it->first, pts);
+            }
+        }
+        return writer.close();
+    }
+
+private:
+    /// Export a graph and report it like GraphPrinter
+    template<class GraphType>
+    static void exportGraphToFile(const std::string& filename, GraphExportFile::GraphKind kind,
+                                  GraphType* graph, PointerAnalysis* pta) {
+        SVFUtil::outs() << "Writing '" << filename << "'...";
+        if (exportGraph(filename, kind, graph, pta))
+            SVFUtil::outs() << "\n";
+        else
+            SVFUtil::outs() << "  error writing file!\n";
+    }
+
+    /// Whether points-to sets are exported
+    static bool exportPts();
+};
+
+#endif /* GRAPHEXPORTER_H_ */
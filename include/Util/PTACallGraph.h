@@ -222,6 +222,10 @@ protected:
     void destroy();
 
 public:
+    /// Add the edges of the direct callsites of a function, for functions built on the fly
+    /// when only reachable functions are built (-reachable-funs)
+    virtual void addDirectCallEdges(const Function* fun);
+
     /// Constructor
     PTACallGraph(SVFModule svfModule, CGEK k = NormCallGraph);
 
@@ -32,9 +32,11 @@
 
 #include "Util/SVFUtil.h"
 #include "Util/BasicTypes.h"
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -156,4 +158,84 @@ private:
     std::string moduleName;
 };
 
+/*!
+ * Hierarchical phase profiler.
+ * Phases are timed by Scope objects and may nest. When -trace-phases=<file> is given,
+ * every phase is written as a Chrome Trace Event (chrome://tracing, Perfetto), and when
+ * -phase-summary=<file> is given, the count, wall-clock time, and the resident memory at
+ * the end of each phase and its growth during the phase are summarised in JSON. Both files
+ * are written at exit. A disabled profiler only checks a flag when a scope is entered, and
+ * callers check isEnabled() before computing the values of counters.
+ */
+class PhaseProfiler {
+public:
+    typedef std::vector<std::pair<const char*, u64_t> > CounterVector;
+
+    /// A phase lasting from the construction to the destruction of this object
+    class Scope {
+    public:
+        Scope(const char* n): name(n), active(PhaseProfiler::isEnabled()), start(0), rss(0) {
+            if (active)
+                PhaseProfiler::beginPhase(*this);
+        }
+        ~Scope() {
+            if (active)
+                PhaseProfiler::endPhase(*this);
+        }
+        /// Attach a counter to this phase, shown as an argument of its trace event
+        inline void addCounter(const char* counter, u64_t value) {
+            if (active)
+                counters.push_back(std::make_pair(counter, value));
+        }
+    private:
+        friend class PhaseProfiler;
+        const char* name;
+        bool active;
+        u64_t start;		///< start time in microseconds
+        u64_t rss;			///< RSS in KB when the phase started
+        CounterVector counters;
+    };
+
+    /// Whether any output of the profiler is requested, the options are checked once
+    /// even if the first calls are made by several threads
+    static inline bool isEnabled() {
+        State s = state.load(std::memory_order_acquire);
+        if (s == Unknown)
+            s = initialize();
+        return s == Enabled;
+    }
+
+    /// Enable the profiler without writing any file, e.g. to read its summary in a driver
+    static void enable();
+
+    /// Record the value of a counter at this time, drawn as a track of the trace
+    static void counter(const char* name, u64_t value);
+
+    /// Write the trace and the summary (done at exit)
+    static void flush();
+
+    /// Print the summary of the phases finished so far as a JSON object
+    static void printSummary(std::ostream& out);
+
+    /// Number of finished phases of a name
+    static u32_t getNumOfPhases(const char* name);
+
+    /// Peak resident set size of the process in KB
+    static u64_t getPeakRSS();
+
+    /// Current resident set size of the process in KB, 0 if it is unknown
+    static u64_t getCurrentRSS();
+
+private:
+    enum State {
+        Unknown, Enabled, Disabled
+    };
+
+    static State initialize();
+    static void beginPhase(Scope& scope);
+    static void endPhase(Scope& scope);
+
+    static std::atomic<State> state;
+};
+
 #endif /* ANDERSENSTAT_H_ */
@@ -0,0 +1,128 @@
+//===- ParallelUtil.h -- Helpers for multi-threaded analyses------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * ParallelUtil.h
+ *
+ *  Thread helpers shared by the parallel solvers.
+ *  Work is always handed out by index so that callers can write their
+ *  results into per-index slots and merge them afterwards in a fixed order,
+ *  which keeps the analysis results independent of thread scheduling.
+ */
+
+#ifndef PARALLELUTIL_H_
+#define PARALLELUTIL_H_
+
+#include "Util/BasicTypes.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SVFUtil {
+
+/// Number of hardware threads, at least one
+inline u32_t getNumOfHardwareThreads() {
+    u32_t num = std::thread::hardware_concurrency();
+    return num == 0 ? 1 : num;
+}
+
+/// Resolve a user specified thread number (0 means all hardware threads)
+inline u32_t getNumOfWorkerThreads(u32_t requested) {
+    return requested == 0 ? getNumOfHardwareThreads() : requested;
+}
+
+/*!
+ * Run fn(idx, tid) for every idx in [0, num) using at most numOfThreads threads.
+ * Indices are fetched in chunks of grainSize from a shared counter.
+ * The calling thread acts as worker 0, so no thread is spawned when there is
+ * a single worker or too little work to share.
+ */
+template<typename Fn>
+void parallelFor(u32_t num, u32_t numOfThreads, Fn fn, u32_t grainSize = 16) {
+    if (num == 0)
+        return;
+    if (grainSize == 0)
+        grainSize = 1;
+    u32_t maxWorkers = (num + grainSize - 1) / grainSize;
+    u32_t workers = numOfThreads < maxWorkers ? numOfThreads : maxWorkers;
+    if (workers <= 1) {
+        for (u32_t idx = 0; idx < num; ++idx)
+            fn(idx, 0);
+        return;
+    }
+
+    std::atomic<u32_t> next(0);
+    auto worker = [&](u32_t tid) {
+        while (true) {
+            u32_t begin = next.fetch_add(grainSize);
+            if (begin >= num)
+                break;
+            u32_t end = (num - begin) < grainSize ? num : begin + grainSize;
+            for (u32_t idx = begin; idx < end; ++idx)
+                fn(idx, tid);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (u32_t tid = 1; tid < workers; ++tid)
+        threads.push_back(std::thread(worker, tid));
+    worker(0);
+    for (std::thread& t : threads)
+        t.join();
+}
+
+/*!
+ * Per-thread work counters. Each counter is padded to a cache line, so
+ * threads updating their own counters do not invalidate each other's lines.
+ */
+class ThreadCounters {
+public:
+    static const u32_t cacheLineSize = 64;
+
+    inline void assign(u32_t numOfThreads, u64_t val) {
+        counters.assign(numOfThreads, Counter());
+        for (Counter& c : counters)
+            c.val = val;
+    }
+    inline u64_t& operator[](u32_t tid) {
+        return counters[tid].val;
+    }
+    inline u64_t operator[](u32_t tid) const {
+        return counters[tid].val;
+    }
+    inline u32_t size() const {
+        return counters.size();
+    }
+
+private:
+    struct Counter {
+        u64_t val;
+        char pad[cacheLineSize - sizeof(u64_t)];
+    };
+    std::vector<Counter> counters;
+};
+
+} // End namespace SVFUtil
+
+#endif /* PARALLELUTIL_H_ */
@@ -53,8 +53,8 @@ public:
     typedef FIFOWorkList<const BasicBlock*> CFWorkList;	///< worklist for control-flow guard computation
 
     /// Constructor
-    PathCondAllocator() {
-        getBddCondManager();
+    PathCondAllocator(): curEvalVal(NULL), master(NULL), cfInfoComplete(false) {
+        condMgr = getBddCondManager();
     }
     /// Destructor
     virtual ~PathCondAllocator() {
@@ -84,6 +84,16 @@ public:
     /// Perform path allocation
     void allocate(const SVFModule module);
 
+    /// Create an allocator computing guards concurrently with this one and other workers.
+    /// It has its own BDD manager holding copies of the branch conditions, and shares the
+    /// control-flow information of this allocator, which is computed for all functions here
+    PathCondAllocator* createWorker(const SVFModule module);
+
+    /// Copy a condition of another allocator into the BDD manager of this one
+    inline Condition* transferCond(Condition* cond, const PathCondAllocator* from) {
+        return condMgr->transfer(cond, from->condMgr);
+    }
+
     /// Get llvm conditional expression
     inline const Instruction* getCondInst(const Condition* cond) const {
         CondToTermInstMap::const_iterator it = condToInstMap.find(cond);
@@ -93,54 +103,54 @@ public:
 
     /// Get dominators
     inline DominatorTree* getDT(const Function* fun) {
-        return cfInfoBuilder.getDT(fun);
+        return master ? master->getDT(fun) : cfInfoBuilder.getDT(fun);
     }
     /// Get Postdominators
     inline PostDominatorTree* getPostDT(const Function* fun) {
-        return cfInfoBuilder.getPostDT(fun);
+        return master ? master->getPostDT(fun) : cfInfoBuilder.getPostDT(fun);
     }
     /// Get LoopInfo
     PTALoopInfo* getLoopInfo(const Function* f) {
-        return cfInfoBuilder.getLoopInfo(f);
+        return master ? master->getLoopInfo(f) : cfInfoBuilder.getLoopInfo(f);
     }
 
     /// Condition operations
     //@{
     inline Condition* condAnd(Condition* lhs, Condition* rhs) {
-        return bddCondMgr->AND(lhs,rhs);
+        return condMgr->AND(lhs,rhs);
     }
     inline Condition* condOr(Condition* lhs, Condition* rhs) {
-        return bddCondMgr->OR(lhs,rhs);
+        return condMgr->OR(lhs,rhs);
     }
     inline Condition* condNeg(Condition* cond) {
-        return bddCondMgr->NEG(cond);
+        return condMgr->NEG(cond);
     }
     inline Condition* getTrueCond() const {
-        return bddCondMgr->getTrueCond();
+        return condMgr->getTrueCond();
     }
     inline Condition* getFalseCond() const {
-        return bddCondMgr->getFalseCond();
+        return condMgr->getFalseCond();
     }
     /// Given an index, get its condition
     inline Condition* getCond(u32_t i) const {
-        return bddCondMgr->getCond(i);
+        return condMgr->getCond(i);
     }
     /// Iterator every element of the bdd
     inline NodeBS exactCondElem(Condition* cond) {
         NodeBS elems;
-        bddCondMgr->BddSupport(cond,elems);
+        condMgr->BddSupport(cond,elems);
         return elems;
     }
     /// Decrease reference counting for the bdd
     inline void markForRelease(Condition* cond) {
-        bddCondMgr->markForRelease(cond);
+        condMgr->markForRelease(cond);
     }
     /// Print debug information for this condition
     inline void printDbg(Condition* cond) {
-        bddCondMgr->printDbg(cond);
+        condMgr->printDbg(cond);
     }
     inline std::string dumpCond(Condition* cond) const {
-        return bddCondMgr->dumpStr(cond);
+        return condMgr->dumpStr(cond);
     }
     //@}
 
@@ -171,6 +181,8 @@ public:
     void printPathCond();
 
 private:
+    /// Constructor of a worker of m
+    PathCondAllocator(PathCondAllocator* m);
 
     /// Allocate path condition for every basic block
     virtual void allocateForBB(const BasicBlock& bb);
@@ -240,15 +252,17 @@ private:
 
     /// Allocate a new condition
     inline Condition* newCond(const Instruction* inst) {
-        Condition* cond = bddCondMgr->createNewCond(totalCondNum++);
+        Condition* cond = condMgr->createNewCond(totalCondNum++);
         assert(condToInstMap.find(cond)==condToInstMap.end() && "this should be a fresh condition");
         condToInstMap[cond] = inst;
         return cond;
     }
     /// Used internally, not supposed to be exposed to other classes
     static BddCondManager* getBddCondManager() {
-        if(bddCondMgr==NULL)
+        if(bddCondMgr==NULL) {
             bddCondMgr = new BddCondManager();
+            bddCondMgr->enableReordering();
+        }
         return bddCondMgr;
     }
 
@@ -260,6 +274,9 @@ private:
     FunToExitBBsMap funToExitBBsMap;		///< map a function to all its basic blocks calling program exit
     BBToCondMap bbToCondMap;				///< map a basic block to its path condition starting from root
     const Value* curEvalVal;			///< current llvm value to evaluate branch condition when computing guards
+    BddCondManager* condMgr;				///< bdd manager of this allocator, bddCondMgr unless it is a worker
+    PathCondAllocator* master;				///< allocator this worker is created from
+    bool cfInfoComplete;					///< whether control-flow information of all functions is computed
 
 protected:
     static BddCondManager* bddCondMgr;		///< bbd manager
@@ -38,9 +38,9 @@ public:
     typedef std::vector<GlobalVariable*> GlobalSetType;
     typedef std::vector<GlobalAlias*> AliasSetType;
 
-    typedef std::map<const Function*, Function*> FunDeclToDefMapTy;
-    typedef std::map<const Function*, FunctionSetType> FunDefToDeclsMapTy;
-    typedef std::map<const GlobalVariable*, GlobalVariable*> GlobalDefToRepMapTy;
+    typedef llvm::DenseMap<const Function*, Function*> FunDeclToDefMapTy;
+    typedef llvm::DenseMap<const Function*, FunctionSetType> FunDefToDeclsMapTy;
+    typedef llvm::DenseMap<const GlobalVariable*, GlobalVariable*> GlobalDefToRepMapTy;
 
     /// Iterators type def
     typedef FunctionSetType::iterator iterator;
@@ -52,7 +52,7 @@ public:
 
 private:
     u32_t moduleNum;
-    LLVMContext *cxts;
+    LLVMContext *cxts;	///< one shared context, or one context per module if loaded in parallel
     std::unique_ptr<Module> *modules;
 
     FunctionSetType FunctionSet;  ///< The Functions in the module
@@ -176,6 +176,7 @@ public:
 
 private:
     void loadModules(const std::vector<std::string> &moduleNameVec);
+    void loadModulesInParallel(const std::vector<std::string> &moduleNameVec, u32_t numOfThreads);
     void addSVFMain();
     void initialize();
     void buildFunToFunMap();
@@ -318,6 +318,10 @@ private:
     /// Start building Thread Call graph
     virtual void build(SVFModule svfModule);
 
+    /// Add direct call, fork and parallel for edges and join sites of a function
+    virtual void addDirectCallEdges(const Function* fun);
+    void addThreadCallEdges(const Function* fun);
+
     /// Add fork sites which directly or indirectly create a thread
     //@{
     inline bool addForksite(const Instruction* csInst) {
@@ -196,6 +196,9 @@ public:
         assert(it!=PAGNodeToFormalParmMap.end() && "formal parameter VFG node can not be found??");
         return it->second;
     }
+    inline bool hasFormalRetVFGNode(const PAGNode* fret) const {
+        return PAGNodeToFormalRetMap.find(fret) != PAGNodeToFormalRetMap.end();
+    }
     inline FormalRetVFGNode* getFormalRetVFGNode(const PAGNode* fret) const {
         PAGNodeToFormalRetMapTy::const_iterator it = PAGNodeToFormalRetMap.find(fret);
         assert(it!=PAGNodeToFormalRetMap.end() && "formal return VFG node can not be found??");
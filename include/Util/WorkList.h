@@ -38,9 +38,13 @@
 
 #include <assert.h>
 #include <cstdlib>
+#include <algorithm>
+#include <functional>
 #include <vector>
 #include <deque>
 #include <set>
+#include <queue>
+#include <utility>
 
 /**
  * Worklist with "first come first go" order.
@@ -233,5 +237,272 @@ private:
 };
 
 
+/**
+ * Membership bitmap for dense integer IDs (e.g., NodeID).
+ * It grows on demand, so memory is O(max ID) bits and no allocation
+ * is needed once the largest ID has been seen.
+ */
+class DenseIDBits {
+    typedef unsigned long long Word;
+    typedef std::vector<Word> WordVector;
+    static const unsigned WordBits = sizeof(Word) * 8;
+public:
+    DenseIDBits() {}
+
+    ~DenseIDBits() {}
+
+    inline bool test(unsigned id) const {
+        unsigned w = id / WordBits;
+        return w < words.size() && (words[w] & (Word(1) << (id % WordBits)));
+    }
+
+    inline void set(unsigned id) {
+        unsigned w = id / WordBits;
+        if (w >= words.size())
+            words.resize(w + 1 > words.size() * 2 ? w + 1 : words.size() * 2, 0);
+        words[w] |= (Word(1) << (id % WordBits));
+    }
+
+    inline void reset(unsigned id) {
+        unsigned w = id / WordBits;
+        if (w < words.size())
+            words[w] &= ~(Word(1) << (id % WordBits));
+    }
+
+    inline void clear() {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+private:
+    WordVector words;
+};
+
+/**
+ * Worklist with "first in first out" order for dense integer IDs.
+ * Membership is recorded by a bitmap and elements are kept in a ring buffer
+ * whose capacity doubles when full, so push and pop are O(1) and allocation free
+ * in the steady state.
+ */
+class DenseFIFOWorkList {
+    typedef std::vector<unsigned> DataRing;
+public:
+    DenseFIFOWorkList(): head(0), num(0), ring(16) {}
+
+    ~DenseFIFOWorkList() {}
+
+    inline bool empty() const {
+        return num == 0;
+    }
+
+    inline bool find(unsigned data) const {
+        return data_bits.test(data);
+    }
+
+    inline unsigned size() const {
+        return num;
+    }
+
+    /**
+     * Push a data into the work list.
+     */
+    inline bool push(unsigned data) {
+        if (data_bits.test(data))
+            return false;
+        data_bits.set(data);
+        if (num == ring.size())
+            grow();
+        ring[(head + num) & (ring.size() - 1)] = data;
+        num++;
+        return true;
+    }
+
+    /**
+     * Pop a data from the FRONT of work list.
+     */
+    inline unsigned pop() {
+        assert(!empty() && "work list is empty");
+        unsigned data = ring[head];
+        head = (head + 1) & (ring.size() - 1);
+        num--;
+        data_bits.reset(data);
+        return data;
+    }
+
+    /*!
+     * Clear all the data, the capacity is kept for reuse
+     */
+    inline void clear() {
+        while (!empty())
+            pop();
+        head = 0;
+    }
+
+private:
+    /// Double the ring capacity (always a power of two), unwrapping the elements
+    void grow() {
+        DataRing newRing(ring.size() * 2);
+        for (unsigned i = 0; i < num; ++i)
+            newRing[i] = ring[(head + i) & (ring.size() - 1)];
+        ring.swap(newRing);
+        head = 0;
+    }
+
+    unsigned head;	///< index of the first element in the ring
+    unsigned num;	///< number of elements in the ring
+    DataRing ring;	///< work list using a ring buffer.
+    DenseIDBits data_bits;	///< store all data in the work list.
+};
+
+/**
+ * Worklist with "first in last out" order for dense integer IDs.
+ * Membership is recorded by a bitmap instead of std::set.
+ */
+class DenseFILOWorkList {
+    typedef std::vector<unsigned> DataVector;
+public:
+    DenseFILOWorkList() {}
+
+    ~DenseFILOWorkList() {}
+
+    inline bool empty() const {
+        return data_list.empty();
+    }
+
+    inline bool find(unsigned data) const {
+        return data_bits.test(data);
+    }
+
+    inline unsigned size() const {
+        return data_list.size();
+    }
+
+    /**
+     * Push a data into the work list.
+     */
+    inline bool push(unsigned data) {
+        if (data_bits.test(data))
+            return false;
+        data_bits.set(data);
+        data_list.push_back(data);
+        return true;
+    }
+
+    /**
+     * Pop a data from the END of work list.
+     */
+    inline unsigned pop() {
+        assert(!empty() && "work list is empty");
+        unsigned data = data_list.back();
+        data_list.pop_back();
+        data_bits.reset(data);
+        return data;
+    }
+
+    /*!
+     * Clear all the data, the capacity is kept for reuse
+     */
+    inline void clear() {
+        while (!empty())
+            pop();
+    }
+
+private:
+    DataVector data_list;	///< work list using std::vector.
+    DenseIDBits data_bits;	///< store all data in the work list.
+};
+
+/**
+ * Worklist for dense integer IDs which always pops the element with the
+ * smallest priority (e.g., a topological order number), ties broken by ID.
+ * An element is stored once; pushing it again with a smaller priority
+ * moves it forward, a larger priority is ignored.
+ */
+class DensePriorityWorkList {
+    typedef std::pair<unsigned, unsigned> PrioData;	///< (priority, data)
+    typedef std::priority_queue<PrioData, std::vector<PrioData>, std::greater<PrioData> > PrioQueue;
+public:
+    DensePriorityWorkList(): num(0) {}
+
+    ~DensePriorityWorkList() {}
+
+    inline bool empty() const {
+        return num == 0;
+    }
+
+    inline bool find(unsigned data) const {
+        return data_bits.test(data);
+    }
+
+    inline unsigned size() const {
+        return num;
+    }
+
+    /**
+     * Push a data with its priority into the work list.
+     */
+    inline bool push(unsigned data, unsigned priority) {
+        if (data_bits.test(data)) {
+            if (priority >= data_prio[data])
+                return false;
+            /// the old queue entry becomes stale and is skipped by pop()
+            data_prio[data] = priority;
+            queue.push(PrioData(priority, data));
+            return false;
+        }
+        data_bits.set(data);
+        if (data >= data_prio.size())
+            data_prio.resize(data + 1 > data_prio.size() * 2 ? data + 1 : data_prio.size() * 2);
+        data_prio[data] = priority;
+        queue.push(PrioData(priority, data));
+        num++;
+        return true;
+    }
+
+    /**
+     * Pop the data with the smallest priority.
+     */
+    inline unsigned pop() {
+        assert(!empty() && "work list is empty");
+        while (true) {
+            PrioData top = queue.top();
+            queue.pop();
+            unsigned data = top.second;
+            if (data_bits.test(data) && data_prio[data] == top.first) {
+                data_bits.reset(data);
+                num--;
+                return data;
+            }
+        }
+    }
+
+    /*!
+     * Clear all the data
+     */
+    inline void clear() {
+        while (!empty())
+            pop();
+        queue = PrioQueue();
+    }
+
+private:
+    unsigned num;	///< number of (non-stale) elements
+    PrioQueue queue;	///< work list using a binary heap.
+    std::vector<unsigned> data_prio;	///< current priority of each element in the list.
+    DenseIDBits data_bits;	///< store all data in the work list.
+};
+
+/**
+ * Dense integer IDs (NodeID, EdgeID, etc. are all unsigned) use the bitmap
+ * based worklists, so solvers pick them up without changing their typedefs.
+ */
+//@{
+template<>
+class FIFOWorkList<unsigned> : public DenseFIFOWorkList {
+};
+
+template<>
+class FILOWorkList<unsigned> : public DenseFILOWorkList {
+};
+//@}
 
 #endif /* WORKLIST_H_ */
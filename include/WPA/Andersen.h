@@ -36,6 +36,8 @@
 #include "MemoryModel/PAG.h"
 #include "MemoryModel/ConsG.h"
 #include "MemoryModel/OfflineConsG.h"
+#include "Util/GraphExporter.h"
+#include "Util/ParallelUtil.h"
 
 class PTAType;
 class SVFModule;
@@ -72,6 +74,8 @@ public:
     static double timeOfProcessCopyGep;
     static double timeOfProcessLoadStore;
     static double timeOfUpdateCallGraph;
+    static Size_t numOfIncAffectedNodes;
+    static double timeOfIncUpdate;
     //@}
 
     /// Constructor
@@ -100,6 +104,7 @@ public:
         /// dump constraint graph if PAGDotGraph flag is enabled
         consCG->dump("consCG_final");
         consCG->print();
+        GraphExporter::exportConsG(consCG, this);
         /// sanitize field insensitive obj
         /// TODO: Fields has been collapsed during Andersen::collapseField().
         //	sanitizePts();
@@ -127,6 +132,7 @@ public:
                 || pta->getAnalysisTy() == AndersenHLCD_WPA
                 || pta->getAnalysisTy() == AndersenWaveDiff_WPA
                 || pta->getAnalysisTy() == AndersenWaveDiffWithType_WPA
+                || pta->getAnalysisTy() == AndersenWaveDiffPar_WPA
                 || pta->getAnalysisTy() == AndersenSCD_WPA
                 || pta->getAnalysisTy() == AndersenSFR_WPA);
     }
@@ -144,7 +150,7 @@ public:
 
     /// Operation of points-to set
     virtual inline PointsTo& getPts(NodeID id) {
-        return getPTDataTy()->getPts(sccRepNode(id));
+        return BVDataPTAImpl::getPts(sccRepNode(id));
     }
     virtual inline bool unionPts(NodeID id, const PointsTo& target) {
         id = sccRepNode(id);
@@ -161,6 +167,24 @@ public:
         return consCG;
     }
 
+    /// Incremental solving.
+    /// A change is a constraint edge added to or removed from the program,
+    /// the offset is used by normal gep edges only.
+    //@{
+    struct ConstraintChange {
+        ConstraintEdge::ConstraintEdgeK kind;
+        NodeID src;
+        NodeID dst;
+        Size_t offset;
+    };
+    typedef std::vector<ConstraintChange> ConstraintChanges;
+
+    /// Update a solved analysis for the added and removed constraint edges
+    void updateSolution(const ConstraintChanges& added, const ConstraintChanges& removed);
+    /// Read changes from a text file, one "+|- kind src dst [offset]" per line
+    static bool readConstraintChanges(const std::string& filename, ConstraintChanges& added, ConstraintChanges& removed);
+    //@}
+
     void dumpTopLevelPtsTo();
 
     void setPWCOpt(bool flag) {
@@ -221,6 +245,16 @@ protected:
     /// Override WPASolver function in order to use the default solver
     virtual void processNode(NodeID nodeId);
 
+    /// Spill cold points-to sets if the memory budget is exceeded, called before
+    /// processing a node as no points-to set is referenced at that point
+    //@{
+    inline void checkPtsMemBudget(NodeID nodeId) {
+        if (isPtsSpillDue())
+            spillColdPts(nodeId);
+    }
+    void spillColdPts(NodeID nodeId);
+    //@}
+
     /// handling various constraints
     //@{
     void processAllAddr();
@@ -244,6 +278,23 @@ protected:
         return false;
     }
 
+    /// Incremental solving helpers
+    //@{
+    typedef std::vector<NodePair> NodePairVec;
+    /// Re-create the copy edges of loads and stores, which are not stored in result files
+    void rederiveLoadStoreEdges();
+    /// Remove a constraint edge, its target nodes and the copy edges it derived are collected
+    void removeConstraint(const ConstraintChange& change, NodeBS& seeds, NodePairVec& derivedEdges);
+    /// Add a constraint edge and propagate points-to along it
+    void addConstraint(const ConstraintChange& change);
+    /// Collect the copy edges derived by the loads and stores of a pointer
+    void collectDerivedEdges(NodeID ptr, NodePairVec& derivedEdges);
+    /// Whether a copy edge is still derived by some load or store
+    bool isDerivedByLoadStore(NodeID src, NodeID dst);
+    /// Solve the worklist without a whole-graph pass
+    void solveIncrementally();
+    //@}
+
     /// Update call graph for the input indirect callsites
     virtual bool updateCallGraph(const CallSiteToFunPtrMap& callsites);
 
@@ -255,6 +306,13 @@ protected:
 	/// Connect formal and actual parameters for indirect callsites
     void connectCaller2CalleeParams(CallSite cs, const Function *F, NodePairSet& cpySrcNodes);
 
+    /// Build the callees reached for the first time and add their constraints,
+    /// if only reachable functions are built (-reachable-funs)
+    //@{
+    void buildReachedCallees(const CallEdgeMap& newEdges);
+    void addReachedPTAEdge(const PAGEdge* edge);
+    //@}
+
 	/// dump statistics
     inline void printStat() {
         PointerAnalysis::dumpStat();
@@ -347,6 +405,7 @@ public:
     }
 
     virtual void solveWorklist();
+    virtual void propagateWave(NodeStack& nodeStack);
     virtual void processNode(NodeID nodeId);
     virtual void postProcessNode(NodeID nodeId);
     virtual void handleCopyGep(ConstraintNode* node);
@@ -453,6 +512,83 @@ protected:
 
 
 
+/**
+ * Wave propagation with diff points-to set, where the copy propagation of
+ * nodes at the same wave level (no direct edge between them) runs in parallel.
+ * Gep edges, field collapsing and load/store edge additions are applied
+ * sequentially in a fixed order, so the results are identical to AndersenWaveDiff.
+ */
+class AndersenWaveDiffPar : public AndersenWaveDiff {
+
+public:
+    typedef std::vector<NodeVector> WaveLevels;
+    typedef SVFUtil::ThreadCounters ThreadWork;
+
+    /// Statistics
+    //@{
+    static double timeOfWaveLevels;	/// Time of computing wave levels
+    static double timeOfParDiff;	/// Time of computing diff points-to in parallel
+    static double timeOfParCopy;	/// Time of copy propagation in parallel
+    static double timeOfMergeCopy;	/// Time of merging reverse points-to and worklist
+    static double timeOfSeqGep;		/// Time of sequential gep processing
+    static Size_t numOfWaveLevels;
+    static Size_t maxWaveWidth;
+    static ThreadWork threadProcessedNodes;	/// Nodes handled by each thread
+    static ThreadWork threadProcessedCopys;	/// Copy edges handled by each thread
+    //@}
+
+private:
+    static AndersenWaveDiffPar* parDiffWave; // static instance
+
+    u32_t numOfThreads;
+
+public:
+    AndersenWaveDiffPar(PTATY type = AndersenWaveDiffPar_WPA);
+
+    /// Create an singleton instance directly instead of invoking llvm pass manager
+    static AndersenWaveDiffPar* createAndersenWaveDiffPar(SVFModule svfModule) {
+        if(parDiffWave==NULL) {
+            parDiffWave = new AndersenWaveDiffPar();
+            parDiffWave->analyze(svfModule);
+            return parDiffWave;
+        }
+        return parDiffWave;
+    }
+    static void releaseAndersenWaveDiffPar() {
+        if (parDiffWave)
+            delete parDiffWave;
+        parDiffWave = NULL;
+    }
+
+    /// Methods for support type inquiry through isa, cast, and dyn_cast:
+    //@{
+    static inline bool classof(const AndersenWaveDiffPar *) {
+        return true;
+    }
+    static inline bool classof(const PointerAnalysis *pta) {
+        return pta->getAnalysisTy() == AndersenWaveDiffPar_WPA;
+    }
+    //@}
+
+    /// Number of worker threads
+    inline u32_t getNumOfThreads() const {
+        return numOfThreads;
+    }
+
+    virtual void propagateWave(NodeStack& nodeStack);
+
+protected:
+    /// Group the topologically ordered nodes into levels without direct edges inside a level
+    void computeWaveLevels(NodeStack& nodeStack, WaveLevels& levels);
+    /// Propagate diff points-to along copy/gep edges for all nodes of a level
+    void processWaveLevel(const NodeVector& level);
+
+    /// Get PTA name
+    virtual const std::string PTAName() const {
+        return "AndersenWaveDiffPar";
+    }
+};
+
 /*
  * Lazy Cycle Detection Based Andersen Analysis
  */
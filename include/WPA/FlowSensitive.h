@@ -33,6 +33,7 @@
 #include "MSSA/SVFGOPT.h"
 #include "MSSA/SVFGBuilder.h"
 #include "WPA/WPAFSSolver.h"
+#include "Util/ParallelUtil.h"
 class AndersenWaveDiff;
 class SVFModule;
 
@@ -47,7 +48,7 @@ private:
 
 public:
     typedef BVDataPTAImpl::IncDFPTDataTy::DFPtsMap DFInOutMap;
-    typedef BVDataPTAImpl::IncDFPTDataTy::PtsMap PtsMap;
+    typedef BVDataPTAImpl::IncDFPTDataTy::LocPtsMap PtsMap;
 
     /// Constructor
     FlowSensitive(PTATY type = FSSPARSE_WPA) : WPASVFGFSSolver(), BVDataPTAImpl(type)
@@ -112,7 +113,8 @@ public:
         return true;
     }
     static inline bool classof(const PointerAnalysis *pta) {
-        return pta->getAnalysisTy() == FSSPARSE_WPA;
+        return (pta->getAnalysisTy() == FSSPARSE_WPA
+                || pta->getAnalysisTy() == FSSPARSEPar_WPA);
     }
     //@}
 
@@ -238,6 +240,7 @@ private:
     static FlowSensitive* fspta;
     SVFGBuilder memSSA;
 
+protected:
     /// Statistics.
     //@{
     Size_t numOfProcessedAddr;	/// Number of processed Addr node
@@ -272,4 +275,139 @@ private:
 
 };
 
+
+/*!
+ * Parallel sparse flow-sensitive pointer analysis.
+ *
+ * The SVFG nodes are grouped into levels following the topological order of its SCCs,
+ * so that an edge either connects two levels forward or stays inside one SCC.
+ * The pending nodes of a level are solved in rounds until none is left, and each round
+ *  1. computes the new points-to of load and store nodes in parallel,
+ *  2. commits them and processes all other nodes sequentially in a fixed order,
+ *  3. computes the new IN sets of the destinations of indirect edges in parallel,
+ *     grouped by destination,
+ *  4. commits the IN sets sequentially in a fixed order.
+ * Workers only read the points-to data (all sets they touch are resolved beforehand),
+ * so the PointsToTable is never accessed concurrently. Every update is a monotone union
+ * which marks its users pending, and strong updates are still only applied to stores whose
+ * pointer has exactly one target, hence the results are identical to FlowSensitive.
+ */
+class FlowSensitivePar : public FlowSensitive {
+
+public:
+    typedef std::vector<NodeVector> SVFGLevels;
+    typedef SVFUtil::ThreadCounters ThreadWork;
+    typedef std::pair<NodeID, PointsTo> VarPts;
+    typedef std::vector<VarPts> VarPtsVector;
+
+    /// Statistics
+    //@{
+    static double timeOfLevels;	/// Time of computing SVFG levels
+    static double timeOfParProcess;	/// Time of processing load/store nodes in parallel
+    static double timeOfSeqProcess;	/// Time of committing load/store nodes and processing other nodes
+    static double timeOfParPropagation;	/// Time of indirect propagation in parallel
+    static double timeOfMergePropagation;	/// Time of committing propagated IN sets
+    static Size_t numOfLevels;
+    static Size_t numOfRounds;
+    static Size_t maxRoundWidth;
+    static ThreadWork threadProcessedNodes;	/// Load/store nodes handled by each thread
+    static ThreadWork threadPropagatedNodes;	/// Destination nodes handled by each thread
+    //@}
+
+private:
+    /// A load or store node solved by a worker
+    struct LoadStoreWork {
+        const SVFGNode* node;
+        const PointsTo* srcPts;	///< points-to of the PAG src pointer
+        const PointsTo* dstPts;	///< points-to of the PAG dst pointer
+        bool isSU;	///< whether the store is a strong update
+        NodeID singleton;	///< the target killed by a strong update
+        NodeVector consumedVars;	///< variables whose IN sets have been propagated
+        PointsTo loadPts;	///< new points-to of the pointer defined by a load
+        VarPtsVector outPts;	///< new points-to of the OUT set of a store
+    };
+    /// The indirect edges into a destination node solved by a worker
+    struct PropagationWork {
+        NodeID dst;
+        std::vector<const IndirectSVFGEdge*> edges;
+        VarPtsVector inPts;	///< new points-to of the IN set of dst
+    };
+
+    static FlowSensitivePar* fsparpta; // static instance
+
+    u32_t numOfThreads;
+    NodeBS pendingNodes;	///< nodes to be solved in the current pass
+
+public:
+    FlowSensitivePar(PTATY type = FSSPARSEPar_WPA);
+
+    /// Create signle instance of parallel flow-sensitive pointer analysis
+    static FlowSensitivePar* createFSParWPA(SVFModule svfModule) {
+        if (fsparpta == NULL) {
+            fsparpta = new FlowSensitivePar();
+            fsparpta->analyze(svfModule);
+        }
+        return fsparpta;
+    }
+
+    /// Release parallel flow-sensitive pointer analysis
+    static void releaseFSParWPA() {
+        if (fsparpta)
+            delete fsparpta;
+        fsparpta = NULL;
+    }
+
+    /// Methods for support type inquiry through isa, cast, and dyn_cast
+    //@{
+    static inline bool classof(const FlowSensitivePar *) {
+        return true;
+    }
+    static inline bool classof(const PointerAnalysis *pta) {
+        return pta->getAnalysisTy() == FSSPARSEPar_WPA;
+    }
+    //@}
+
+    /// Number of worker threads
+    inline u32_t getNumOfThreads() const {
+        return numOfThreads;
+    }
+
+    /// Get PTA name
+    virtual const std::string PTAName() const {
+        return "FlowSensitivePar";
+    }
+
+protected:
+    /// Solve all SVFG nodes level by level
+    virtual void solve();
+
+    /// Nodes pushed by the sequential parts are solved in the current pass
+    virtual inline void pushIntoWorklist(NodeID id) {
+        pendingNodes.set(id);
+    }
+
+    /// Group the topologically ordered nodes into levels, nodes of an SCC share a level
+    void computeLevels(NodeStack& nodeStack, SVFGLevels& levels);
+    /// Solve one round of the pending nodes of a level
+    void processRound(const NodeVector& nodes);
+
+    /// Computation done by the workers, which must not update any points-to data
+    //@{
+    void computeLoad(LoadStoreWork& work);
+    void computeStore(LoadStoreWork& work);
+    void computePropagation(PropagationWork& work);
+    //@}
+
+    /// Commit the results of the workers, return true if the node has changed
+    //@{
+    bool commitLoad(const LoadStoreWork& work);
+    bool commitStore(const LoadStoreWork& work);
+    bool commitPropagation(const PropagationWork& work);
+    //@}
+
+    /// Variables whose points-to is carried by an object, i.e., itself and
+    /// all its fields if it is field-insensitive
+    void getObjVars(NodeID obj, NodeVector& vars);
+};
+
 #endif /* FLOWSENSITIVEANALYSIS_H_ */
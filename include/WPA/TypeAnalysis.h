@@ -53,6 +53,9 @@ public:
     /// Finalize analysis
     virtual inline void finalize();
 
+    /// Build ICFG of the resolved call graph
+    void buildICFG();
+
     /// Resolve callgraph based on CHA
     void callGraphSolveBasedOnCHA(const CallSiteToFunPtrMap& callsites, CallEdgeMap& newEdges);
 
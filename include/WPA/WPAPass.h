@@ -101,6 +101,9 @@ public:
     /// Run pointer analysis on SVFModule
     void runOnModule(SVFModule svfModule);
 
+    /// Create a whole program pointer analysis of a kind, NULL if it is not implemented
+    static PointerAnalysis* createPointerAnalysis(u32_t kind);
+
     /// PTA name
     virtual inline StringRef getPassName() const {
         return "WPAPass";
@@ -32,6 +32,7 @@
 #define GRAPHSOLVER_H_
 
 #include "Util/WorkList.h"
+#include "Util/PTAStat.h"
 
 /*
  * Generic graph solver for whole program pointer analysis
@@ -97,9 +98,16 @@ protected:
 			if (0 == numOfIteration % iterationForPrintStat)
 				printStat();
 
+			PhaseProfiler::Scope phase("solve iteration");
+			if (PhaseProfiler::isEnabled())
+				phase.addCounter("iteration", numOfIteration);
+
 			reanalyze = false;
 
-			solveWorklist();
+			{
+				PhaseProfiler::Scope worklistPhase("solveWorklist");
+				solveWorklist();
+			}
 
 			if (updateCallGraph())
 				reanalyze = true;
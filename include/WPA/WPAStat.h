@@ -72,6 +72,11 @@ public:
     void statNullPtr();
 
     void constraintGraphStat();
+
+    void parallelWaveStat();
+
+private:
+    std::vector<std::string> threadStatNames;	///< keep per-thread stat names alive while printing
 };
 
 /*!
@@ -112,6 +117,10 @@ private:
 
     void statInOutPtsSize(const DFInOutMap& data, ENUM_INOUT inOrOut);
 
+    void parallelStat();
+
+    std::vector<std::string> threadStatNames;	///< keep per-thread stat names alive while printing
+
     u32_t _NumOfNullPtr;
     u32_t _NumOfConstantPtr;
     u32_t _NumOfBlackholePtr;
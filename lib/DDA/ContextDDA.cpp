@@ -8,17 +8,22 @@
 #include "DDA/ContextDDA.h"
 #include "DDA/FlowDDA.h"
 #include "DDA/DDAClient.h"
+#include "Util/AnalysisCache.h"
 
 using namespace SVFUtil;
 
 static llvm::cl::opt<unsigned long long> cxtBudget("cxtbg",  llvm::cl::init(10000),
         llvm::cl::desc("Maximum step budget of context-sensitive traversing"));
+
+static llvm::cl::opt<bool> ddaSummary("dda-summary", llvm::cl::init(false),
+        llvm::cl::desc("Summarise the returns of functions, which are kept in the analysis cache for later runs"));
 /*!
  * Constructor
  */
 ContextDDA::ContextDDA(SVFModule m, DDAClient* client)
     : CondPTAImpl<ContextCond>(PointerAnalysis::Cxt_DDA),DDAVFSolver<CxtVar,CxtPtSet,CxtLocDPItem>(),
-      _client(client) {
+      _client(client), useSummaries(ddaSummary), summaryStore(NULL), summaryFun(NULL), curSummary(NULL),
+      summaryFailed(false) {
     flowDDA = new FlowDDA(m, client);
 }
 
@@ -29,6 +34,14 @@ ContextDDA::~ContextDDA() {
     if(flowDDA)
         delete flowDDA;
     flowDDA = NULL;
+
+    if(summaryStore) {
+        /// summaries built by queries answered after finalize
+        if(AnalysisCache::isEnabled())
+            summaryStore->write(getSummaryPath());
+        delete summaryStore;
+    }
+    summaryStore = NULL;
 }
 
 /*!
@@ -41,6 +54,22 @@ void ContextDDA::initialize(SVFModule module) {
     setCallGraphSCC(getCallGraphSCC());
     stat = setDDAStat(new DDAStat(this));
     flowDDA->initialize(module);
+
+    /// a summary context needs room for summaryCxtID and the call strings in the function
+    if(useSummaries && ContextCond::getMaxCxtLen() > 1) {
+        summaryStore = new DDASummaryStore(module, getSVFG(), getPTACallGraph());
+        if(AnalysisCache::isEnabled())
+            ddaStat->_NumOfSummaryRead = summaryStore->read(getSummaryPath());
+    }
+}
+
+/*!
+ * Finalize analysis
+ */
+void ContextDDA::finalize() {
+    CondPTAImpl<ContextCond>::finalize();
+    if(summaryStore && AnalysisCache::isEnabled())
+        summaryStore->write(getSummaryPath());
 }
 
 /*!
@@ -61,8 +90,10 @@ const CxtPtSet& ContextDDA::computeDDAPts(const CxtVar& var) {
     DOTIMESTAT(ddaStat->_AnaTimePerQuery = DDAStat::getClk() - start);
     DOTIMESTAT(ddaStat->_TotalTimeOfQueries += ddaStat->_AnaTimePerQuery);
 
-    if(isOutOfBudgetQuery() == false)
+    if(isOutOfBudgetQuery() == false) {
         unionPts(var,cpts);
+        sharePointsToOfQuery();
+    }
     else
         handleOutOfBudgetDpm(dpm);
 
@@ -79,6 +110,32 @@ void ContextDDA::computeDDAPts(NodeID id) {
     ContextCond cxt;
     CxtVar var(cxt, id);
     computeDDAPts(var);
+    /// queried after finalize (e.g. by the query server), refresh the normalized points-to
+    if (normalized)
+        NormalizePointsTo();
+}
+
+/*!
+ * Create a solver answering queries concurrently with this one.
+ * It has its own SVFG, call graph and traversal state, and shares the resolved points-to with this one
+ */
+PointerAnalysis* ContextDDA::createDDAWorker() {
+    ContextDDA* worker = new ContextDDA(getModule(), _client);
+    /// summaries are built and stored by this solver only
+    worker->useSummaries = false;
+    worker->initialize(getModule());
+    worker->setSharedCache(shareCache());
+    worker->flowDDA->setSharedCache(flowDDA->shareCache());
+    return worker;
+}
+
+/*!
+ * Copy the points-to of a query answered by a worker
+ */
+void ContextDDA::mergeDDAPts(PointerAnalysis* worker, NodeID id) {
+    ContextCond cxt;
+    CxtVar var(cxt, id);
+    unionPts(var, static_cast<ContextDDA*>(worker)->getPts(var));
 }
 
 /*!
@@ -100,6 +157,173 @@ void ContextDDA::handleOutOfBudgetDpm(const CxtLocDPItem& dpm) {
     addOutOfBudgetDpm(dpm);
 }
 
+/*!
+ * Compute points-to.
+ * Once the summary being built fails, its remaining dpms are not traversed
+ */
+const CxtPtSet& ContextDDA::findPT(const CxtLocDPItem& dpm) {
+    if(summaryFun && isSummaryCxt(dpm.getCond())) {
+        summaryDpms.insert(dpm);
+        if(summaryFailed)
+            return getCachedPointsTo(dpm);
+        if(const BasicBlock* bb = dpm.getLoc()->getBB())
+            curSummary->addFunction(bb->getParent());
+    }
+    return DDAVFSolver<CxtVar,CxtPtSet,CxtLocDPItem>::findPT(dpm);
+}
+
+/*!
+ * dpm transit during backward tracing
+ */
+void ContextDDA::backwardPropDpm(CxtPtSet& pts, NodeID ptr, const CxtLocDPItem& oldDpm, const SVFGEdge* edge) {
+    if(summaryFun && isSummaryCxt(oldDpm.getCond())) {
+        /// the summary fails if its traversal leaves the summarised function, or
+        /// summaryCxtID would be dropped from a full context
+        const ContextCond& cxt = oldDpm.getCond();
+        if((edge->isCallVFGEdge() && cxt.cxtSize() == 1) ||
+                (edge->isRetVFGEdge() && cxt.cxtSize() >= ContextCond::getMaxCxtLen())) {
+            summaryFailed = true;
+            return;
+        }
+    }
+
+    if(SVFUtil::isa<RetDirSVFGEdge>(edge) && applySummary(pts, ptr, oldDpm, edge))
+        return;
+
+    DDAVFSolver<CxtVar,CxtPtSet,CxtLocDPItem>::backwardPropDpm(pts, ptr, oldDpm, edge);
+}
+
+/*!
+ * Add the objects of the summary of a callee's return, with the call strings
+ * of the summary appended to the context of the return edge.
+ * The summary is built on the first return into the callee.
+ */
+bool ContextDDA::applySummary(CxtPtSet& pts, NodeID ptr, const CxtLocDPItem& oldDpm, const SVFGEdge* edge) {
+    if(summaryStore == NULL)
+        return false;
+
+    const SVFGNode* formalRet = edge->getSrcNode();
+    CxtLocDPItem dpm(oldDpm);
+    CallSiteID csId = getCSIDAtRet(dpm, edge);
+    if(csId == 0 || isEdgeInRecursion(csId) || _ander->isInRecursion(formalRet->getBB()->getParent()))
+        return false;
+
+    if(summaryStore->hasSummary(formalRet->getId()) == false && buildSummary(formalRet, ptr) == false)
+        return false;
+
+    dpm.setLocVar(formalRet, ptr);
+    if(handleBKCondition(dpm, edge) == false) {
+        DOSTAT(ddaStat->_NumOfInfeasiblePath++);
+        return true;
+    }
+
+    const DDASummary& summary = summaryStore->getSummary(formalRet->getId());
+    for(DDASummary::LocalObjSet::const_iterator it = summary.getLocalObjs().begin(),
+            eit = summary.getLocalObjs().end(); it != eit; ++it) {
+        ContextCond cxt(dpm.getCond());
+        for(CallStrCxt::const_iterator cit = it->cxt.begin(), ecit = it->cxt.end(); cit != ecit; ++cit)
+            cxt.pushContext(*cit);
+        if(it->concrete == false)
+            cxt.setNonConcreteCxt();
+        NodeID obj = it->obj;
+        if(isFieldInsensitive(obj))
+            obj = getFIObjNode(obj);
+        addDDAPts(pts, CxtVar(cxt, obj));
+    }
+
+    /// the summary being built depends on the functions of the applied one
+    if(curSummary && isSummaryCxt(oldDpm.getCond())) {
+        for(DDASummary::FunctionSet::const_iterator it = summary.getFunctions().begin(),
+                eit = summary.getFunctions().end(); it != eit; ++it)
+            curSummary->addFunction(*it);
+    }
+
+    DBOUT(DDDA, outs() << "\t apply summary of " << formalRet->getBB()->getParent()->getName() << " to dpm ");
+    DBOUT(DDDA, oldDpm.dump());
+    DOSTAT(ddaStat->_NumOfSummaryApplied++);
+    return true;
+}
+
+/*!
+ * Build the summary of a formal-ret by a traversal starting with the context of summaryCxtID.
+ * The objects found have contexts starting with summaryCxtID followed by the call strings
+ * from the function to their allocations.
+ */
+bool ContextDDA::buildSummary(const SVFGNode* formalRet, NodeID ptr) {
+    /// no summary is built while building another one
+    if(summaryFun)
+        return false;
+
+    ContextCond cxt;
+    cxt.pushContext(summaryCxtID);
+    CxtLocDPItem root = getDPIm(CxtVar(cxt, ptr), formalRet);
+
+    DDASummary summary;
+    summaryFun = formalRet->getBB()->getParent();
+    curSummary = &summary;
+    summaryFailed = false;
+
+    /// the summary has a step budget of its own, and running out of it does not
+    /// put the query out of budget, which goes on with its steps afterwards
+    u64_t querySteps = ddaStat->_NumOfStep;
+    bool queryOutOfBudget = outOfBudgetQuery;
+    ddaStat->_NumOfStep = 0;
+    outOfBudgetQuery = false;
+
+    CxtPtSet pts = findPT(root);
+    bool built = (summaryFailed == false && isOutOfBudgetQuery() == false);
+    for(CxtPtSet::iterator it = pts.begin(), eit = pts.end(); built && it != eit; ++it) {
+        const ContextCond& objCxt = it->get_cond();
+        if(isSummaryCxt(objCxt)) {
+            CallStrCxt objCallStr = objCxt.getCallStr();
+            objCallStr.erase(objCallStr.begin());
+            summary.addLocalObj(it->get_id(), objCallStr, objCxt.isConcreteCxt());
+        }
+        else
+            built = false;
+    }
+
+    clearSummaryDpms();
+    summaryFun = NULL;
+    curSummary = NULL;
+    ddaStat->_NumOfStep = querySteps;
+    outOfBudgetQuery = queryOutOfBudget;
+
+    if(built) {
+        summaryStore->addSummary(formalRet->getId(), summary);
+        DOSTAT(ddaStat->_NumOfSummaryBuilt++);
+    }
+    return built;
+}
+
+/*!
+ * dpms with summary contexts are never reached by other traversals,
+ * they are removed so that later summaries are built from scratch
+ */
+void ContextDDA::clearSummaryDpms() {
+    for(DPTItemSet::const_iterator it = summaryDpms.begin(), eit = summaryDpms.end(); it != eit; ++it) {
+        const CxtLocDPItem& dpm = *it;
+        if(isbkVisited(dpm))
+            clearbkVisited(dpm);
+        dpmToTLCPtSetMap.erase(dpm);
+        dpmToADCPtSetMap.erase(dpm);
+        dpmToloadDpmMap.erase(dpm);
+        loadToPTCVarMap.erase(dpm);
+        outOfBudgetDpms.erase(dpm);
+        LocToDPMVecMap::iterator locIt = locToDpmSetMap.find(dpm.getLoc()->getId());
+        if(locIt != locToDpmSetMap.end())
+            locIt->second.erase(dpm);
+    }
+    summaryDpms.clear();
+}
+
+/*!
+ * Summaries are kept across modules, as each of them is checked against its functions when read
+ */
+std::string ContextDDA::getSummaryPath() const {
+    return AnalysisCache::getStorePath("dda-summary", "maxcxt=" + std::to_string(ContextCond::getMaxCxtLen()));
+}
+
 /*!
  * context conditions of local(not in recursion)  and global variables are compatible
  */
@@ -107,13 +331,7 @@ bool ContextDDA::isCondCompatible(const ContextCond& cxt1, const ContextCond& cx
     if(singleton)
         return true;
 
-    int i = cxt1.cxtSize() - 1;
-    int j = cxt2.cxtSize() - 1;
-    for(; i >= 0 && j>=0; i--, j--) {
-        if(cxt1[i] != cxt2[j])
-            return false;
-    }
-    return true;
+    return CallStrCxtTrie::matchSuffix(cxt1.getContexts(), cxt2.getContexts());
 }
 
 /*!
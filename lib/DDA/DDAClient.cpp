@@ -10,6 +10,8 @@
 
 #include "DDA/DDAClient.h"
 #include "DDA/FlowDDA.h"
+#include "MSSA/SVFGBuilder.h"
+#include "Util/ParallelUtil.h"
 #include <iostream>
 #include <iomanip>	// for std::setw
 
@@ -42,10 +44,24 @@ static llvm::cl::opt<bool> TaintUninitHeap("uninit-heap", llvm::cl::init(true),
 static llvm::cl::opt<bool> TaintUninitStack("uninit-stack", llvm::cl::init(true),
                                       llvm::cl::desc("detect uninitialized stack variables"));
 
+static llvm::cl::opt<u32_t> DDAThreads("dda-threads",  llvm::cl::init(1),
+                                 llvm::cl::desc("Number of threads answering DDA queries (0: all hardware threads)"));
+
 void DDAClient::answerQueries(PointerAnalysis* pta) {
 
     collectCandidateQueries(pta->getPAG());
 
+    u32_t numOfThreads = getNumOfWorkerThreads(DDAThreads);
+    /// solvers would traverse the same SVFG, so queries are answered one by one
+    if (numOfThreads > 1 && SVFGBuilder::isSingleVFG()) {
+        errs() << errMsg("-dda-threads is not supported with -singleVFG, queries are answered by one thread") << "\n";
+        numOfThreads = 1;
+    }
+    if (numOfThreads > 1) {
+        answerQueriesConcurrently(pta, numOfThreads);
+        return;
+    }
+
     u32_t count = 0;
     for (NodeSet::iterator nIter = candidateQueries.begin();
             nIter != candidateQueries.end(); ++nIter,++count) {
@@ -61,6 +77,49 @@ void DDAClient::answerQueries(PointerAnalysis* pta) {
     }
 }
 
+/*!
+ * Answer candidate queries concurrently.
+ * Each thread runs its own solver created by pta, with its own SVFG, call graph and
+ * traversal state, while resolved points-to are shared through a cache of the solvers.
+ * Field objects reached by a query are created when the cache is shared with the first
+ * worker, so the PAG is only read. The current query pointer is not set, as it is not
+ * per thread. Solvers need their own SVFGs, so -singleVFG is not supported.
+ */
+void DDAClient::answerQueriesConcurrently(PointerAnalysis* pta, u32_t numOfThreads) {
+
+    std::vector<NodeID> queries;
+    for (NodeSet::iterator nIter = candidateQueries.begin();
+            nIter != candidateQueries.end(); ++nIter) {
+        if(pta->getPAG()->isValidTopLevelPtr(pta->getPAG()->getPAGNode(*nIter)))
+            queries.push_back(*nIter);
+    }
+
+    /// Solvers are created before any query starts, pta itself is the first one
+    std::vector<PointerAnalysis*> workers(1, pta);
+    for (u32_t tid = 1; tid < numOfThreads && tid < queries.size(); ++tid) {
+        PointerAnalysis* worker = pta->createDDAWorker();
+        if (worker == NULL)
+            break;
+        workers.push_back(worker);
+    }
+
+    std::vector<u32_t> answeredBy(queries.size(), 0);
+    parallelFor(queries.size(), workers.size(), [&](u32_t idx, u32_t tid) {
+        DBOUT(DGENERAL,outs() << "\n@@Computing PointsTo for :" << queries[idx] << " \n");
+        workers[tid]->computeDDAPts(queries[idx]);
+        answeredBy[idx] = tid;
+    }, 1);
+
+    /// Copy the points-to of queries answered by the other solvers in the order of queries
+    for (u32_t idx = 0; idx < queries.size(); ++idx) {
+        if (answeredBy[idx] != 0)
+            pta->mergeDDAPts(workers[answeredBy[idx]], queries[idx]);
+    }
+
+    for (u32_t tid = 1; tid < workers.size(); ++tid)
+        delete workers[tid];
+}
+
 void FunptrDDAClient::performStat(PointerAnalysis* pta) {
 
     AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(pta->getModule());
@@ -10,6 +10,10 @@
 #include "DDA/FlowDDA.h"
 #include "DDA/ContextDDA.h"
 #include "DDA/DDAClient.h"
+#include "WPA/Andersen.h"
+#include "MTA/MHP.h"
+#include "Util/AliasQueryServer.h"
+#include <memory>
 #include <sstream>
 #include <limits.h>
 
@@ -74,6 +78,24 @@ bool DDAPass::runOnModule(SVFModule module)
             runPointerAnalysis(module, i);
     }
 
+    /// keep the analysis resident to answer queries, a whole-program analysis
+    /// answers the nodes the demand-driven one does not compute, and mhp queries
+    if (AliasQueryServer::isEnabled()) {
+        AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(module);
+        std::unique_ptr<TCT> tct;
+        std::unique_ptr<MHP> mhp;
+        /// MHP is built at the first mhp query
+        AliasQueryServer server(_pta, ander, [&](const Instruction* i1, const Instruction* i2) {
+            if (mhp == nullptr) {
+                tct.reset(new TCT(ander));
+                mhp.reset(new MHP(tct.get()));
+                mhp->analyze();
+            }
+            return mhp->mayHappenInParallel(i1, i2);
+        });
+        server.run();
+    }
+
     return false;
 }
 
@@ -96,6 +118,10 @@ void DDAPass::selectClient(SVFModule module) {
             }
         }
     }
+    /// queries are sent to the query server instead
+    else if (AliasQueryServer::isEnabled()) {
+        _client = new DDAClient(module);
+    }
     else {
         assert(false && "Please specify query options!");
     }
@@ -132,7 +158,8 @@ void DDAPass::runPointerAnalysis(SVFModule module, u32_t kind)
         ///initialize
         _pta->initialize(module);
         ///compute points-to
-        answerQueries(_pta);
+        if (!userInputQuery.empty())
+            answerQueries(_pta);
         ///finalize
         _pta->finalize();
         if(printCPts)
@@ -49,6 +49,9 @@ void DDAStat::initDefault() {
     _NumOfStrongUpdates = 0;
     _NumOfMustAliases = 0;
     _NumOfInfeasiblePath = 0;
+    _NumOfSummaryBuilt = 0;
+    _NumOfSummaryApplied = 0;
+    _NumOfSummaryRead = 0;
 
     _NumOfStep = 0;
     _NumOfStepInCycle = 0;
@@ -158,7 +161,7 @@ void DDAStat::performStatPerQuery(NodeID ptr) {
     NumPerQueryStatMap["AvgDPMAtLoc"] = avgDPMAtLoc;
     NumPerQueryStatMap["MaxDPMAtLoc"] = maxNumOfDPMPerLoc;
     NumPerQueryStatMap["MaxPathPerQuery"] = VFPathCond::maximumPath;
-    NumPerQueryStatMap["MaxCxtPerQuery"] = ContextCond::maximumCxt;
+    NumPerQueryStatMap["MaxCxtPerQuery"] = ContextCond::maximumCxt.load();
     NumPerQueryStatMap["NumOfMustAA"] = _NumOfMustAliases;
     NumPerQueryStatMap["NumOfInfePath"] = _NumOfInfeasiblePath;
 
@@ -214,7 +217,7 @@ void DDAStat::performStat() {
     timeStatMap["AvgDPMAtLoc"] = (double)_AvgNumOfDPMAtSVFGNode/_TotalNumOfQuery;
     PTNumStatMap["MaxDPMAtLoc"] = _MaxNumOfDPMAtSVFGNode;
     PTNumStatMap["MaxPathPerQuery"] = VFPathCond::maximumPath;
-    PTNumStatMap["MaxCxtPerQuery"] = ContextCond::maximumCxt;
+    PTNumStatMap["MaxCxtPerQuery"] = ContextCond::maximumCxt.load();
     PTNumStatMap["MaxCPtsSize"] = _MaxCPtsSize;
     PTNumStatMap["MaxPtsSize"] = _MaxPtsSize;
     timeStatMap["AvgCPtsSize"] = (double)_TotalCPtsSize/_TotalNumOfQuery;
@@ -225,6 +228,9 @@ void DDAStat::performStat() {
     PTNumStatMap["PointsToBlkPtr"] = _NumOfBlackholePtr;
     PTNumStatMap["NumOfMustAA"] = _TotalNumOfMustAliases;
     PTNumStatMap["NumOfInfePath"] = _TotalNumOfInfeasiblePath;
+    PTNumStatMap["NumOfSumBuilt"] = _NumOfSummaryBuilt;
+    PTNumStatMap["NumOfSumApplied"] = _NumOfSummaryApplied;
+    PTNumStatMap["NumOfSumRead"] = _NumOfSummaryRead;
     PTNumStatMap["NumOfStore"] = PAG::getPAG()->getPTAEdgeSet(PAGEdge::Store).size();
     PTNumStatMap["MemoryUsageVmrss"] = _vmrssUsageAfter - _vmrssUsageBefore;
     PTNumStatMap["MemoryUsageVmsize"] = _vmsizeUsageAfter - _vmsizeUsageBefore;
@@ -0,0 +1,376 @@
+//===- DDASummary.cpp -- Summaries of functions for demand-driven analysis---//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * DDASummary.cpp
+ */
+
+#include "DDA/DDASummary.h"
+#include "Util/AnalysisCache.h"
+#include <fstream>
+#include <sstream>
+
+using namespace SVFUtil;
+
+/// Keys are separated by spaces in the stored summaries
+static inline bool isValidKey(const std::string& key) {
+    return !key.empty() && key.find_first_of(" \t\r\n") == std::string::npos;
+}
+
+/*!
+ * Read the summaries whose traversed functions have the same hashes as when
+ * they were written, and whose objects and call sites are all found.
+ * The others are kept to be written back.
+ */
+u32_t DDASummaryStore::read(const std::string& path) {
+    std::ifstream in(path.c_str());
+    if (!in.is_open())
+        return 0;
+
+    u32_t num = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream head(line);
+        std::string tag, funKey;
+        if (!(head >> tag >> funKey) || tag != "summary")
+            continue;
+
+        const Function* fun = module.getFunction(funKey);
+        PAG* pag = svfg->getPAG();
+        bool valid = fun && !fun->isDeclaration() && pag->funHasRet(fun)
+                     && svfg->hasFormalRetVFGNode(pag->getFunRet(fun));
+        DDASummary summary;
+        std::string text = line + "\n", hash;
+        bool ended = false;
+        while (std::getline(in, line)) {
+            text += line + "\n";
+            if (line == "end") {
+                ended = true;
+                break;
+            }
+            std::istringstream is(line);
+            is >> tag;
+            if (tag == "fun") {
+                std::string key, funHash;
+                is >> key >> funHash;
+                if (key == funKey)
+                    hash = funHash;
+                if (!valid)
+                    continue;
+                const Function* traversed = module.getFunction(key);
+                valid = traversed && !traversed->isDeclaration() && getFunctionHash(traversed) == funHash;
+                if (valid)
+                    summary.addFunction(traversed);
+            }
+            else if (!valid)
+                continue;
+            else if (tag == "obj") {
+                std::string key, csKey;
+                bool concrete = false;
+                NodeID obj = 0;
+                CallStrCxt cxt;
+                valid = (is >> key >> concrete) && getObj(key, obj);
+                while (valid && is >> csKey) {
+                    CallSiteID csId = 0;
+                    valid = getCallSite(csKey, csId);
+                    cxt.push_back(csId);
+                }
+                if (valid)
+                    summary.addLocalObj(obj, cxt, concrete);
+            }
+            else
+                valid = false;
+        }
+
+        if (valid && ended) {
+            summaries[svfg->getFormalRetVFGNode(pag->getFunRet(fun))->getId()] = summary;
+            num++;
+        }
+        else if (ended)
+            otherSummaries.push_back(std::make_pair(getSummaryIdentity(funKey, hash), text));
+    }
+    return num;
+}
+
+/*!
+ * Write the summaries which can be read by later runs
+ */
+void DDASummaryStore::write(const std::string& path) {
+    if (!changed)
+        return;
+
+    std::string tempPath = AnalysisCache::getTempPath(path);
+    std::ofstream out(tempPath.c_str());
+    if (!out.is_open()) {
+        wrnMsg("cannot write DDA summaries to " + tempPath);
+        return;
+    }
+
+    std::set<std::string> written;
+    for (SummaryMap::const_iterator it = summaries.begin(), eit = summaries.end(); it != eit; ++it) {
+        const DDASummary& summary = it->second;
+        const FormalRetSVFGNode* formalRet = SVFUtil::cast<FormalRetSVFGNode>(svfg->getSVFGNode(it->first));
+        std::string funKey;
+        if (!isStorable(summary) || !getFunctionKey(formalRet->getFun(), funKey))
+            continue;
+
+        /// a summary is written only if all of its objects and call sites have keys
+        std::string str;
+        raw_string_ostream rawstr(str);
+        rawstr << "summary " << funKey << "\n";
+        for (DDASummary::FunctionSet::const_iterator fit = summary.getFunctions().begin(),
+                efit = summary.getFunctions().end(); fit != efit; ++fit) {
+            std::string key;
+            getFunctionKey(*fit, key);
+            rawstr << "fun " << key << " " << getFunctionHash(*fit) << "\n";
+        }
+        bool storable = true;
+        for (DDASummary::LocalObjSet::const_iterator oit = summary.getLocalObjs().begin(),
+                eoit = summary.getLocalObjs().end(); storable && oit != eoit; ++oit) {
+            std::string key;
+            storable = getObjKey(oit->obj, key);
+            rawstr << "obj " << key << " " << oit->concrete;
+            for (CallStrCxt::const_iterator cit = oit->cxt.begin(), ecit = oit->cxt.end(); storable && cit != ecit; ++cit) {
+                storable = getCallSiteKey(*cit, key);
+                rawstr << " " << key;
+            }
+            rawstr << "\n";
+        }
+        rawstr << "end\n";
+        if (storable) {
+            out << rawstr.str();
+            written.insert(getSummaryIdentity(funKey, getFunctionHash(formalRet->getFun())));
+        }
+    }
+    /// summaries of other programs, or of other versions of a function, which another program may have
+    for (std::vector<std::pair<std::string, std::string> >::const_iterator it = otherSummaries.begin(),
+            eit = otherSummaries.end(); it != eit; ++it) {
+        if (written.count(it->first) == 0)
+            out << it->second;
+    }
+    out.close();
+
+    if (AnalysisCache::commitArtifact(tempPath, path))
+        changed = false;
+}
+
+/*!
+ * A function is named by its name if no other function is found by the name
+ */
+bool DDASummaryStore::getFunctionKey(const Function* fun, std::string& key) {
+    key = fun->getName().str();
+    return isValidKey(key) && module.getFunction(key) == fun;
+}
+
+/*!
+ * Key of the value of a memory object
+ */
+bool DDASummaryStore::getValueKey(const Value* val, std::string& key) {
+    if (const Instruction* inst = SVFUtil::dyn_cast<Instruction>(val)) {
+        const Function* fun = inst->getParent()->getParent();
+        std::string funKey;
+        if (!getFunctionKey(fun, funKey))
+            return false;
+        getInstructions(fun);
+        key = "%" + funKey + "#" + std::to_string(instToIndex[inst]);
+        return true;
+    }
+    else if (const GlobalValue* global = SVFUtil::dyn_cast<GlobalValue>(val)) {
+        key = "@" + global->getName().str();
+        return isValidKey(key) && key.size() > 1;
+    }
+    return false;
+}
+
+/*!
+ * Key of a base or field object, an object has no key if its base shares the key with others
+ */
+bool DDASummaryStore::getObjKey(NodeID id, std::string& key) {
+    PAG* pag = svfg->getPAG();
+    if (id == pag->getBlackHoleNode()) {
+        key = "blackhole";
+        return true;
+    }
+    if (id == pag->getConstantNode()) {
+        key = "constant";
+        return true;
+    }
+
+    const ObjPN* obj = SVFUtil::dyn_cast<ObjPN>(pag->getPAGNode(id));
+    if (obj == NULL || SVFUtil::isa<DummyObjPN>(obj) || !getValueKey(obj->getMemObj()->getRefVal(), key))
+        return false;
+
+    indexObjs();
+    if (ambiguousKeys.count(key))
+        return false;
+
+    if (const GepObjPN* gepObj = SVFUtil::dyn_cast<GepObjPN>(obj)) {
+        const LocationSet& ls = gepObj->getLocationSet();
+        if (!ls.isConstantOffset())
+            return false;
+        key += "+" + std::to_string(ls.getOffset()) + "." + std::to_string(ls.getByteOffset());
+    }
+    return true;
+}
+
+/*!
+ * Object of a key, field objects are created if they are not yet
+ */
+bool DDASummaryStore::getObj(const std::string& key, NodeID& id) {
+    PAG* pag = svfg->getPAG();
+    if (key == "blackhole") {
+        id = pag->getBlackHoleNode();
+        return true;
+    }
+    if (key == "constant") {
+        id = pag->getConstantNode();
+        return true;
+    }
+
+    std::string baseKey = key;
+    bool isField = false;
+    Size_t fldIdx = 0, byteOffset = 0;
+    std::string::size_type pos = key.rfind('+');
+    if (pos != std::string::npos) {
+        std::istringstream is(key.substr(pos + 1));
+        char dot = 0;
+        if (is >> fldIdx >> dot >> byteOffset && dot == '.' && is.eof()) {
+            baseKey = key.substr(0, pos);
+            isField = true;
+        }
+    }
+
+    indexObjs();
+    llvm::StringMap<NodeID>::const_iterator it = keyToObj.find(baseKey);
+    if (it == keyToObj.end() || ambiguousKeys.count(baseKey))
+        return false;
+
+    id = it->second;
+    if (isField) {
+        LocationSet ls(fldIdx);
+        ls.setByteOffset(byteOffset);
+        id = pag->getGepObjNode(id, ls);
+    }
+    return true;
+}
+
+/*!
+ * Key of a call site
+ */
+bool DDASummaryStore::getCallSiteKey(CallSiteID csId, std::string& key) {
+    CallSite cs = callgraph->getCallSite(csId);
+    const Function* caller = cs.getCaller();
+    std::string callerKey, calleeKey;
+    if (!getFunctionKey(caller, callerKey) || !getFunctionKey(callgraph->getCalleeOfCallSite(csId), calleeKey))
+        return false;
+    getInstructions(caller);
+    key = callerKey + "#" + std::to_string(instToIndex[cs.getInstruction()]) + ">" + calleeKey;
+    return true;
+}
+
+/*!
+ * Call site of a key, which must be an edge of the call graph
+ */
+bool DDASummaryStore::getCallSite(const std::string& key, CallSiteID& csId) {
+    std::string::size_type hashPos = key.find('#');
+    std::string::size_type calleePos = key.find('>', hashPos);
+    if (hashPos == std::string::npos || calleePos == std::string::npos)
+        return false;
+
+    const Function* caller = module.getFunction(key.substr(0, hashPos));
+    const Function* callee = module.getFunction(key.substr(calleePos + 1));
+    if (caller == NULL || caller->isDeclaration() || callee == NULL)
+        return false;
+
+    u32_t index = 0;
+    std::istringstream is(key.substr(hashPos + 1, calleePos - hashPos - 1));
+    const std::vector<const Instruction*>& insts = getInstructions(caller);
+    if (!(is >> index) || index >= insts.size() || !SVFUtil::isCallSite(insts[index]))
+        return false;
+
+    CallSite cs = SVFUtil::getLLVMCallSite(insts[index]);
+    if (!callgraph->hasCallSiteID(cs, callee))
+        return false;
+    csId = callgraph->getCallSiteID(cs, callee);
+    return true;
+}
+
+/*!
+ * Instructions of a function in order
+ */
+const std::vector<const Instruction*>& DDASummaryStore::getInstructions(const Function* fun) {
+    std::vector<const Instruction*>& insts = funToInsts[fun];
+    if (insts.empty()) {
+        for (Function::const_iterator bit = fun->begin(), ebit = fun->end(); bit != ebit; ++bit) {
+            for (BasicBlock::const_iterator it = bit->begin(), eit = bit->end(); it != eit; ++it) {
+                instToIndex[&*it] = insts.size();
+                insts.push_back(&*it);
+            }
+        }
+    }
+    return insts;
+}
+
+/*!
+ * Index the base objects of the PAG by the keys of their values
+ */
+void DDASummaryStore::indexObjs() {
+    if (indexed)
+        return;
+    indexed = true;
+
+    PAG* pag = svfg->getPAG();
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it) {
+        const FIObjPN* obj = SVFUtil::dyn_cast<FIObjPN>(it->second);
+        std::string key;
+        if (obj == NULL || !getValueKey(obj->getMemObj()->getRefVal(), key))
+            continue;
+        if (!keyToObj.insert(std::make_pair(key, it->first)).second)
+            ambiguousKeys.insert(key);
+    }
+}
+
+const std::string& DDASummaryStore::getFunctionHash(const Function* fun) {
+    std::string& hash = funToHash[fun];
+    if (hash.empty())
+        hash = AnalysisCache::getFunctionHash(fun);
+    return hash;
+}
+
+/*!
+ * A summary is written if it traverses no indirect call, and all of its functions have keys
+ */
+bool DDASummaryStore::isStorable(const DDASummary& summary) {
+    PAG* pag = svfg->getPAG();
+    for (DDASummary::FunctionSet::const_iterator it = summary.getFunctions().begin(),
+            eit = summary.getFunctions().end(); it != eit; ++it) {
+        std::string key;
+        if (!getFunctionKey(*it, key))
+            return false;
+        const std::vector<const Instruction*>& insts = getInstructions(*it);
+        for (std::vector<const Instruction*>::const_iterator iit = insts.begin(), eiit = insts.end(); iit != eiit; ++iit) {
+            if (SVFUtil::isCallSite(*iit) && pag->isIndirectCallSites(SVFUtil::getLLVMCallSite(*iit)))
+                return false;
+        }
+    }
+    return true;
+}
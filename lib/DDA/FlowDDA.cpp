@@ -32,8 +32,10 @@ void FlowDDA::computeDDAPts(NodeID id)
     DOTIMESTAT(ddaStat->_AnaTimePerQuery = DDAStat::getClk() - start);
     DOTIMESTAT(ddaStat->_TotalTimeOfQueries += ddaStat->_AnaTimePerQuery);
 
-    if(isOutOfBudgetQuery() == false)
+    if(isOutOfBudgetQuery() == false) {
         unionPts(node->getId(),pts);
+        sharePointsToOfQuery();
+    }
     else
         handleOutOfBudgetDpm(dpm);
 
@@ -44,6 +46,24 @@ void FlowDDA::computeDDAPts(NodeID id)
 }
 
 
+/*!
+ * Create a solver answering queries concurrently with this one.
+ * It has its own SVFG, call graph and traversal state, and shares the resolved points-to with this one
+ */
+PointerAnalysis* FlowDDA::createDDAWorker() {
+    FlowDDA* worker = new FlowDDA(getModule(), _client);
+    worker->initialize(getModule());
+    worker->setSharedCache(shareCache());
+    return worker;
+}
+
+/*!
+ * Copy the points-to of a query answered by a worker
+ */
+void FlowDDA::mergeDDAPts(PointerAnalysis* worker, NodeID id) {
+    unionPts(id, static_cast<FlowDDA*>(worker)->getPts(id));
+}
+
 /*!
  * Handle out-of-budget dpm
  */
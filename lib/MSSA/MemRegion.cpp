@@ -144,6 +144,9 @@ void MRGenerator::collectModRefForLoadStore() {
         /// if this function does not have any caller, then we do not care its MSSA
         if (IgnoreDeadFun && isDeadFunction(&fun))
             continue;
+        /// functions not reached have no PAG edges (-reachable-funs)
+        if (!pta->getPAG()->isBuiltFunction(&fun))
+            continue;
 
         for (Function::const_iterator iter = fun.begin(), eiter = fun.end();
                 iter != eiter; ++iter) {
@@ -31,6 +31,7 @@
 #include "MSSA/MemSSA.h"
 #include "Util/SVFUtil.h"
 #include "MSSA/SVFGStat.h"
+#include "Util/ParallelUtil.h"
 
 using namespace SVFUtil;
 
@@ -51,11 +52,13 @@ double MemSSA::timeOfGeneratingMemRegions = 0;	///< Time for allocating regions
 double MemSSA::timeOfCreateMUCHI  = 0;	///< Time for generating mu/chi for load/store/calls
 double MemSSA::timeOfInsertingPHI  = 0;	///< Time for inserting phis
 double MemSSA::timeOfSSARenaming  = 0;	///< Time for SSA rename
+double MemSSA::timeOfParallelBuild  = 0;	///< Time for building functions concurrently
 
 /*!
  * Constructor
  */
-MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA) : df(NULL),dt(NULL) {
+MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA) : df(NULL),dt(NULL),
+    worker(false), funRecord(NULL), noRetFuns(NULL) {
     pta = p;
     assert((pta->getAnalysisTy()!=PointerAnalysis::Default_PTA)
            && "please specify a pointer analysis");
@@ -78,12 +81,20 @@ MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA) : df(NULL),dt(NULL) {
     stat = new MemSSAStat(this);
 
     /// Generate whole program memory regions
+    PhaseProfiler::Scope phase("MemSSA region generation");
     double mrStart = stat->getClk();
     mrGen->generateMRs();
     double mrEnd = stat->getClk();
     timeOfGeneratingMemRegions += (mrEnd - mrStart)/TIMEINTERVAL;
 }
 
+/*!
+ * Constructor of a worker, the regions generated by mssa are shared
+ */
+MemSSA::MemSSA(MemSSA* mssa, const FunctionSet* noRet) : pta(mssa->pta), mrGen(mssa->mrGen),
+    df(NULL), dt(NULL), stat(NULL), worker(true), funRecord(NULL), noRetFuns(noRet) {
+}
+
 /*!
  * Set DF/DT
  */
@@ -106,26 +117,146 @@ void MemSSA::buildMemSSA(const Function& fun, DominanceFrontier* f, DominatorTre
 
     setCurrentDFDT(f,t);
 
+    /// Phases of workers are timed as a whole by buildMemSSA(FunctionList)
+    if (worker) {
+        createMUCHI(fun);
+        insertPHI(fun);
+        SSARename(fun);
+        return;
+    }
+
     /// Create mus/chis for loads/stores/calls for memory regions
     double muchiStart = stat->getClk();
-    createMUCHI(fun);
+    {
+        PhaseProfiler::Scope phase("MemSSA mu/chi creation");
+        createMUCHI(fun);
+    }
     double muchiEnd = stat->getClk();
     timeOfCreateMUCHI += (muchiEnd - muchiStart)/TIMEINTERVAL;
 
     /// Insert PHI for memory regions
     double phiStart = stat->getClk();
-    insertPHI(fun);
+    {
+        PhaseProfiler::Scope phase("MemSSA phi insertion");
+        insertPHI(fun);
+    }
     double phiEnd = stat->getClk();
     timeOfInsertingPHI += (phiEnd - phiStart)/TIMEINTERVAL;
 
     /// SSA rename for memory regions
     double renameStart = stat->getClk();
-    SSARename(fun);
+    {
+        PhaseProfiler::Scope phase("MemSSA renaming");
+        SSARename(fun);
+    }
     double renameEnd = stat->getClk();
     timeOfSSARenaming += (renameEnd - renameStart)/TIMEINTERVAL;
 
 }
 
+/*!
+ * Build memory SSA for functions concurrently.
+ * Each thread has its own worker, dominator tree and dominance frontier, and the
+ * workers only read the regions. What a worker creates for a function is committed
+ * in the order of the functions, so that versions get the same IDs as a sequential build.
+ */
+void MemSSA::buildMemSSA(const FunctionList& funs, u32_t numOfThreads) {
+
+    if (numOfThreads <= 1) {
+        DominatorTree dt;
+        MemSSADF df;
+        for (FunctionList::const_iterator it = funs.begin(), eit = funs.end(); it != eit; ++it) {
+            Function* fun = const_cast<Function*>(*it);
+            dt.recalculate(*fun);
+            df.runOnDT(dt);
+            buildMemSSA(*fun, &df, &dt);
+        }
+        return;
+    }
+
+    PhaseProfiler::Scope phase("MemSSA parallel build");
+    if (PhaseProfiler::isEnabled()) {
+        phase.addCounter("functions", funs.size());
+        phase.addCounter("threads", numOfThreads);
+    }
+    double parStart = stat->getClk();
+
+    /// Warnings of functions without return are printed here in order
+    FunctionSet noRets;
+    for (FunctionList::const_iterator it = funs.begin(), eit = funs.end(); it != eit; ++it) {
+        if (functionDoesNotRet(*it))
+            noRets.insert(*it);
+    }
+
+    std::vector<FunBuildRecord> records(funs.size());
+    std::vector<MemSSA*> workers(numOfThreads);
+    std::vector<DominatorTree*> dts(numOfThreads);
+    std::vector<MemSSADF*> dfs(numOfThreads);
+    for (u32_t tid = 0; tid < numOfThreads; ++tid) {
+        workers[tid] = new MemSSA(this, &noRets);
+        dts[tid] = new DominatorTree();
+        dfs[tid] = new MemSSADF();
+    }
+
+    /// Mus and chis take the true condition by default, whose BDD manager is
+    /// created on first use, so create it before the workers read it
+    PathCondAllocator::trueCond();
+
+    parallelFor(funs.size(), numOfThreads, [&](u32_t idx, u32_t tid) {
+        Function* fun = const_cast<Function*>(funs[idx]);
+        dts[tid]->recalculate(*fun);
+        dfs[tid]->runOnDT(*dts[tid]);
+        workers[tid]->funRecord = &records[idx];
+        workers[tid]->buildMemSSA(*fun, dfs[tid], dts[tid]);
+    }, 1);
+
+    /// Commit in the order of the functions
+    for (std::vector<FunBuildRecord>::iterator it = records.begin(), eit = records.end(); it != eit; ++it) {
+        for (std::vector<MRVer*>::iterator vit = it->vers.begin(), evit = it->vers.end(); vit != evit; ++vit)
+            (*vit)->assignID();
+        for (std::vector<const LoadPE*>::iterator lit = it->loadsWithoutMR.begin(), elit = it->loadsWithoutMR.end(); lit != elit; ++lit)
+            mrGen->getLoadMRSet(*lit);
+        for (std::vector<const StorePE*>::iterator sit = it->storesWithoutMR.begin(), esit = it->storesWithoutMR.end(); sit != esit; ++sit)
+            mrGen->getStoreMRSet(*sit);
+    }
+
+    for (u32_t tid = 0; tid < numOfThreads; ++tid) {
+        mergeWorker(workers[tid]);
+        delete workers[tid];
+        delete dts[tid];
+        delete dfs[tid];
+    }
+
+    double parEnd = stat->getClk();
+    timeOfParallelBuild += (parEnd - parStart)/TIMEINTERVAL;
+}
+
+/// Move the sets of src into dst
+template<typename MapTy>
+static inline void moveSets(MapTy& dst, MapTy& src) {
+    for (typename MapTy::iterator it = src.begin(), eit = src.end(); it != eit; ++it)
+        dst[it->first].swap(it->second);
+    src.clear();
+}
+
+/*!
+ * Move the mus/chis/phis of a worker into this memory SSA.
+ * A function is built by a single worker, so the keys of workers never clash.
+ */
+void MemSSA::mergeWorker(MemSSA* w) {
+    moveSets(load2MuSetMap, w->load2MuSetMap);
+    moveSets(store2ChiSetMap, w->store2ChiSetMap);
+    moveSets(callsiteToMuSetMap, w->callsiteToMuSetMap);
+    moveSets(callsiteToChiSetMap, w->callsiteToChiSetMap);
+    moveSets(bb2PhiSetMap, w->bb2PhiSetMap);
+    moveSets(funToEntryChiSetMap, w->funToEntryChiSetMap);
+    moveSets(funToReturnMuSetMap, w->funToReturnMuSetMap);
+
+    /// The regions and the pointer analysis are released by this
+    w->mrGen = NULL;
+    w->pta = NULL;
+}
+
 /*!
  * Create mu/chi according to memory regions
  * collect used mrs in usedRegs and construction map from region to BB for prune SSA phi insertion
@@ -167,9 +298,9 @@ void MemSSA::createMUCHI(const Function& fun) {
                         ebit = pagEdgeList.end(); bit != ebit; ++bit) {
                     const PAGEdge* inst = *bit;
                     if (const LoadPE* load = SVFUtil::dyn_cast<LoadPE>(inst))
-                        AddLoadMU(bb, load, mrGen->getLoadMRSet(load));
+                        AddLoadMU(bb, load, getLoadMRSet(load));
                     else if (const StorePE* store = SVFUtil::dyn_cast<StorePE>(inst))
-                        AddStoreCHI(bb, store, mrGen->getStoreMRSet(store));
+                        AddStoreCHI(bb, store, getStoreMRSet(store));
                 }
             }
             if (isNonInstricCallSite(inst)) {
@@ -198,7 +329,7 @@ void MemSSA::createMUCHI(const Function& fun) {
 
         /// if the function does not have a reachable return instruction from function entry
         /// then we won't create return mu for it
-        if(functionDoesNotRet(&fun) == false) {
+        if(doesNotRet(fun) == false) {
             RETMU* mu = new RETMU(&fun, mr);
             funToReturnMuSetMap[&fun].insert(mu);
         }
@@ -350,7 +481,13 @@ MRVer* MemSSA::newSSAName(const MemRegion* mr, MSSADEF* def) {
 
     VERSION version = mr2CounterMap[mr];
     mr2CounterMap[mr] = version + 1;
-    MRVer* mrVer = new MRVer(mr, version, def);
+    MRVer* mrVer;
+    if (worker) {
+        mrVer = new MRVer(mr, version, def, true);
+        funRecord->vers.push_back(mrVer);
+    }
+    else
+        mrVer = new MRVer(mr, version, def);
     mr2VerStackMap[mr].push_back(mrVer);
     return mrVer;
 }
@@ -70,13 +70,19 @@ void SVFG::buildSVFG() {
     DBOUT(DGENERAL, outs() << pasMsg("\tCreate SVFG Addr-taken Node\n"));
 
     stat->ATVFNodeStart();
-    addSVFGNodesForAddrTakenVars();
+    {
+        PhaseProfiler::Scope phase("SVFG addr-taken nodes");
+        addSVFGNodesForAddrTakenVars();
+    }
     stat->ATVFNodeEnd();
 
     DBOUT(DGENERAL, outs() << pasMsg("\tCreate SVFG Indirect Edge\n"));
 
     stat->indVFEdgeStart();
-    connectIndirectSVFGEdges();
+    {
+        PhaseProfiler::Scope phase("SVFG connect indirect edges");
+        connectIndirectSVFGEdges();
+    }
     stat->indVFEdgeEnd();
 
 }
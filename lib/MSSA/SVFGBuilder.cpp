@@ -31,6 +31,8 @@
 #include "MSSA/SVFG.h"
 #include "MSSA/SVFGBuilder.h"
 #include "WPA/Andersen.h"
+#include "Util/ParallelUtil.h"
+#include "Util/GraphExporter.h"
 
 using namespace SVFUtil;
 
@@ -43,6 +45,12 @@ static llvm::cl::opt<bool> SingleVFG("singleVFG", llvm::cl::init(false),
 static llvm::cl::opt<bool> OPTSVFG("optSVFG", llvm::cl::init(true),
                                llvm::cl::desc("unoptimized SVFG with formal-in and actual-out"));
 
+static llvm::cl::opt<u32_t> MSSAThreads("mssa-threads",  llvm::cl::init(1),
+        llvm::cl::desc("Number of threads building memory SSA of functions (0: all hardware threads)"));
+
+static llvm::cl::opt<bool> FreezeSVFG("freeze-svfg", llvm::cl::init(true),
+                                      llvm::cl::desc("Store the edges of the built SVFG compactly"));
+
 SVFG* SVFGBuilder::globalSvfg = NULL;
 
 
@@ -71,9 +79,17 @@ SVFG* SVFGBuilder::buildFullSVFGWithoutOPT(BVDataPTAImpl* pta) {
 void SVFGBuilder::buildSVFG() {
 	MemSSA* mssa = svfg->getMSSA();
     svfg->buildSVFG();
+    /// edges are rarely added afterwards (only by on-the-fly call graph updates)
+    if(FreezeSVFG)
+        svfg->freeze();
     if(mssa->getPTA()->printStat())
         svfg->performStat();
     svfg->dump("svfg_final");
+    GraphExporter::exportSVFG(svfg);
+}
+
+bool SVFGBuilder::isSingleVFG() {
+    return SingleVFG;
 }
 
 /// Create DDA SVFG
@@ -120,23 +136,20 @@ MemSSA* SVFGBuilder::buildMSSA(BVDataPTAImpl* pta, bool ptrOnlyMSSA){
 
     MemSSA* mssa = new MemSSA(pta, ptrOnlyMSSA);
 
-    DominatorTree dt;
-    MemSSADF df;
-
+    MemSSA::FunctionList funs;
     SVFModule svfModule = mssa->getPTA()->getModule();
     for (SVFModule::iterator iter = svfModule.begin(), eiter = svfModule.end();
             iter != eiter; ++iter) {
 
         Function *fun = *iter;
-        if (SVFUtil::isExtCall(fun))
+        if (SVFUtil::isExtCall(fun) || !pta->getPAG()->isBuiltFunction(fun))
             continue;
 
-        dt.recalculate(*fun);
-        df.runOnDT(dt);
-
-        mssa->buildMemSSA(*fun, &df, &dt);
+        funs.push_back(fun);
     }
 
+    mssa->buildMemSSA(funs, getNumOfWorkerThreads(MSSAThreads));
+
     mssa->performStat();
     mssa->dumpMSSA();
 
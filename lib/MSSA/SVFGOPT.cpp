@@ -61,9 +61,12 @@ void SVFGOPT::buildSVFG() {
     keepActualOutFormalIn = KeepAOFI;
 
     stat->sfvgOptStart();
+    PhaseProfiler::Scope phase("SVFG optimisation");
     handleInterValueFlow();
 
     handleIntraValueFlow();
+    if (PhaseProfiler::isEnabled())
+        phase.addCounter("nodes", getTotalNodeNum());
     stat->sfvgOptEnd();
 
 }
@@ -36,6 +36,7 @@ const char* MemSSAStat::TimeOfGeneratingMemRegions  = "GenRegionTime";	///< Time
 const char* MemSSAStat::TimeOfCreateMUCHI  = "GenMUCHITime";	///< Time for generating mu/chi for load/store/calls
 const char* MemSSAStat::TimeOfInsertingPHI = "InsertPHITime";	///< Time for inserting phis
 const char* MemSSAStat::TimeOfSSARenaming = "SSARenameTime";	///< Time for SSA rename
+const char* MemSSAStat::TimeOfParallelBuild = "ParMSSATime";	///< Time for building functions concurrently
 
 const char* MemSSAStat::NumOfMaxRegion = "MaxRegSize";	///< Number of max points-to set in region.
 const char* MemSSAStat::NumOfAveragePtsInRegion = "AverageRegSize";	///< Number of average points-to set in region.
@@ -92,6 +93,7 @@ void MemSSAStat::performStat() {
     timeStatMap[TimeOfCreateMUCHI] =  MemSSA::timeOfCreateMUCHI;
     timeStatMap[TimeOfInsertingPHI] =  MemSSA::timeOfInsertingPHI;
     timeStatMap[TimeOfSSARenaming] =  MemSSA::timeOfSSARenaming;
+    timeStatMap[TimeOfParallelBuild] =  MemSSA::timeOfParallelBuild;
 
     PTNumStatMap[NumOfMaxRegion] = maxRegionSize;
     timeStatMap[NumOfAveragePtsInRegion] = (regionNumber == 0) ? 0 : ((double)totalRegionPtsNum / regionNumber);
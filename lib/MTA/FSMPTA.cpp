@@ -8,6 +8,8 @@
 #include "MTA/FSMPTA.h"
 #include "MTA/MHP.h"
 #include "MTA/PCG.h"
+#include "Util/ParallelUtil.h"
+#include <algorithm>
 
 using namespace SVFUtil;
 
@@ -15,11 +17,15 @@ FSMPTA* FSMPTA::mfspta = NULL;
 u32_t MTASVFGBuilder::numOfNewSVFGEdges = 0;
 u32_t MTASVFGBuilder::numOfRemovedSVFGEdges = 0;
 u32_t MTASVFGBuilder::numOfRemovedPTS = 0;
+u32_t MTASVFGBuilder::numOfCandidatePairs = 0;
 
 static llvm::cl::opt<bool> UsePCG("pcgTDEdge", llvm::cl::init(false), llvm::cl::desc("Use PCG lock for non-sparsely adding SVFG edges"));
 static llvm::cl::opt<bool> IntraLock("intralockTDEdge", llvm::cl::init(true), llvm::cl::desc("Use simple intra-procedual lock for adding SVFG edges"));
 static llvm::cl::opt<bool> ReadPrecisionTDEdge("rpTDEdge", llvm::cl::init(false), llvm::cl::desc("perform read precision to refine SVFG edges"));
 
+static llvm::cl::opt<u32_t> MHPEdgeThreads("mhp-edge-threads", llvm::cl::init(1),
+        llvm::cl::desc("Number of threads pairing loads and stores accessing common objects (0 for all hardware threads)"));
+
 static llvm::cl::opt<u32_t> AddModelFlag("addTDEdge", llvm::cl::init(0), llvm::cl::desc("Add thread SVFG edges with models: 0 Non Add Edge; 1 NonSparse; "
                                    "2 All Optimisation; 3 No MHP; 4 No Alias; 5 No Lock; 6 No Read Precision."));
 
@@ -412,13 +418,15 @@ void MTASVFGBuilder::handleStoreLoad(const StmtSVFGNode* n1,const StmtSVFGNode*
     PointsTo pts = pta->getPts(n1->getPAGDstNodeID());
     pts &= pta->getPts(n2->getPAGSrcNodeID());
 
+    addStoreLoadEdges(n1, n2, pts);
+}
+
+void MTASVFGBuilder::addStoreLoadEdges(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointsTo& pts) {
     /// Lock
     /// todo: we only consider all cxtstmt of one instruction in one lock span,
     /// otherwise we think this instruction is not locked
     /// This constrait is too strong. All cxt lock under different cxt cannot be identified.
-
-
-    if (ADDEDGE_NOLOCK!=AddModelFlag && lockana->isProtectedByCommonLock(i1, i2)) {
+    if (ADDEDGE_NOLOCK!=AddModelFlag && lockana->isProtectedByCommonLock(n1->getInst(), n2->getInst())) {
         if (isTailofSpan(n1) && isHeadofSpan(n2))
             addTDEdges(n1->getId(), n2->getId(), pts);
     } else {
@@ -441,8 +449,12 @@ void MTASVFGBuilder::handleStoreStore(const StmtSVFGNode* n1,const StmtSVFGNode*
     PointsTo pts = pta->getPts(n1->getPAGDstNodeID());
     pts &= pta->getPts(n2->getPAGDstNodeID());
 
+    addStoreStoreEdges(n1, n2, pts);
+}
+
+void MTASVFGBuilder::addStoreStoreEdges(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointsTo& pts) {
     /// Lock
-    if (ADDEDGE_NOLOCK!=AddModelFlag && lockana->isProtectedByCommonLock(i1, i2)) {
+    if (ADDEDGE_NOLOCK!=AddModelFlag && lockana->isProtectedByCommonLock(n1->getInst(), n2->getInst())) {
         if (isTailofSpan(n1) && isHeadofSpan(n2))
             addTDEdges(n1->getId(), n2->getId(), pts);
         if (isTailofSpan(n2) && isHeadofSpan(n1))
@@ -603,7 +615,7 @@ void MTASVFGBuilder::readPrecision() {
 }
 
 void MTASVFGBuilder::connectMHPEdges(PointerAnalysis* pta) {
-    PCG* pcg;
+    PCG* pcg = NULL;
     if (ADDEDGE_NONSPARSE==AddModelFlag) {
         pcg= new PCG(pta);
         pcg->analyze();
@@ -614,6 +626,22 @@ void MTASVFGBuilder::connectMHPEdges(PointerAnalysis* pta) {
 
     /// todo: we ignore rule 2 and 3. but so far I haven't added intra-thread value flow affected by fork
     /// and inter-thread value flow affected by join
+    if (ADDEDGE_NONSPARSE == AddModelFlag || ADDEDGE_NOALIAS == AddModelFlag)
+        connectAllPairs(pta, pcg);
+    else
+        connectAliasedPairs(pta);
+
+    if(ReadPrecisionTDEdge && ADDEDGE_NORP!=AddModelFlag) {
+        DBOUT(DGENERAL,outs()<<"Read precision edge removing \n");
+        DBOUT(DMTA,outs()<<"Read precision edge removing \n");
+        readPrecision();
+    }
+}
+
+/*!
+ * Pairs are not filtered by alias in the non-sparse and no-alias models
+ */
+void MTASVFGBuilder::connectAllPairs(PointerAnalysis* pta, PCG* pcg) {
     for (SVFGNodeSet::const_iterator it1 = stnodeSet.begin(), eit1 =  stnodeSet.end(); it1!=eit1; ++it1) {
         const StmtSVFGNode* n1 = SVFUtil::cast<StmtSVFGNode>(*it1);
         const Instruction* i1 = n1->getInst();
@@ -648,11 +676,81 @@ void MTASVFGBuilder::connectMHPEdges(PointerAnalysis* pta) {
             }
         }
     }
+}
 
-    if(ReadPrecisionTDEdge && ADDEDGE_NORP!=AddModelFlag) {
-        DBOUT(DGENERAL,outs()<<"Read precision edge removing \n");
-        DBOUT(DMTA,outs()<<"Read precision edge removing \n");
-        readPrecision();
+/*!
+ * Two accesses alias iff their points-to sets, with field-insensitive objects
+ * expanded to all their fields, share an object or one of them contains the
+ * black hole (see BVDataPTAImpl::alias). Accesses are hence bucketed by the
+ * objects of their expanded points-to sets, and the partners of a store are
+ * the union of its buckets, so pairs without a common object are never
+ * enumerated. The partners are collected concurrently, then the MHP and
+ * lock queries, which memoise their results, are answered sequentially.
+ */
+void MTASVFGBuilder::connectAliasedPairs(PointerAnalysis* pta) {
+    PAG* pag = pta->getPAG();
+    /// Accesses are numbered stores first, then loads
+    SVFGNodeVec accesses(stnodeSet.begin(), stnodeSet.end());
+    u32_t numOfStores = accesses.size();
+    accesses.insert(accesses.end(), ldnodeSet.begin(), ldnodeSet.end());
+
+    std::vector<PointsTo> accessPts(accesses.size());
+    std::vector<PointsTo> accessObjs(accesses.size());
+    std::map<NodeID, NodeBS> objToAccesses;
+    NodeBS blackHoleAccesses;
+    for (u32_t i = 0; i < accesses.size(); ++i) {
+        const StmtSVFGNode* n = SVFUtil::cast<StmtSVFGNode>(accesses[i]);
+        accessPts[i] = pta->getPts(i < numOfStores ? n->getPAGDstNodeID() : n->getPAGSrcNodeID());
+        if (accessPts[i].test(pag->getBlackHoleNode())) {
+            blackHoleAccesses.set(i);
+            continue;
+        }
+        PointsTo& objs = accessObjs[i];
+        objs = accessPts[i];
+        for (PointsTo::iterator it = accessPts[i].begin(), eit = accessPts[i].end(); it != eit; ++it) {
+            if (pag->getBaseObjNode(*it) == *it)
+                objs |= pag->getAllFieldsObjNode(*it);
+        }
+        for (PointsTo::iterator it = objs.begin(), eit = objs.end(); it != eit; ++it)
+            objToAccesses[*it].set(i);
+    }
+
+    std::vector<std::vector<u32_t> > partners(numOfStores);
+    parallelFor(numOfStores, getNumOfWorkerThreads(MHPEdgeThreads), [&](u32_t i, u32_t tid) {
+        NodeBS candidates = blackHoleAccesses;
+        if (blackHoleAccesses.test(i)) {
+            for (u32_t j = i + 1; j < accesses.size(); ++j)
+                partners[i].push_back(j);
+            return;
+        }
+        for (PointsTo::iterator it = accessObjs[i].begin(), eit = accessObjs[i].end(); it != eit; ++it)
+            candidates |= objToAccesses.find(*it)->second;
+        /// (store, store) pairs are checked once, from the store numbered first
+        for (NodeBS::iterator it = candidates.begin(), eit = candidates.end(); it != eit; ++it) {
+            if (*it > i)
+                partners[i].push_back(*it);
+        }
+    });
+
+    /// Partners are visited loads first as in connectAllPairs, so that queries
+    /// and edges are made in the same order as pairing all accesses
+    for (u32_t i = 0; i < numOfStores; ++i) {
+        const StmtSVFGNode* n1 = SVFUtil::cast<StmtSVFGNode>(accesses[i]);
+        numOfCandidatePairs += partners[i].size();
+        std::vector<u32_t>::iterator firstLoad = std::lower_bound(partners[i].begin(), partners[i].end(), numOfStores);
+        std::rotate(partners[i].begin(), firstLoad, partners[i].end());
+        for (u32_t j : partners[i]) {
+            const StmtSVFGNode* n2 = SVFUtil::cast<StmtSVFGNode>(accesses[j]);
+            /// MHP
+            if (ADDEDGE_NOMHP != AddModelFlag && !mhp->mayHappenInParallel(n1->getInst(), n2->getInst()))
+                continue;
+            PointsTo pts = accessPts[i];
+            pts &= accessPts[j];
+            if (j < numOfStores)
+                addStoreStoreEdges(n1, n2, pts);
+            else
+                addStoreLoadEdges(n1, n2, pts);
+        }
     }
 }
 
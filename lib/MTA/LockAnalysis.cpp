@@ -224,7 +224,7 @@ void LockAnalysis::collectCxtLock() {
     for (FunSet::const_iterator it = entryFuncSet.begin(), eit = entryFuncSet.end(); it != eit; ++it) {
         if (!isLockCandidateFun(*it))
             continue;
-        CallStrCxt cxt;
+        CallStrCxtID cxt = CallStrCxtTrie::emptyCxt;
         CxtLockProc t(cxt, *it);
         pushToCTPWorkList(t);
     }
@@ -265,7 +265,7 @@ void LockAnalysis::handleCallRelation(CxtLockProc& clp, const PTACallGraphEdge*
 
     const Function* callee = cgEdge->getDstNode()->getFunction();
 
-    CallStrCxt cxt(clp.getContext());
+    CallStrCxtID cxt = clp.getContext();
 
     if (isTDAcquire(cs.getInstruction())) {
         addCxtLock(cxt,cs.getInstruction());
@@ -288,7 +288,7 @@ void LockAnalysis::analyzeLockSpanCxtStmt() {
     for (FunSet::const_iterator it = entryFuncSet.begin(), eit = entryFuncSet.end(); it != eit; ++it) {
         if (!isLockCandidateFun(*it))
             continue;
-        CallStrCxt cxt;
+        CallStrCxtID cxt = CallStrCxtTrie::emptyCxt;
         CxtStmt cxtstmt(cxt, &((*it)->front().front()));
         pushToCTSWorkList(cxtstmt);
     }
@@ -344,13 +344,13 @@ void LockAnalysis::printLocks(const CxtStmt& cts) {
 /// Handle fork
 void LockAnalysis::handleFork(const CxtStmt& cts) {
     const CallInst* call = SVFUtil::cast<CallInst>(cts.getStmt());
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     if(getTCG()->hasThreadForkEdge(call)) {
         for (ThreadCallGraph::ForkEdgeSet::const_iterator cgIt = getTCG()->getForkEdgeBegin(call),
                 ecgIt = getTCG()->getForkEdgeEnd(call); cgIt != ecgIt; ++cgIt) {
             const Function* callee = (*cgIt)->getDstNode()->getFunction();
-            CallStrCxt newCxt = curCxt;
+            CallStrCxtID newCxt = curCxt;
             pushCxt(newCxt,call,callee);
             CxtStmt newCts(newCxt, &(callee->getEntryBlock().front()));
             markCxtStmtFlag(newCts, cts);
@@ -363,7 +363,7 @@ void LockAnalysis::handleFork(const CxtStmt& cts) {
 void LockAnalysis::handleCall(const CxtStmt& cts) {
 
     const CallInst* call = SVFUtil::cast<CallInst>(cts.getStmt());
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     if (getTCG()->hasCallGraphEdge(call)) {
         for (PTACallGraph::CallGraphEdgeSet::const_iterator cgIt = getTCG()->getCallEdgeBegin(call), ecgIt = getTCG()->getCallEdgeEnd(call);
@@ -371,7 +371,7 @@ void LockAnalysis::handleCall(const CxtStmt& cts) {
             const Function* callee = (*cgIt)->getDstNode()->getFunction();
             if (isExtCall(callee))
                 continue;
-            CallStrCxt newCxt = curCxt;
+            CallStrCxtID newCxt = curCxt;
             pushCxt(newCxt, call, callee);
             CxtStmt newCts(newCxt, &(callee->getEntryBlock().front()));
             markCxtStmtFlag(newCts, cts);
@@ -383,7 +383,7 @@ void LockAnalysis::handleCall(const CxtStmt& cts) {
 void LockAnalysis::handleRet(const CxtStmt& cts) {
 
     const Instruction* curInst = cts.getStmt();
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     PTACallGraphNode* curFunNode = getTCG()->getCallGraphNode(curInst->getParent()->getParent());
     for (PTACallGraphNode::const_iterator it = curFunNode->getInEdges().begin(), eit = curFunNode->getInEdges().end(); it != eit; ++it) {
@@ -392,7 +392,7 @@ void LockAnalysis::handleRet(const CxtStmt& cts) {
             continue;
         for (PTACallGraphEdge::CallInstSet::const_iterator cit = (edge)->directCallsBegin(), ecit = (edge)->directCallsEnd(); cit != ecit;
                 ++cit) {
-            CallStrCxt newCxt = curCxt;
+            CallStrCxtID newCxt = curCxt;
             if (matchCxt(newCxt, *cit, curFunNode->getFunction())) {
                 InstVec nextInsts;
                 getNextInsts(*cit, nextInsts);
@@ -404,7 +404,7 @@ void LockAnalysis::handleRet(const CxtStmt& cts) {
         }
         for (PTACallGraphEdge::CallInstSet::const_iterator cit = (edge)->indirectCallsBegin(), ecit = (edge)->indirectCallsEnd();
                 cit != ecit; ++cit) {
-            CallStrCxt newCxt = curCxt;
+            CallStrCxtID newCxt = curCxt;
             if (matchCxt(newCxt, *cit, curFunNode->getFunction())) {
                 InstVec nextInsts;
                 getNextInsts(*cit, nextInsts);
@@ -421,7 +421,7 @@ void LockAnalysis::handleRet(const CxtStmt& cts) {
 void LockAnalysis::handleIntra(const CxtStmt& cts) {
 
     const Instruction* curInst = cts.getStmt();
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     InstVec nextInsts;
     getNextInsts(curInst, nextInsts);
@@ -432,7 +432,7 @@ void LockAnalysis::handleIntra(const CxtStmt& cts) {
 }
 
 
-void LockAnalysis::pushCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee) {
+void LockAnalysis::pushCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee) {
     const Function* caller = call->getParent()->getParent();
     CallSiteID csId = getTCG()->getCallSiteID(getLLVMCallSite(call), callee);
 
@@ -446,7 +446,7 @@ void LockAnalysis::pushCxt(CallStrCxt& cxt, const Instruction* call, const Funct
     }
 }
 
-bool LockAnalysis::matchCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee) {
+bool LockAnalysis::matchCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee) {
     const Function* caller = call->getParent()->getParent();
     CallSiteID csId = getTCG()->getCallSiteID(getLLVMCallSite(call), callee);
 
@@ -455,12 +455,12 @@ bool LockAnalysis::matchCxt(CallStrCxt& cxt, const Instruction* call, const Func
 //        return true;
 
     /// partial match
-    if (cxt.empty())
+    if (CallStrCxtTrie::empty(cxt))
         return true;
 
     if (tct->inSameCallGraphSCC(getTCG()->getCallGraphNode(caller), getTCG()->getCallGraphNode(callee)) == false) {
-        if (cxt.back() == csId)
-            cxt.pop_back();
+        if (CallStrCxtTrie::back(cxt) == csId)
+            cxt = CallStrCxtTrie::pop(cxt);
         else
             return false;
         DBOUT(DMTA, tct->dumpCxt(cxt));
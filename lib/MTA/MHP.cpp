@@ -11,6 +11,8 @@
 #include "MTA/LockAnalysis.h"
 #include "MTA/MTAResultValidator.h"
 #include "Util/SVFUtil.h"
+#include <algorithm>
+#include <unordered_map>
 
 
 using namespace SVFUtil;
@@ -70,7 +72,7 @@ private:
  * Constructor
  */
 MHP::MHP(TCT* t) :tcg(t->getThreadCallGraph()),tct(t),numOfTotalQueries(0),numOfMHPQueries(0),
-    interleavingTime(0),interleavingQueriesTime(0) {
+    interleavingTime(0),interleavingQueriesTime(0),bulkQueriesTime(0) {
     fja = new ForkJoinAnalysis(tct);
     fja->analyzeForkJoinPair();
 }
@@ -168,7 +170,7 @@ void MHP::updateNonCandidateFunInterleaving() {
 
             for (CxtThreadStmtSet::const_iterator it1 = tsSet.begin(), eit1 = tsSet.end(); it1 != eit1; ++it1) {
                 const CxtThreadStmt& cts = *it1;
-                const CallStrCxt& curCxt = cts.getContext();
+                CallStrCxtID curCxt = cts.getContext();
 
                 for (const_inst_iterator II = inst_begin(fun), EE = inst_end(fun); II != EE; ++II) {
                     const Instruction *inst = &*II;
@@ -190,7 +192,7 @@ void MHP::handleNonCandidateFun(const CxtThreadStmt& cts) {
     const Instruction* curInst = cts.getStmt();
     const Function* curfun = curInst->getParent()->getParent();
     assert(curInst == &(curfun->getEntryBlock().front()) && "curInst is not the entry of non candidate function.");
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
     PTACallGraphNode* node = tcg->getCallGraphNode(curfun);
     for (PTACallGraphNode::const_iterator nit = node->OutEdgeBegin(), neit = node->OutEdgeEnd(); nit != neit; nit++) {
         const Function* callee = (*nit)->getDstNode()->getFunction();
@@ -207,14 +209,14 @@ void MHP::handleNonCandidateFun(const CxtThreadStmt& cts) {
 void MHP::handleFork(const CxtThreadStmt& cts, NodeID rootTid) {
 
     const CallInst* call = SVFUtil::cast<CallInst>(cts.getStmt());
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     assert(isTDFork(call));
     if(tct->getThreadCallGraph()->hasCallGraphEdge(call)) {
         for (ThreadCallGraph::ForkEdgeSet::const_iterator cgIt = tcg->getForkEdgeBegin(call),
                 ecgIt = tcg->getForkEdgeEnd(call); cgIt != ecgIt; ++cgIt) {
             const Function* routine = (*cgIt)->getDstNode()->getFunction();
-            CallStrCxt newCxt = curCxt;
+            CallStrCxtID newCxt = curCxt;
             pushCxt(newCxt,call,routine);
             const Instruction* stmt = &(routine->getEntryBlock().front());
             CxtThread ct(newCxt,call);
@@ -231,7 +233,7 @@ void MHP::handleFork(const CxtThreadStmt& cts, NodeID rootTid) {
 void MHP::handleJoin(const CxtThreadStmt& cts, NodeID rootTid) {
 
     const CallInst* call = SVFUtil::cast<CallInst>(cts.getStmt());
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     assert(isTDJoin(call));
 
@@ -275,7 +277,7 @@ void MHP::handleJoin(const CxtThreadStmt& cts, NodeID rootTid) {
 void MHP::handleCall(const CxtThreadStmt& cts, NodeID rootTid) {
 
     const CallInst* call = SVFUtil::cast<CallInst>(cts.getStmt());
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     if(tct->getThreadCallGraph()->hasCallGraphEdge(call)) {
         for (PTACallGraph::CallGraphEdgeSet::const_iterator cgIt = tcg->getCallEdgeBegin(call),
@@ -283,7 +285,7 @@ void MHP::handleCall(const CxtThreadStmt& cts, NodeID rootTid) {
             const Function* callee = (*cgIt)->getDstNode()->getFunction();
             if (isExtCall(callee))
                 continue;
-            CallStrCxt newCxt = curCxt;
+            CallStrCxtID newCxt = curCxt;
             pushCxt(newCxt,call,callee);
             CxtThreadStmt newCts(cts.getTid(),newCxt,&(callee->getEntryBlock().front()));
             addInterleavingThread(newCts,cts);
@@ -303,7 +305,7 @@ void MHP::handleRet(const CxtThreadStmt& cts) {
             continue;
         for(PTACallGraphEdge::CallInstSet::const_iterator cit = (edge)->directCallsBegin(),
                 ecit = (edge)->directCallsEnd(); cit!=ecit; ++cit) {
-            CallStrCxt newCxt = cts.getContext();
+            CallStrCxtID newCxt = cts.getContext();
             if(matchCxt(newCxt,*cit,curFunNode->getFunction())) {
                 InstVec nextInsts;
                 getNextInsts(*cit,nextInsts);
@@ -315,7 +317,7 @@ void MHP::handleRet(const CxtThreadStmt& cts) {
         }
         for(PTACallGraphEdge::CallInstSet::const_iterator cit = (edge)->indirectCallsBegin(),
                 ecit = (edge)->indirectCallsEnd(); cit!=ecit; ++cit) {
-            CallStrCxt newCxt = cts.getContext();
+            CallStrCxtID newCxt = cts.getContext();
             if(matchCxt(newCxt,*cit,curFunNode->getFunction())) {
                 InstVec nextInsts;
                 getNextInsts(*cit,nextInsts);
@@ -355,7 +357,7 @@ void MHP::updateAncestorThreads(NodeID curTid) {
     for(NodeBS::iterator it = tds.begin(), eit = tds.end(); it!=eit; ++it) {
         const CxtThread& ct = tct->getTCTNode(*it)->getCxtThread();
         if(const CallInst* forkInst = ct.getThread()) {
-            CallStrCxt forkSiteCxt = tct->getCxtOfCxtThread(ct);
+            CallStrCxtID forkSiteCxt = tct->getCxtOfCxtThread(ct);
             InstVec nextInsts;
             getNextInsts(forkInst,nextInsts);
             for(InstVec::const_iterator nit = nextInsts.begin(), enit = nextInsts.end(); nit!=enit; ++nit) {
@@ -441,7 +443,7 @@ bool MHP::isMustJoin(NodeID curTid, const Instruction* joinsite) {
 /*!
  * Return thread id(s) which are directly or indirectly joined at this join site
  */
-NodeBS MHP::getDirAndIndJoinedTid(const CallStrCxt& cxt, const Instruction* call) {
+NodeBS MHP::getDirAndIndJoinedTid(CallStrCxtID cxt, const Instruction* call) {
     CxtStmt cs(cxt,call);
     return fja->getDirAndIndJoinedTid(cs);
 }
@@ -449,7 +451,7 @@ NodeBS MHP::getDirAndIndJoinedTid(const CallStrCxt& cxt, const Instruction* call
 /*!
  *  Whether a context-sensitive join satisfies symmetric loop pattern
  */
-const Loop* MHP::isJoinInSymmetricLoop(const CallStrCxt& cxt, const Instruction* call) const {
+const Loop* MHP::isJoinInSymmetricLoop(CallStrCxtID cxt, const Instruction* call) const {
     CxtStmt cs(cxt,call);
     return fja->isJoinInSymmetricLoop(cs);
 }
@@ -554,6 +556,107 @@ bool MHP::mayHappenInParallel(const Instruction* i1, const Instruction* i2) {
     return mhp;
 }
 
+/*!
+ * All-pairs MHP of a set of instructions
+ * (1) each distinct interleaving set is numbered once, and an instruction is summarised
+ *     by the sorted (thread, interleaving number) pairs of its thread statements;
+ * (2) instructions with the same signature form a group;
+ * (3) the MHP rule of mayHappenInParallelInst is applied to each pair of groups only.
+ */
+void MHP::computeMHPMatrix(const InstSet& insts, MHPMatrix& matrix) {
+    typedef std::pair<NodeID, u32_t> ThreadInterleav;
+    typedef std::vector<ThreadInterleav> Signature;
+    typedef std::map<Signature, u32_t> SignatureToGroupMap;
+
+    DOTIMESTAT(double queryStart = PTAStat::getClk());
+
+    matrix.instToGroup.clear();
+    matrix.groupRel.clear();
+    matrix.numOfMHPPairs = 0;
+
+    /// Number distinct interleaving sets, sets are compared only when their hashes agree
+    std::vector<const NodeBS*> interleavs;
+    std::unordered_multimap<size_t, u32_t> hashToInterleav;
+    std::map<const NodeBS*, u32_t> interleavToID;
+    auto getInterleavID = [&](const NodeBS& l) -> u32_t {
+        std::map<const NodeBS*, u32_t>::const_iterator it = interleavToID.find(&l);
+        if (it != interleavToID.end())
+            return it->second;
+        size_t hash = 0;
+        for (NodeBS::iterator bit = l.begin(), ebit = l.end(); bit != ebit; ++bit)
+            hash ^= *bit + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        u32_t id = interleavs.size();
+        auto range = hashToInterleav.equal_range(hash);
+        for (auto hit = range.first; hit != range.second; ++hit) {
+            if (*interleavs[hit->second] == l) {
+                id = hit->second;
+                break;
+            }
+        }
+        if (id == interleavs.size()) {
+            interleavs.push_back(&l);
+            hashToInterleav.insert(std::make_pair(hash, id));
+        }
+        interleavToID[&l] = id;
+        return id;
+    };
+
+    SignatureToGroupMap sigToGroup;
+    std::vector<const Signature*> groupSigs;
+    for (InstSet::const_iterator it = insts.begin(), eit = insts.end(); it != eit; ++it) {
+        const Instruction* inst = *it;
+        if (!hasThreadStmtSet(inst)) {
+            matrix.instToGroup[inst] = MHPMatrix::NoGroup;
+            continue;
+        }
+        Signature sig;
+        const CxtThreadStmtSet& tsSet = getThreadStmtSet(inst);
+        for (CxtThreadStmtSet::const_iterator tit = tsSet.begin(), etit = tsSet.end(); tit != etit; ++tit)
+            sig.push_back(std::make_pair(tit->getTid(), getInterleavID(getInterleavingThreads(*tit))));
+        std::sort(sig.begin(), sig.end());
+        sig.erase(std::unique(sig.begin(), sig.end()), sig.end());
+
+        std::pair<SignatureToGroupMap::iterator, bool> res = sigToGroup.insert(std::make_pair(sig, groupSigs.size()));
+        if (res.second)
+            groupSigs.push_back(&res.first->first);
+        matrix.instToGroup[inst] = res.first->second;
+    }
+
+    /// The relation is symmetric, so only the upper triangle is computed
+    u32_t numOfGroups = groupSigs.size();
+    matrix.groupRel.resize(numOfGroups);
+    for (u32_t g1 = 0; g1 < numOfGroups; g1++) {
+        const Signature& sig1 = *groupSigs[g1];
+        for (u32_t g2 = g1; g2 < numOfGroups; g2++) {
+            const Signature& sig2 = *groupSigs[g2];
+            bool mhp = false;
+            for (Signature::const_iterator it1 = sig1.begin(), eit1 = sig1.end(); it1 != eit1 && !mhp; ++it1) {
+                const NodeBS& l1 = *interleavs[it1->second];
+                for (Signature::const_iterator it2 = sig2.begin(), eit2 = sig2.end(); it2 != eit2; ++it2) {
+                    if (it1->first != it2->first) {
+                        if (l1.test(it2->first) && interleavs[it2->second]->test(it1->first)) {
+                            mhp = true;
+                            break;
+                        }
+                    }
+                    else if (isMultiForkedThread(it1->first)) {
+                        mhp = true;
+                        break;
+                    }
+                }
+            }
+            if (mhp) {
+                matrix.groupRel[g1].set(g2);
+                matrix.groupRel[g2].set(g1);
+                matrix.numOfMHPPairs++;
+            }
+        }
+    }
+
+    DOTIMESTAT(double queryEnd = PTAStat::getClk());
+    DOTIMESTAT(bulkQueriesTime += (queryEnd - queryStart) / TIMEINTERVAL);
+}
+
 bool MHP::executedByTheSameThread(const Instruction* i1, const Instruction* i2) {
     if(!hasThreadStmtSet(i1) || !hasThreadStmtSet(i2))
         return true;
@@ -657,7 +760,7 @@ void ForkJoinAnalysis::analyzeForkJoinPair() {
         const NodeID rootTid = it->first;
         clearFlagMap();
         if(const CallInst* forkInst = ct.getThread()) {
-            CallStrCxt forkSiteCxt = tct->getCxtOfCxtThread(ct);
+            CallStrCxtID forkSiteCxt = tct->getCxtOfCxtThread(ct);
             const Instruction* exitInst = getExitInstOfParentRoutineFun(rootTid);
 
             InstVec nextInsts;
@@ -701,7 +804,7 @@ void ForkJoinAnalysis::analyzeForkJoinPair() {
 /// Handle fork
 void ForkJoinAnalysis::handleFork(const CxtStmt& cts, NodeID rootTid) {
     const CallInst* call = SVFUtil::cast<CallInst>(cts.getStmt());
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     assert(isTDFork(call));
 
@@ -709,7 +812,7 @@ void ForkJoinAnalysis::handleFork(const CxtStmt& cts, NodeID rootTid) {
         for (ThreadCallGraph::ForkEdgeSet::const_iterator cgIt = getTCG()->getForkEdgeBegin(call),
                 ecgIt = getTCG()->getForkEdgeEnd(call); cgIt != ecgIt; ++cgIt) {
             const Function* callee = (*cgIt)->getDstNode()->getFunction();
-            CallStrCxt newCxt = curCxt;
+            CallStrCxtID newCxt = curCxt;
             pushCxt(newCxt,call,callee);
             CxtThread ct(newCxt,call);
             if(getMarkedFlag(cts)!=TDAlive)
@@ -724,7 +827,7 @@ void ForkJoinAnalysis::handleFork(const CxtStmt& cts, NodeID rootTid) {
 /// Handle join
 void ForkJoinAnalysis::handleJoin(const CxtStmt& cts, NodeID rootTid) {
     const CallInst* call = SVFUtil::cast<CallInst>(cts.getStmt());
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     assert(isTDJoin(call));
 
@@ -775,7 +878,7 @@ void ForkJoinAnalysis::handleJoin(const CxtStmt& cts, NodeID rootTid) {
 void ForkJoinAnalysis::handleCall(const CxtStmt& cts, NodeID rootTid) {
 
     const CallInst* call = SVFUtil::cast<CallInst>(cts.getStmt());
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     if(getTCG()->hasCallGraphEdge(call)) {
         for (PTACallGraph::CallGraphEdgeSet::const_iterator cgIt = getTCG()->getCallEdgeBegin(call),
@@ -783,7 +886,7 @@ void ForkJoinAnalysis::handleCall(const CxtStmt& cts, NodeID rootTid) {
             const Function* callee = (*cgIt)->getDstNode()->getFunction();
             if (isExtCall(callee))
                 continue;
-            CallStrCxt newCxt = curCxt;
+            CallStrCxtID newCxt = curCxt;
             pushCxt(newCxt,call,callee);
             CxtStmt newCts(newCxt,&(callee->getEntryBlock().front()));
             markCxtStmtFlag(newCts,cts);
@@ -795,7 +898,7 @@ void ForkJoinAnalysis::handleCall(const CxtStmt& cts, NodeID rootTid) {
 void ForkJoinAnalysis::handleRet(const CxtStmt& cts) {
 
     const Instruction* curInst = cts.getStmt();
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     PTACallGraphNode* curFunNode = getTCG()->getCallGraphNode(curInst->getParent()->getParent());
     for(PTACallGraphNode::const_iterator it = curFunNode->getInEdges().begin(), eit = curFunNode->getInEdges().end(); it!=eit; ++it) {
@@ -804,7 +907,7 @@ void ForkJoinAnalysis::handleRet(const CxtStmt& cts) {
             continue;
         for(PTACallGraphEdge::CallInstSet::const_iterator cit = (edge)->directCallsBegin(),
                 ecit = (edge)->directCallsEnd(); cit!=ecit; ++cit) {
-            CallStrCxt newCxt = curCxt;
+            CallStrCxtID newCxt = curCxt;
             if(matchCxt(newCxt,*cit,curFunNode->getFunction())) {
                 InstVec nextInsts;
                 getNextInsts(*cit,nextInsts);
@@ -816,7 +919,7 @@ void ForkJoinAnalysis::handleRet(const CxtStmt& cts) {
         }
         for(PTACallGraphEdge::CallInstSet::const_iterator cit = (edge)->indirectCallsBegin(),
                 ecit = (edge)->indirectCallsEnd(); cit!=ecit; ++cit) {
-            CallStrCxt newCxt = curCxt;
+            CallStrCxtID newCxt = curCxt;
             if(matchCxt(newCxt,*cit,curFunNode->getFunction())) {
                 InstVec nextInsts;
                 getNextInsts(*cit,nextInsts);
@@ -833,7 +936,7 @@ void ForkJoinAnalysis::handleRet(const CxtStmt& cts) {
 void ForkJoinAnalysis::handleIntra(const CxtStmt& cts) {
 
     const Instruction* curInst = cts.getStmt();
-    const CallStrCxt& curCxt = cts.getContext();
+    CallStrCxtID curCxt = cts.getContext();
 
     InstVec nextInsts;
     getNextInsts(curInst,nextInsts);
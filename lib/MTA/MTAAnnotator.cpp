@@ -166,6 +166,19 @@ void MTAAnnotator::pruneAliasMHP(PointerAnalysis* pta) {
         return;
 
     DBOUT(DGENERAL, outs() << pasMsg("Run annotator prune Alias or MHP pairs\n"));
+    /// All MHP pairs of the candidate stores and loads are computed in one pass.
+    /// This subsumes the per-function-pair cache of MHP::mayHappenInParallel:
+    /// every instruction of a non-candidate function has the thread statements and
+    /// interleavings of the function entry (updateNonCandidateFunInterleaving), so
+    /// those of a function fall into one signature group and the MHP rule is
+    /// evaluated once per pair of such functions, or fewer if their groups agree.
+    MHPMatrix mhpMatrix;
+    if (AnnoMHP) {
+        InstSet accesses(storeset);
+        accesses.insert(loadset.begin(), loadset.end());
+        mhp->computeMHPMatrix(accesses, mhpMatrix);
+    }
+
     InstSet needannost;
     InstSet needannold;
     for (InstSet::iterator it1 = storeset.begin(), eit1 = storeset.end(); it1 != eit1; ++it1) {
@@ -174,7 +187,7 @@ void MTAAnnotator::pruneAliasMHP(PointerAnalysis* pta) {
                 continue;
 
             if (AnnoMHP) {
-                if (mhp->mayHappenInParallel(*it1, *it2) && !lsa->isProtectedByCommonLock(*it1, *it2)) {
+                if (mhpMatrix.mayHappenInParallel(*it1, *it2) && !lsa->isProtectedByCommonLock(*it1, *it2)) {
                     needannost.insert(*it1);
                     needannost.insert(*it2);
                 }
@@ -191,7 +204,7 @@ void MTAAnnotator::pruneAliasMHP(PointerAnalysis* pta) {
                 continue;
 
             if (AnnoMHP) {
-                if (mhp->mayHappenInParallel(*it1, *it2) && !lsa->isProtectedByCommonLock(*it1, *it2)) {
+                if (mhpMatrix.mayHappenInParallel(*it1, *it2) && !lsa->isProtectedByCommonLock(*it1, *it2)) {
                     needannost.insert(*it1);
                     needannold.insert(*it2);
                 }
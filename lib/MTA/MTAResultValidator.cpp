@@ -72,9 +72,9 @@ std::vector<std::string> MTAResultValidator::getStringArg(const Instruction* ins
     return split(vthdcxtstring.str(), ',');
 }
 
-CallStrCxt MTAResultValidator::getCxtArg(const Instruction* inst, unsigned int arg_num) {
+CallStrCxtID MTAResultValidator::getCxtArg(const Instruction* inst, unsigned int arg_num) {
     std::vector<std::string> x = getStringArg(inst, arg_num);
-    CallStrCxt cxt;
+    CallStrCxtID cxt = CallStrCxtTrie::emptyCxt;
     if (0 == x.size())
         return cxt;
     // Deal with the the second argument that records all callsites
@@ -86,7 +86,7 @@ CallStrCxt MTAResultValidator::getCxtArg(const Instruction* inst, unsigned int a
         CallSite cs = SVFUtil::getLLVMCallSite(csnumToInstMap[atoi(y[0].c_str())]);
         assert(callee && "callee error");
         CallSiteID csId = tcg->getCallSiteID(cs, callee);
-        cxt.push_back(csId);
+        cxt = CallStrCxtTrie::push(cxt, csId);
     }
     return cxt;
 }
@@ -131,23 +131,22 @@ inline std::string MTAResultValidator::getOutputforInterlevAnalysis(const char *
     return ret;
 }
 
-bool MTAResultValidator::matchCxt(const CallStrCxt cxt1, const CallStrCxt cxt2) const {
-    if (cxt1.size() != cxt2.size())
-        return false;
-    return std::equal(cxt1.begin(), cxt1.end(), cxt2.begin());
+bool MTAResultValidator::matchCxt(CallStrCxtID cxt1, CallStrCxtID cxt2) const {
+    return cxt1 == cxt2;
 }
 
-void MTAResultValidator::dumpCxt(const CallStrCxt& cxt) const {
+void MTAResultValidator::dumpCxt(CallStrCxtID cxt) const {
+    CallStrCxt callStr = CallStrCxtTrie::getCallStr(cxt);
     std::string str;
     raw_string_ostream rawstr(str);
     rawstr << "[:";
-    for (CallStrCxt::const_iterator it = cxt.begin(), eit = cxt.end(); it != eit; ++it) {
+    for (CallStrCxt::const_iterator it = callStr.begin(), eit = callStr.end(); it != eit; ++it) {
         rawstr << " ' " << *it << " ' ";
         rawstr << *(tcg->getCallSite(*it).getInstruction());
         rawstr << "  call  " << tcg->getCallSite(*it).getCaller()->getName() << "-->" << tcg->getCalleeOfCallSite(*it)->getName() << ", \n";
     }
     rawstr << " ]";
-    outs() << "max cxt = " << cxt.size() << rawstr.str() << "\n";
+    outs() << "max cxt = " << callStr.size() << rawstr.str() << "\n";
 }
 
 void MTAResultValidator::dumpInterlev(NodeBS& lev) {
@@ -189,8 +188,7 @@ bool MTAResultValidator::collectCxtThreadTargets() {
         return false;
 
     // Push main thread into vthdToCxt;
-    CallStrCxt main_cxt;
-    vthdToCxt[0] = main_cxt;
+    vthdToCxt[0] = CallStrCxtTrie::emptyCxt;
 
     // Collect call sites of all CXT_THREAD function calls.
 
@@ -200,7 +198,7 @@ bool MTAResultValidator::collectCxtThreadTargets() {
         const Instruction *inst = SVFUtil::dyn_cast<Instruction>(user);
 
         NodeID vthdnum = getIntArg(inst, 0);
-        CallStrCxt cxt = getCxtArg(inst, 1);
+        CallStrCxtID cxt = getCxtArg(inst, 1);
 
         vthdToCxt[vthdnum] = cxt;
     }
@@ -244,7 +242,7 @@ bool MTAResultValidator::collectInterleavingTargets() {
 
         NodeID vthdnum = getIntArg(inst, 0);
         NodeID rthdnum = vthdTorthd[vthdnum];
-        CallStrCxt x = getCxtArg(inst, 1);
+        CallStrCxtID x = getCxtArg(inst, 1);
         std::vector<std::string> y = getStringArg(inst, 2);
 
         // Record given interleaving
@@ -281,7 +279,7 @@ bool MTAResultValidator::validateCxtThread() {
     for (NodeID i = 0; i < tct->getTCTNodeNum(); i++) {
         const CxtThread rthd = tct->getTCTNode(i)->getCxtThread();
         bool matched = false;
-        for (std::map<NodeID, CallStrCxt>::iterator j = vthdToCxt.begin(), ej = vthdToCxt.end(); j != ej; j++) {
+        for (std::map<NodeID, CallStrCxtID>::iterator j = vthdToCxt.begin(), ej = vthdToCxt.end(); j != ej; j++) {
             NodeID vthdid = (*j).first;
             if (matchCxt(rthd.getContext(), vthdToCxt[vthdid])) {
                 if (visitedvthd.find(vthdid) != visitedvthd.end()) {
@@ -311,7 +309,7 @@ bool MTAResultValidator::validateCxtThread() {
         res = false;
         if (PrintValidRes) {
             outs() << "\nValidate CxtThread: Some given CxtThreads cannot be found !!!\n";
-            for (std::map<NodeID, CallStrCxt>::iterator j = vthdToCxt.begin(), ej = vthdToCxt.end(); j != ej; j++) {
+            for (std::map<NodeID, CallStrCxtID>::iterator j = vthdToCxt.begin(), ej = vthdToCxt.end(); j != ej; j++) {
                 NodeID vthdid = (*j).first;
                 if (visitedvthd.find(vthdid) == visitedvthd.end()) {
                     dumpCxt(vthdToCxt[vthdid]);
@@ -104,11 +104,27 @@ void MTAStat::performMHPPairStat(MHP* mhp, LockAnalysis* lsa) {
         }
 
 
+        double pairStart = getClk();
         for(InstSet::const_iterator it1 = instSet1.begin(), eit1 = instSet1.end(); it1!=eit1; ++it1) {
             for(InstSet::const_iterator it2 = instSet2.begin(), eit2 = instSet2.end(); it2!=eit2; ++it2) {
                 mhp->mayHappenInParallel(*it1,*it2);
             }
         }
+        double pairEnd = getClk();
+        allPairMHPTime = (pairEnd - pairStart) / TIMEINTERVAL;
+
+        /// The same pairs answered by the bulk MHP matrix
+        MHPMatrix matrix;
+        mhp->computeMHPMatrix(instSet1, matrix);
+        bulkMHPPairs = 0;
+        for(InstSet::const_iterator it1 = instSet1.begin(), eit1 = instSet1.end(); it1!=eit1; ++it1) {
+            for(InstSet::const_iterator it2 = instSet2.begin(), eit2 = instSet2.end(); it2!=eit2; ++it2) {
+                if(matrix.mayHappenInParallel(*it1,*it2))
+                    bulkMHPPairs++;
+            }
+        }
+        numOfMHPGroups = matrix.getNumOfGroups();
+        allPairBulkMHPTime = (getClk() - pairEnd) / TIMEINTERVAL;
     }
 
 
@@ -123,10 +139,19 @@ void MTAStat::performMHPPairStat(MHP* mhp, LockAnalysis* lsa) {
     PTNumStatMap["NumOfNewSVFGEdges"] = MTASVFGBuilder::numOfNewSVFGEdges;
     PTNumStatMap["NumOfRemovedEdges"] = MTASVFGBuilder::numOfRemovedSVFGEdges;
     PTNumStatMap["NumOfRemovedPTS"] = MTASVFGBuilder::numOfRemovedPTS;
+    PTNumStatMap["NumOfCandidatePairs"] = MTASVFGBuilder::numOfCandidatePairs;
     timeStatMap["InterlevAnaTime"] = mhp->interleavingTime;
     timeStatMap["LockAnaTime"] = lsa->lockTime;
     timeStatMap["InterlevQueryTime"] = mhp->interleavingQueriesTime;
     timeStatMap["LockQueryTime"] = lsa->lockQueriesTime;
+    if(AllPairMHP) {
+        PTNumStatMap["NumOfMHPGroups"] = numOfMHPGroups;
+        PTNumStatMap["NumOfBulkMHPPairs"] = bulkMHPPairs;
+        timeStatMap["BulkMHPQueryTime"] = mhp->bulkQueriesTime;
+        /// Both answer the same pairs of accesses
+        timeStatMap["AllPairMHPQueryTime"] = allPairMHPTime;
+        timeStatMap["AllPairBulkMHPQueryTime"] = allPairBulkMHPTime;
+    }
     timeStatMap["MHPAnalysisTime"] = MHPTime;
     timeStatMap["MFSPTATime"] = FSMPTATime;
 
@@ -192,8 +192,8 @@ void TCT::handleCallRelation(CxtThreadProc& ctp, const PTACallGraphEdge* cgEdge,
 
     const Function* callee = cgEdge->getDstNode()->getFunction();
 
-    CallStrCxt cxt(ctp.getContext());
-    CallStrCxt oldCxt = cxt;
+    CallStrCxtID cxt = ctp.getContext();
+    CallStrCxtID oldCxt = cxt;
     pushCxt(cxt,cs.getInstruction(),callee);
 
     if(cgEdge->getEdgeKind() == PTACallGraphEdge::CallRetEdge) {
@@ -343,7 +343,7 @@ void TCT::build() {
     for (FunSet::iterator it=entryFuncSet.begin(), eit=entryFuncSet.end(); it!=eit; ++it) {
         if (!isCandidateFun(*it))
             continue;
-        CallStrCxt cxt;
+        CallStrCxtID cxt = CallStrCxtTrie::emptyCxt;
         TCTNode* mainTCTNode = getOrCreateTCTNode(cxt, NULL, cxt, *it);
         CxtThreadProc t(mainTCTNode->getId(), cxt, *it);
         pushToCTPWorkList(t);
@@ -404,7 +404,7 @@ void TCT::getNextInsts(const Instruction* curInst, InstVec& instList) {
 /*!
  * Push calling context
  */
-void TCT::pushCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee) {
+void TCT::pushCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee) {
 
     const Function* caller = call->getParent()->getParent();
     CallSiteID csId = tcg->getCallSiteID(getLLVMCallSite(call),callee);
@@ -423,7 +423,7 @@ void TCT::pushCxt(CallStrCxt& cxt, const Instruction* call, const Function* call
 /*!
  * Match calling context
  */
-bool TCT::matchCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee) {
+bool TCT::matchCxt(CallStrCxtID& cxt, const Instruction* call, const Function* callee) {
 
     const Function* caller = call->getParent()->getParent();
     CallSiteID csId = tcg->getCallSiteID(getLLVMCallSite(call),callee);
@@ -433,12 +433,12 @@ bool TCT::matchCxt(CallStrCxt& cxt, const Instruction* call, const Function* cal
         return true;
 
     /// partial match
-    if(cxt.empty())
+    if(CallStrCxtTrie::empty(cxt))
         return true;
 
     if(inSameCallGraphSCC(tcg->getCallGraphNode(caller),tcg->getCallGraphNode(callee))==false) {
-        if(cxt.back() == csId)
-            cxt.pop_back();
+        if(CallStrCxtTrie::back(cxt) == csId)
+            cxt = CallStrCxtTrie::pop(cxt);
         else
             return false;
         DBOUT(DMTA,dumpCxt(cxt));
@@ -451,17 +451,18 @@ bool TCT::matchCxt(CallStrCxt& cxt, const Instruction* call, const Function* cal
 /*!
  * Dump calling context information
  */
-void TCT::dumpCxt(CallStrCxt& cxt) {
+void TCT::dumpCxt(CallStrCxtID cxt) {
+    CallStrCxt callStr = CallStrCxtTrie::getCallStr(cxt);
     std::string str;
     raw_string_ostream rawstr(str);
     rawstr << "[:";
-    for(CallStrCxt::const_iterator it = cxt.begin(), eit = cxt.end(); it!=eit; ++it) {
+    for(CallStrCxt::const_iterator it = callStr.begin(), eit = callStr.end(); it!=eit; ++it) {
         rawstr << " ' "<< *it << " ' ";
         rawstr << *(tcg->getCallSite(*it).getInstruction());
         rawstr << "  call  " << tcg->getCallSite(*it).getCaller()->getName() << "-->" << tcg->getCalleeOfCallSite(*it)->getName() << ", \n";
     }
     rawstr << " ]";
-    outs() << "max cxt = " << cxt.size() << rawstr.str() << "\n";
+    outs() << "max cxt = " << callStr.size() << rawstr.str() << "\n";
 }
 
 /*!
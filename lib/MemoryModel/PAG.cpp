@@ -430,6 +430,16 @@ bool PAG::addEdge(PAGNode* src, PAGNode* dst, PAGEdge* edge) {
 	if (edge->isPTAEdge()){
 	    totalPTAPAGEdge++;
 		PTAPAGEdgeKindToSetMap[edge->getEdgeKind()].insert(edge);
+		/// the initial PAG build is over once nodeNumAfterPAGBuild is set
+		if (reachableOnly && nodeNumAfterPAGBuild != 0)
+			onTheFlyPTAEdges.push_back(edge);
+	}
+	/// pointers connected by a function built on the fly are candidates as those of the initial build
+	if (reachableOnly && nodeNumAfterPAGBuild != 0) {
+		if (src->isPointer())
+			candidatePointers.insert(src->getId());
+		if (dst->isPointer())
+			candidatePointers.insert(dst->getId());
 	}
 	if (!SVFModule::pagReadFromTXT())
 		setCurrentBBAndValueForPAGEdge(edge);
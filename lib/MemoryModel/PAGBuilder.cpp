@@ -33,10 +33,21 @@
 #include "Util/SVFUtil.h"
 #include "Util/CPPUtil.h"
 #include "Util/BasicTypes.h"
+#include "Util/ParallelUtil.h"
 
 using namespace std;
 using namespace SVFUtil;
 
+static llvm::cl::opt<u32_t> PAGThreads("pag-threads",  llvm::cl::init(1),
+                                       llvm::cl::desc("Number of threads visiting the instructions of functions when building PAG (0 for all hardware threads)"));
+
+static llvm::cl::opt<bool> ReachableFuns("reachable-funs",  llvm::cl::init(false),
+        llvm::cl::desc("Only build PAG, ICFG and MemSSA of functions reachable from program entries, callees resolved by Andersen's analysis are built on the fly"));
+
+static llvm::cl::list<std::string> EntryFuns("entry-funs",
+        llvm::cl::desc("Program entries of -reachable-funs (default: svf.main or main, and global constructors/destructors)"),
+        llvm::cl::CommaSeparated);
+
 
 /*!
  * Start building PAG here
@@ -82,24 +93,210 @@ PAG* PAGBuilder::build(SVFModule svfModule) {
                 pag->addFunArgs(&fun,pag->getPAGNode(argValNodeId));
             }
         }
-        for (Function::iterator bit = fun.begin(), ebit = fun.end();
+    }
+    if (ReachableFuns) {
+        pag->setReachableOnly(true);
+        FunctionList entries, built;
+        collectEntryFunctions(svfModule, entries);
+        buildReachableFunctions(svfModule, entries, built);
+    }
+    else
+        visitFunctions(std::vector<Function*>(svfModule.begin(), svfModule.end()), getNumOfWorkerThreads(PAGThreads));
+    sanityCheck();
+
+    pag->initialiseCandidatePointers();
+
+    pag->setNodeNumAfterPAGBuild(pag->getTotalNodeNum());
+
+    return pag;
+}
+
+/*!
+ * Entries are svf.main (-svfmain) or main, or those given by -entry-funs, and the
+ * global constructors and destructors run before and after them. All functions are
+ * entries if none of them is found, e.g., the module is a library.
+ */
+void PAGBuilder::collectEntryFunctions(SVFModule svfModule, FunctionList& entries) {
+    std::set<std::string> names(EntryFuns.begin(), EntryFuns.end());
+    if (names.empty()) {
+        names.insert("svf.main");
+        names.insert("main");
+    }
+    for (SVFModule::iterator fit = svfModule.begin(), efit = svfModule.end(); fit != efit; ++fit) {
+        const Function* fun = *fit;
+        if (!fun->isDeclaration() && names.count(fun->getName().str()))
+            entries.push_back(fun);
+    }
+    /// svf.main calls main
+    if (EntryFuns.empty() && entries.size() > 1) {
+        for (FunctionList::iterator it = entries.begin(), eit = entries.end(); it != eit; ++it) {
+            if ((*it)->getName() == "svf.main") {
+                entries.assign(1, *it);
+                break;
+            }
+        }
+    }
+
+    for (u32_t i = 0; i < SVFModule::getLLVMModuleSet()->getModuleNum(); ++i) {
+        Module* mod = SVFModule::getLLVMModuleSet()->getModule(i);
+        const char* xtors[] = {"llvm.global_ctors", "llvm.global_dtors"};
+        for (u32_t k = 0; k < 2; ++k) {
+            const GlobalVariable* gv = mod->getNamedGlobal(xtors[k]);
+            if (gv == NULL || !gv->hasInitializer())
+                continue;
+            const ConstantArray* arr = SVFUtil::dyn_cast<ConstantArray>(gv->getInitializer());
+            for (u32_t j = 0; arr && j < arr->getNumOperands(); ++j) {
+                const ConstantStruct* xtor = SVFUtil::dyn_cast<ConstantStruct>(arr->getOperand(j));
+                if (xtor && xtor->getNumOperands() >= 2) {
+                    const Function* fun = getLLVMFunction(xtor->getOperand(1));
+                    if (fun && !fun->isDeclaration())
+                        entries.push_back(fun);
+                }
+            }
+        }
+    }
+
+    if (entries.empty()) {
+        wrnMsg("no program entry found for -reachable-funs, all functions are built");
+        entries.assign(svfModule.begin(), svfModule.end());
+    }
+}
+
+/*!
+ * Functions are built level by level in the order they are reached, instructions
+ * of the functions of a level are visited concurrently as in a whole-program build.
+ * Callsites are visited sequentially, which is where direct callees are reached.
+ */
+void PAGBuilder::buildReachableFunctions(SVFModule svfModule, FunctionList& worklist, FunctionList& built) {
+    svfMod = svfModule;
+    u32_t numOfThreads = getNumOfWorkerThreads(PAGThreads);
+    while (!worklist.empty()) {
+        std::vector<Function*> funs;
+        for (FunctionList::iterator it = worklist.begin(), eit = worklist.end(); it != eit; ++it) {
+            const Function* fun = getDefFunForMultipleModule(*it);
+            if (isExtCall(fun) || !pag->addBuiltFunction(fun))
+                continue;
+            funs.push_back(const_cast<Function*>(fun));
+            built.push_back(fun);
+        }
+        reachedFuns.clear();
+        visitFunctions(funs, numOfThreads);
+        worklist.swap(reachedFuns);
+    }
+}
+
+/*!
+ * Visit the instructions of functions.
+ * With more than one thread, the PAG updates of the instructions of each function are
+ * first recorded concurrently by workers, which only read the symbol table and the PAG.
+ * They are then applied in program order together with the instructions left to
+ * sequential visiting (callsites, geps and those using constant expressions),
+ * so the PAG is the same as the one built by a single thread.
+ */
+void PAGBuilder::visitFunctions(const std::vector<Function*>& funs, u32_t numOfThreads) {
+    std::vector<FunInstEdges> funEdges;
+    if (numOfThreads > 1) {
+        funEdges.resize(funs.size());
+        parallelFor(funs.size(), numOfThreads, [&](u32_t idx, u32_t tid) {
+            PAGBuilder worker;
+            worker.svfMod = svfMod;
+            worker.recordFunction(*funs[idx], funEdges[idx]);
+        }, 4);
+    }
+
+    for (u32_t i = 0; i < funs.size(); ++i) {
+        const FunInstEdges* recorded = funEdges.empty() ? NULL : &funEdges[i];
+        u32_t instIdx = 0;
+        u32_t edgeIdx = 0;
+        for (Function::iterator bit = funs[i]->begin(), ebit = funs[i]->end();
                 bit != ebit; ++bit) {
             BasicBlock& bb = *bit;
             for (BasicBlock::iterator it = bb.begin(), eit = bb.end();
-                    it != eit; ++it) {
+                    it != eit; ++it, ++instIdx) {
                 Instruction& inst = *it;
                 pag->setCurrentLocation(&inst,&bb);
-                visit(inst);
+                if (recorded == NULL || recorded->numOfEdges[instIdx] == DeferredInst) {
+                    visit(inst);
+                    continue;
+                }
+                for (u32_t end = edgeIdx + recorded->numOfEdges[instIdx]; edgeIdx < end; ++edgeIdx)
+                    applyInstEdge(recorded->edges[edgeIdx]);
             }
         }
     }
-    sanityCheck();
+}
 
-    pag->initialiseCandidatePointers();
+/*!
+ * Record the PAG updates of the instructions of a function (run by a worker)
+ */
+void PAGBuilder::recordFunction(Function& fun, FunInstEdges& funEdges) {
+    recorder = &funEdges;
+    for (inst_iterator it = inst_begin(fun), eit = inst_end(fun); it != eit; ++it) {
+        Instruction& inst = *it;
+        if (!isRecordable(inst)) {
+            funEdges.numOfEdges.push_back(DeferredInst);
+            continue;
+        }
+        u32_t begin = funEdges.edges.size();
+        recordFailed = false;
+        visit(inst);
+        if (recordFailed) {
+            funEdges.edges.resize(begin);
+            funEdges.numOfEdges.push_back(DeferredInst);
+        }
+        else
+            funEdges.numOfEdges.push_back(funEdges.edges.size() - begin);
+    }
+    recorder = NULL;
+}
 
-    pag->setNodeNumAfterPAGBuild(pag->getTotalNodeNum());
+/*!
+ * Callsites add call edges and nodes of external calls, and computing the offset of
+ * a gep fills the type information of the symbol table, both are left to sequential visiting
+ */
+bool PAGBuilder::isRecordable(const Instruction& inst) const {
+    if (isCallSite(&inst) || SVFUtil::isa<GetElementPtrInst>(inst))
+        return false;
+    for (u32_t i = 0; i < inst.getNumOperands(); ++i) {
+        if (SVFUtil::isa<ConstantExpr>(inst.getOperand(i)))
+            return false;
+    }
+    return true;
+}
 
-    return pag;
+/*!
+ * Apply a PAG update of an instruction
+ */
+void PAGBuilder::applyInstEdge(const InstEdge& edge) {
+    switch (edge.kind) {
+    case AddrInstEdge:
+        pag->addAddrEdge(edge.src, edge.dst);
+        break;
+    case CopyInstEdge:
+        pag->addCopyEdge(edge.src, edge.dst);
+        break;
+    case LoadInstEdge:
+        pag->addLoadEdge(edge.src, edge.dst);
+        break;
+    case StoreInstEdge:
+        pag->addStoreEdge(edge.src, edge.dst);
+        break;
+    case BlackHoleInstEdge:
+        pag->addBlackHoleAddrEdge(edge.dst);
+        break;
+    case PhiInstEdge:
+        pag->addCopyEdge(edge.src, edge.dst);
+        pag->addPhiNode(pag->getPAGNode(edge.dst), pag->getPAGNode(edge.src), edge.bb);
+        break;
+    case BinaryInstEdge:
+        pag->addBinaryOPEdge(edge.src, edge.dst);
+        pag->addBinaryNode(pag->getPAGNode(edge.dst), pag->getPAGNode(edge.src));
+        break;
+    case CmpInstEdge:
+        pag->addCmpEdge(edge.src, edge.dst);
+        pag->addCmpNode(pag->getPAGNode(edge.dst), pag->getPAGNode(edge.src));
+        break;
+    }
 }
 
 /*
@@ -404,7 +601,7 @@ void PAGBuilder::visitAllocaInst(AllocaInst &inst) {
 
     NodeID src = getObjectNode(&inst);
 
-    pag->addAddrEdge(src, dst);
+    addInstEdge(AddrInstEdge, src, dst);
 
 }
 
@@ -420,8 +617,7 @@ void PAGBuilder::visitPHINode(PHINode &inst) {
 	for (Size_t i = 0; i < inst.getNumIncomingValues(); ++i) {
 		NodeID src = getValueNode(inst.getIncomingValue(i));
 		const BasicBlock* bb = inst.getIncomingBlock(i);
-		pag->addCopyEdge(src, dst);
-		pag->addPhiNode(pag->getPAGNode(dst), pag->getPAGNode(src), bb);
+		addInstEdge(PhiInstEdge, src, dst, bb);
 	}
 }
 
@@ -435,7 +631,7 @@ void PAGBuilder::visitLoadInst(LoadInst &inst) {
 
 	NodeID src = getValueNode(inst.getPointerOperand());
 
-	pag->addLoadEdge(src, dst);
+	addInstEdge(LoadInstEdge, src, dst);
 }
 
 /*!
@@ -451,7 +647,7 @@ void PAGBuilder::visitStoreInst(StoreInst &inst) {
 
 	NodeID src = getValueNode(inst.getValueOperand());
 
-	pag->addStoreEdge(src, dst);
+	addInstEdge(StoreInstEdge, src, dst);
 
 }
 
@@ -464,7 +660,7 @@ void PAGBuilder::visitGetElementPtrInst(GetElementPtrInst &inst) {
     // GetElementPtrInst should always be a pointer or a vector contains pointers
     // for now we don't handle vector type here
     if(SVFUtil::isa<VectorType>(inst.getType())){
-	pag->addBlackHoleAddrEdge(dst);
+	addBlackHoleAddrEdge(dst);
         return;
     }
 
@@ -488,14 +684,14 @@ void PAGBuilder::visitCastInst(CastInst &inst) {
 	NodeID dst = getValueNode(&inst);
 
 	if (SVFUtil::isa<IntToPtrInst>(&inst)) {
-		pag->addBlackHoleAddrEdge(dst);
+		addBlackHoleAddrEdge(dst);
 	} else {
 		Value * opnd = inst.getOperand(0);
 		if (!SVFUtil::isa<PointerType>(opnd->getType()))
 			opnd = stripAllCasts(opnd);
 
 		NodeID src = getValueNode(opnd);
-		pag->addCopyEdge(src, dst);
+		addInstEdge(CopyInstEdge, src, dst);
 	}
 }
 
@@ -507,8 +703,7 @@ void PAGBuilder::visitBinaryOperator(BinaryOperator &inst) {
     for (u32_t i = 0; i < inst.getNumOperands(); i++) {
         Value* opnd = inst.getOperand(i);
         NodeID src = getValueNode(opnd);
-        pag->addBinaryOPEdge(src, dst);
-        pag->addBinaryNode(pag->getPAGNode(dst),pag->getPAGNode(src));
+        addInstEdge(BinaryInstEdge, src, dst);
     }
 }
 
@@ -520,8 +715,7 @@ void PAGBuilder::visitCmpInst(CmpInst &inst) {
     for (u32_t i = 0; i < inst.getNumOperands(); i++) {
         Value* opnd = inst.getOperand(i);
         NodeID src = getValueNode(opnd);
-        pag->addCmpEdge(src, dst);
-        pag->addCmpNode(pag->getPAGNode(dst),pag->getPAGNode(src));
+        addInstEdge(CmpInstEdge, src, dst);
     }
 }
 
@@ -536,11 +730,9 @@ void PAGBuilder::visitSelectInst(SelectInst &inst) {
 	NodeID dst = getValueNode(&inst);
 	NodeID src1 = getValueNode(inst.getTrueValue());
 	NodeID src2 = getValueNode(inst.getFalseValue());
-	pag->addCopyEdge(src1, dst);
-	pag->addCopyEdge(src2, dst);
 	/// Two operands have same incoming basic block, both are the current BB
-	pag->addPhiNode(pag->getPAGNode(dst), pag->getPAGNode(src1), inst.getParent());
-	pag->addPhiNode(pag->getPAGNode(dst), pag->getPAGNode(src2), inst.getParent());
+	addInstEdge(PhiInstEdge, src1, dst, inst.getParent());
+	addInstEdge(PhiInstEdge, src2, dst, inst.getParent());
 }
 
 /*
@@ -574,6 +766,7 @@ void PAGBuilder::visitCallSite(CallSite cs) {
             }
         } else {
             handleDirectCall(cs, callee);
+            addReachedFunction(callee);
         }
     } else {
         //If the callee was not identified as a function (null F), this is indirect.
@@ -597,7 +790,7 @@ void PAGBuilder::visitReturnInst(ReturnInst &inst) {
         NodeID rnF = getReturnNode(F);
         NodeID vnS = getValueNode(src);
         //vnS may be null if src is a null ptr
-        pag->addCopyEdge(vnS, rnF);
+        addInstEdge(CopyInstEdge, vnS, rnF);
     }
 }
 
@@ -612,7 +805,7 @@ void PAGBuilder::visitReturnInst(ReturnInst &inst) {
  */
 void PAGBuilder::visitExtractValueInst(ExtractValueInst  &inst) {
 	NodeID dst = getValueNode(&inst);
-	pag->addBlackHoleAddrEdge(dst);
+	addBlackHoleAddrEdge(dst);
 }
 
 /*!
@@ -625,7 +818,7 @@ void PAGBuilder::visitExtractValueInst(ExtractValueInst  &inst) {
  */
 void PAGBuilder::visitExtractElementInst(ExtractElementInst &inst) {
 	NodeID dst = getValueNode(&inst);
-	pag->addBlackHoleAddrEdge(dst);
+	addBlackHoleAddrEdge(dst);
 }
 
 /*!
@@ -999,6 +1192,7 @@ void PAGBuilder::handleExtCall(CallSite cs, const Function *callee) {
         if(isThreadForkCall(inst)) {
             if(const Function* forkedFun = getLLVMFunction(getForkedFun(inst)) ) {
                 forkedFun = getDefFunForMultipleModule(forkedFun);
+                addReachedFunction(forkedFun);
                 const Value* actualParm = getActualParmAtForkSite(inst);
                 /// pthread_create has 1 arg.
                 /// apr_thread_create has 2 arg.
@@ -0,0 +1,215 @@
+//===- PTAResultFile.cpp -- Binary storage of points-to results---------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PTAResultFile.cpp
+ */
+
+#include "MemoryModel/PTAResultFile.h"
+#include <algorithm>
+#include <fstream>
+#include <string.h>
+
+using namespace SVFUtil;
+
+const char PTAResultFile::Magic[8] = {'S', 'V', 'F', 'P', 'T', 'S', 'B', '\0'};
+
+/// Number of padding bytes to align a section to 8 bytes
+static inline u64_t paddingOf(u64_t size) {
+    return (8 - (size & 7)) & 7;
+}
+
+/// Whether num entries of entrySize bytes at offset lie within a file of size bytes,
+/// written so that none of the values read from the file can overflow
+static inline bool isInFile(u64_t offset, u64_t num, u64_t entrySize, u64_t size) {
+    return offset <= size && num <= (size - offset) / entrySize;
+}
+
+/*!
+ * Whether a file starts with the magic of this format
+ */
+bool PTAResultFile::isBinaryFile(const std::string& filename) {
+    std::ifstream F(filename.c_str(), std::ios::binary);
+    char magic[sizeof(Magic)];
+    if (!F.read(magic, sizeof(magic)))
+        return false;
+    return memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+/*!
+ * Add the points-to set of a variable
+ */
+void PTAResultFileWriter::addPts(NodeID var, const PointsTo& pts) {
+    IndexEntry entry;
+    entry.var = var;
+    entry.numOfTargets = 0;
+    entry.offset = targets.size();
+    for (PointsTo::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it) {
+        targets.push_back(*it);
+        entry.numOfTargets++;
+    }
+    index.push_back(entry);
+}
+
+/*!
+ * Write the collected points-to sets, gep objects and field-insensitive objects
+ */
+bool PTAResultFileWriter::write(const std::string& filename) {
+    std::sort(index.begin(), index.end(), [](const IndexEntry& a, const IndexEntry& b) {
+        return a.var < b.var;
+    });
+
+    // Gep objects are sorted by ID so that reading them back recreates the same IDs
+    std::vector<GepObjEntry> gepObjs;
+    std::vector<u32_t> fiObjs;
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it) {
+        if (GepObjPN* gepObjPN = SVFUtil::dyn_cast<GepObjPN>(it->second)) {
+            GepObjEntry entry;
+            entry.id = it->first;
+            entry.base = pag->getBaseObjNode(it->first);
+            entry.offset = (u64_t)gepObjPN->getLocationSet().getOffset();
+            gepObjs.push_back(entry);
+        }
+        else if (ObjPN* objPN = SVFUtil::dyn_cast<ObjPN>(it->second)) {
+            if (pag->getBaseObjNode(it->first) == it->first && objPN->getMemObj()->isFieldInsensitive())
+                fiObjs.push_back(it->first);
+        }
+    }
+    std::sort(gepObjs.begin(), gepObjs.end(), [](const GepObjEntry& a, const GepObjEntry& b) {
+        return a.id < b.id;
+    });
+    std::sort(fiObjs.begin(), fiObjs.end());
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.numOfVars = index.size();
+    header.indexOffset = sizeof(Header);
+    header.numOfTargets = targets.size();
+    header.targetsOffset = header.indexOffset + index.size() * sizeof(IndexEntry);
+    u64_t targetsSize = targets.size() * sizeof(u32_t);
+    header.numOfGepObjs = gepObjs.size();
+    header.gepObjsOffset = header.targetsOffset + targetsSize + paddingOf(targetsSize);
+    header.numOfFIObjs = fiObjs.size();
+    header.fiObjsOffset = header.gepObjsOffset + gepObjs.size() * sizeof(GepObjEntry);
+
+    std::error_code err;
+    ToolOutputFile F(filename.c_str(), err, llvm::sys::fs::F_None);
+    if (err) {
+        outs() << "  error opening file for writing!\n";
+        F.os().clear_error();
+        return false;
+    }
+
+    static const char zeros[8] = {0};
+    raw_ostream& os = F.os();
+    os.write((const char*)&header, sizeof(header));
+    os.write((const char*)index.data(), index.size() * sizeof(IndexEntry));
+    os.write((const char*)targets.data(), targetsSize);
+    os.write(zeros, paddingOf(targetsSize));
+    os.write((const char*)gepObjs.data(), gepObjs.size() * sizeof(GepObjEntry));
+    os.write((const char*)fiObjs.data(), fiObjs.size() * sizeof(u32_t));
+
+    F.os().close();
+    if (F.os().has_error()) {
+        F.os().clear_error();
+        return false;
+    }
+    F.keep();
+    return true;
+}
+
+/*!
+ * Map a file into memory and validate its header
+ */
+bool PTAResultFileReader::open(const std::string& filename) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > fileOrErr =
+        llvm::MemoryBuffer::getFile(filename, -1, /*RequiresNullTerminator=*/false);
+    if (!fileOrErr)
+        return false;
+    buffer = std::move(fileOrErr.get());
+
+    const char* data = buffer->getBufferStart();
+    u64_t size = buffer->getBufferSize();
+    assert(((uintptr_t)data & 7) == 0 && "file buffer is not aligned!");
+    if (size < sizeof(Header))
+        return false;
+    header = (const Header*)data;
+    if (memcmp(header->magic, Magic, sizeof(Magic)) != 0) {
+        wrnMsg("not a binary points-to result file");
+        return false;
+    }
+    if (header->version != Version) {
+        wrnMsg("unsupported version of binary points-to result file");
+        return false;
+    }
+    if (!isInFile(header->indexOffset, header->numOfVars, sizeof(IndexEntry), size)
+            || !isInFile(header->targetsOffset, header->numOfTargets, sizeof(u32_t), size)
+            || !isInFile(header->gepObjsOffset, header->numOfGepObjs, sizeof(GepObjEntry), size)
+            || !isInFile(header->fiObjsOffset, header->numOfFIObjs, sizeof(u32_t), size)) {
+        wrnMsg("truncated binary points-to result file");
+        return false;
+    }
+
+    index = (const IndexEntry*)(data + header->indexOffset);
+    targets = (const u32_t*)(data + header->targetsOffset);
+    gepObjs = (const GepObjEntry*)(data + header->gepObjsOffset);
+    fiObjs = (const u32_t*)(data + header->fiObjsOffset);
+    return true;
+}
+
+/*!
+ * Union the targets of the i-th index entry into pts
+ */
+bool PTAResultFileReader::readPtsAt(u64_t i, PointsTo& pts) const {
+    const IndexEntry& entry = index[i];
+    if (entry.offset > header->numOfTargets || entry.numOfTargets > header->numOfTargets - entry.offset)
+        return false;
+    const u32_t* it = targets + entry.offset;
+    const u32_t* eit = it + entry.numOfTargets;
+    for (; it != eit; ++it)
+        pts.set(*it);
+    return true;
+}
+
+/*!
+ * Binary search the index for var
+ */
+bool PTAResultFileReader::readPts(NodeID var, PointsTo& pts) const {
+    const IndexEntry* begin = index;
+    const IndexEntry* end = index + header->numOfVars;
+    const IndexEntry* it = std::lower_bound(begin, end, var, [](const IndexEntry& entry, NodeID id) {
+        return entry.var < id;
+    });
+    if (it == end || it->var != var)
+        return false;
+    return readPtsAt(it - begin, pts);
+}
+
+/*!
+ * Decode the points-to set of a variable added lazily
+ */
+void PTAResultFileReader::load(u32_t var, PointsTo& pts) {
+    if (!readPts(var, pts))
+        wrnMsg("corrupted points-to set in binary points-to result file");
+}
@@ -39,6 +39,9 @@
 #include "MemoryModel/CHA.h"
 #include "MemoryModel/PTAType.h"
 #include "MemoryModel/ExternalPAG.h"
+#include "MemoryModel/PTAResultFile.h"
+#include "Util/AnalysisCache.h"
+#include "Util/GraphExporter.h"
 #include <fstream>
 #include <sstream>
 
@@ -87,6 +90,9 @@ static llvm::cl::opt<bool> INCDFPTData("incdata", llvm::cl::init(true),
 static llvm::cl::opt<bool> connectVCallOnCHA("vcall-cha", llvm::cl::init(false),
                                        llvm::cl::desc("connect virtual calls using cha"));
 
+static llvm::cl::opt<bool> PtsTextFile("pts-text-file", llvm::cl::init(false),
+                                 llvm::cl::desc("Write pointer analysis results in the text format instead of the binary one"));
+
 CHGraph* PointerAnalysis::chgraph = NULL;
 PAG* PointerAnalysis::pag = NULL;
 
@@ -141,10 +147,20 @@ void PointerAnalysis::initialize(SVFModule svfModule) {
         } else {
             DBOUT(DGENERAL, outs() << pasMsg("Building Symbol table ...\n"));
             SymbolTableInfo* symTable = SymbolTableInfo::Symbolnfo();
-            symTable->buildMemModel(svfModule);
+            {
+                PhaseProfiler::Scope phase("symbol table build");
+                symTable->buildMemModel(svfModule);
+            }
 
-            PAGBuilder builder;
-            pag = builder.build(svfModule);
+            {
+                PhaseProfiler::Scope phase("PAG build");
+                PAGBuilder builder;
+                pag = builder.build(svfModule);
+                if (PhaseProfiler::isEnabled()) {
+                    phase.addCounter("nodes", pag->getTotalNodeNum());
+                    phase.addCounter("edges", pag->getTotalEdgeNum());
+                }
+            }
 
             chgraph = new CHGraph(svfModule);
             chgraph->buildCHG();
@@ -229,6 +245,7 @@ void PointerAnalysis::finalize() {
     // dump the PAG graph
     if (dumpGraph())
         pag->dump("pag_final");
+    GraphExporter::exportPAG(pag, this);
 
     if (!DumpPAGFunctions.empty()) ExternalPAG::dumpFunctions(DumpPAGFunctions);
 
@@ -300,12 +317,16 @@ void PointerAnalysis::dumpAllTypes()
  * Constructor
  */
 BVDataPTAImpl::BVDataPTAImpl(PointerAnalysis::PTATY type) :
-		PointerAnalysis(type) {
+		PointerAnalysis(type), ptsSpill(NULL), ptsFileRevPending(false) {
 	if (type == Andersen_WPA || type == AndersenWaveDiff_WPA || type == AndersenHCD_WPA || type == AndersenHLCD_WPA
         || type == AndersenLCD_WPA || type == TypeCPP_WPA || type == FlowS_DDA || type == AndersenWaveDiffWithType_WPA
-        || type == AndersenSCD_WPA || type == AndersenSFR_WPA) {
+        || type == AndersenWaveDiffPar_WPA || type == AndersenSCD_WPA || type == AndersenSFR_WPA) {
 		ptD = new DiffPTDataTy();
-	} else if (type == FSSPARSE_WPA) {
+		/// Worker threads of the parallel solver access points-to sets concurrently,
+		/// hence its sets are never spilled
+		if (type != AndersenWaveDiffPar_WPA && (ptsSpill = PtsSpillStore::create()))
+			ptD->enableSpill(ptsSpill);
+	} else if (type == FSSPARSE_WPA || type == FSSPARSEPar_WPA) {
 		if (INCDFPTData)
 			ptD = new IncDFPTDataTy();
 		else
@@ -314,6 +335,35 @@ BVDataPTAImpl::BVDataPTAImpl(PointerAnalysis::PTATY type) :
 		assert(false && "no points-to data available");
 }
 
+/*!
+ * Release memory
+ */
+void BVDataPTAImpl::destroy() {
+    delete ptD;
+    ptD = NULL;
+    delete ptsSpill;
+    ptsSpill = NULL;
+    ptsFile.reset();
+    ptsFileRevPending = false;
+}
+
+/*!
+ * Memory released by spilling may stay in the heap for reuse, hence the
+ * resident memory is checked again before the next spill round
+ */
+void BVDataPTAImpl::spillPtsOverBudget(const PTDataTy::SpillHotFn& isHot) {
+    u64_t overBytes;
+    if (!PtsSpillStore::isOverBudget(overBytes))
+        return;
+
+    PhaseProfiler::Scope phase("points-to spill");
+    u64_t released = ptD->spillColdPts(overBytes, isHot);
+    ptsSpill->endRound();
+    if (PhaseProfiler::isEnabled())
+        phase.addCounter("releasedKB", released / 1024);
+    DBOUT(DGENERAL, outs() << pasMsg("Spilled points-to sets of ") << released / 1024 << " KB\n");
+}
+
 /*!
  * Expand all fields of an aggregate in all points-to sets
  */
@@ -332,6 +382,132 @@ void BVDataPTAImpl::expandFIObjs(const PointsTo& pts, PointsTo& expandedPts) {
  * created when solving Andersen's constraints.
  */
 void BVDataPTAImpl::writeToFile(const string& filename) {
+    if (PtsTextFile)
+        writeToTextFile(filename);
+    else
+        writeToBinaryFile(filename);
+}
+
+/*!
+ * Load pointer analysis result form a file, either in the binary or the text format.
+ */
+bool BVDataPTAImpl::readFromFile(const string& filename) {
+    if (PTAResultFile::isBinaryFile(filename))
+        return readFromBinaryFile(filename);
+    else
+        return readFromTextFile(filename);
+}
+
+/*!
+ * Store pointer analysis result in the binary format.
+ * Besides the points-to relations and gep objects of the text format,
+ * the field-insensitive objects are recorded as well.
+ */
+bool BVDataPTAImpl::writeToBinaryFile(const string& filename) {
+    outs() << "Storing pointer analysis results to '" << filename << "'...";
+
+    PTAResultFileWriter writer(pag);
+    PTDataTy *ptD = getPTDataTy();
+    auto &ptsMap = ptD->getPtsMap();
+    for (auto it = ptsMap.begin(), ie = ptsMap.end(); it != ie; ++it) {
+        NodeID var = it->first;
+        writer.addPts(var, getPts(var));
+    }
+
+    if (writer.write(filename)) {
+        outs() << "\n";
+        return true;
+    }
+    outs() << "  error writing file!\n";
+    return false;
+}
+
+/*!
+ * Load the results of a stage from the analysis cache if they have been stored
+ */
+bool BVDataPTAImpl::readFromCache(const string& stage, const string& stageOptions) {
+    string path = AnalysisCache::getArtifactPath(getModule(), stage, stageOptions);
+    if (!AnalysisCache::hasArtifact(path))
+        return false;
+    return readFromBinaryFile(path);
+}
+
+/*!
+ * Store the results of a stage into the analysis cache
+ */
+void BVDataPTAImpl::writeToCache(const string& stage, const string& stageOptions) {
+    string path = AnalysisCache::getArtifactPath(getModule(), stage, stageOptions);
+    string tempPath = AnalysisCache::getTempPath(path);
+    if (writeToBinaryFile(tempPath))
+        AnalysisCache::commitArtifact(tempPath, path);
+    else
+        llvm::sys::fs::remove(tempPath);
+}
+
+/*!
+ * Load pointer analysis result in the binary format.
+ * The points-to set of a variable is decoded from the mapped file by the
+ * points-to map when it is first accessed, through any path including
+ * iterations of the map, so loading costs as much as the sets accessed.
+ * Reverse points-to needs every set, hence it is recorded on its first query.
+ */
+bool BVDataPTAImpl::readFromBinaryFile(const string& filename) {
+    outs() << "Loading pointer analysis results from '" << filename << "'...";
+
+    std::unique_ptr<PTAResultFileReader> reader(new PTAResultFileReader());
+    if (!reader->open(filename)) {
+        outs() << "  error opening file for reading!\n";
+        return false;
+    }
+
+    // Read PAG offset nodes
+    for (u64_t i = 0, e = reader->getNumOfGepObjs(); i != e; ++i) {
+        const PTAResultFile::GepObjEntry& entry = reader->getGepObj(i);
+        NodeID n = pag->getGepObjNode(pag->getObject(entry.base), LocationSet((Size_t)entry.offset));
+        assert(entry.id == n && "Error adding GepObjNode into PAG!");
+    }
+
+    // Read field-insensitive objects
+    for (u64_t i = 0, e = reader->getNumOfFIObjs(); i != e; ++i)
+        setObjFieldInsensitive(reader->getFIObj(i));
+
+    // Points-to sets are read when accessed, except those of variables
+    // which already have one
+    for (u64_t i = 0, e = reader->getNumOfVars(); i != e; ++i) {
+        NodeID var = reader->getVar(i);
+        if (ptD->getPtsMap().count(var) == 0) {
+            ptD->addLazyPts(var, reader.get());
+            continue;
+        }
+        if (!reader->readPtsAt(i, ptD->getPts(var)))
+            wrnMsg("corrupted points-to set in binary points-to result file");
+    }
+    ptsFile = std::move(reader);
+    ptsFileRevPending = true;
+
+    // Update callgraph
+    updateCallGraph(pag->getIndirectCallsites());
+
+    outs() << "\n";
+    return true;
+}
+
+/*!
+ * Record the reverse points-to of the sets in the binary result file,
+ * which decodes all of them
+ */
+void BVDataPTAImpl::loadRevPtsOfFile() {
+    ptsFileRevPending = false;
+    for (u64_t i = 0, e = ptsFile->getNumOfVars(); i != e; ++i) {
+        NodeID var = ptsFile->getVar(i);
+        ptD->updateRevPts(var, ptD->getPts(var));
+    }
+}
+
+/*!
+ * Store pointer analysis result in the text format "var -> { obj1 obj2 ... }"
+ */
+void BVDataPTAImpl::writeToTextFile(const string& filename) {
     outs() << "Storing pointer analysis results to '" << filename << "'...";
 
     error_code err;
@@ -380,11 +556,11 @@ void BVDataPTAImpl::writeToFile(const string& filename) {
 }
 
 /*!
- * Load pointer analysis result form a file.
+ * Load pointer analysis result form a text file.
  * It populates BVDataPTAImpl with the points-to data, and updates PAG with
  * the PAG offset nodes created during Andersen's solving stage.
  */
-bool BVDataPTAImpl::readFromFile(const string& filename) {
+bool BVDataPTAImpl::readFromTextFile(const string& filename) {
     outs() << "Loading pointer analysis results from '" << filename << "'...";
 
     ifstream F(filename.c_str());
@@ -0,0 +1,273 @@
+//===- PointsToTable.cpp -- Hash-consed points-to sets -----------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PointsToTable.cpp
+ */
+
+#include "MemoryModel/PointsToTable.h"
+
+static llvm::cl::opt<u32_t> PtsMemoLimit("pts-memo-limit",  llvm::cl::init(1 << 20),
+        llvm::cl::desc("Maximum number of memoised points-to operations kept before the memo tables are flushed"));
+
+/*!
+ * Constructor, ID 0 is the empty set
+ */
+PointsToTable::PointsToTable(): numOfRefs(0), numOfMemoRefs(0), numOfMemoHits(0), numOfMemoMisses(0) {
+    entries.push_back(Entry());
+    entries.back().hash = hashPts(entries.back().pts);
+    entries.back().refCount = 1;
+    entries.back().memoRefCount = 0;
+}
+
+PointsToTable& PointsToTable::getTable() {
+    static PointsToTable table;
+    return table;
+}
+
+/*!
+ * Sets whose references are all held by the memo tables are not shared by
+ * any points-to map entry, so they are left out
+ */
+double PointsToTable::getSharingRatio() const {
+    u32_t distinct = 0;
+    for (PtsID id = 1; id < entries.size(); ++id) {
+        if (entries[id].refCount > entries[id].memoRefCount)
+            distinct++;
+    }
+    return distinct == 0 ? 0 : (double)getNumOfPtsRefs() / distinct;
+}
+
+/*!
+ * Hash of the elements of a set
+ */
+size_t PointsToTable::hashPts(const PointsTo& pts) {
+    size_t hash = 0;
+    for (PointsTo::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it)
+        hash ^= *it + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+/*!
+ * Return the ID of pts with one reference added
+ */
+PointsToTable::PtsID PointsToTable::intern(const PointsTo& pts) {
+    if (pts.empty())
+        return EmptyPts;
+
+    size_t hash = hashPts(pts);
+    auto range = hashToIDs.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (entries[it->second].pts == pts) {
+            retain(it->second);
+            return it->second;
+        }
+    }
+
+    PtsID id;
+    if (freeIDs.empty()) {
+        id = entries.size();
+        entries.push_back(Entry());
+    }
+    else {
+        id = freeIDs.back();
+        freeIDs.pop_back();
+    }
+    Entry& entry = entries[id];
+    entry.pts = pts;
+    entry.hash = hash;
+    entry.refCount = 1;
+    entry.memoRefCount = 0;
+    numOfRefs++;
+    hashToIDs.insert(std::make_pair(hash, id));
+    return id;
+}
+
+/*!
+ * Drop a reference, the set is freed when no reference is left
+ */
+void PointsToTable::release(PtsID id) {
+    if (id == EmptyPts)
+        return;
+    Entry& entry = entries[id];
+    assert(entry.refCount > 0 && "release a freed points-to set!");
+    numOfRefs--;
+    if (--entry.refCount != 0)
+        return;
+
+    auto range = hashToIDs.equal_range(entry.hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == id) {
+            hashToIDs.erase(it);
+            break;
+        }
+    }
+    entry.pts.clear();
+    freeIDs.push_back(id);
+}
+
+/*!
+ * Look up a memoised result
+ */
+bool PointsToTable::lookupMemo(MemoMap& memo, PtsID lhs, PtsID rhs, PtsID& res) {
+    MemoMap::const_iterator it = memo.find(std::make_pair(lhs, rhs));
+    if (it == memo.end()) {
+        numOfMemoMisses++;
+        return false;
+    }
+    numOfMemoHits++;
+    res = it->second;
+    retain(res);
+    return true;
+}
+
+/*!
+ * Memoise a result. The memo tables hold references to the operands and the
+ * result, so that none of their IDs can be freed and reused by another set.
+ */
+void PointsToTable::addMemo(MemoMap& memo, PtsID lhs, PtsID rhs, PtsID res) {
+    if (unionMemo.size() + intersectMemo.size() + complementMemo.size() >= PtsMemoLimit)
+        clearMemo();
+    retainMemo(lhs);
+    retainMemo(rhs);
+    retainMemo(res);
+    memo[std::make_pair(lhs, rhs)] = res;
+}
+
+void PointsToTable::retainMemo(PtsID id) {
+    if (id == EmptyPts)
+        return;
+    retain(id);
+    entries[id].memoRefCount++;
+    numOfMemoRefs++;
+}
+
+void PointsToTable::releaseMemo(PtsID id) {
+    if (id == EmptyPts)
+        return;
+    assert(entries[id].memoRefCount > 0 && "release a memo reference not held!");
+    entries[id].memoRefCount--;
+    numOfMemoRefs--;
+    release(id);
+}
+
+/*!
+ * Release the references held by the memo tables
+ */
+void PointsToTable::clearMemo() {
+    MemoMap* memos[] = {&unionMemo, &intersectMemo, &complementMemo};
+    for (MemoMap* memo : memos) {
+        for (MemoMap::const_iterator it = memo->begin(), eit = memo->end(); it != eit; ++it) {
+            releaseMemo(it->first.first);
+            releaseMemo(it->first.second);
+            releaseMemo(it->second);
+        }
+        memo->clear();
+    }
+}
+
+/*!
+ * Union, operands are ordered as the operation is commutative
+ */
+PointsToTable::PtsID PointsToTable::unionPts(PtsID lhs, PtsID rhs) {
+    if (lhs == rhs || rhs == EmptyPts) {
+        retain(lhs);
+        return lhs;
+    }
+    if (lhs == EmptyPts) {
+        retain(rhs);
+        return rhs;
+    }
+    if (lhs > rhs)
+        std::swap(lhs, rhs);
+
+    PtsID res;
+    if (lookupMemo(unionMemo, lhs, rhs, res))
+        return res;
+    PointsTo pts = getPts(lhs);
+    pts |= getPts(rhs);
+    res = intern(pts);
+    addMemo(unionMemo, lhs, rhs, res);
+    return res;
+}
+
+/*!
+ * Intersection, operands are ordered as the operation is commutative
+ */
+PointsToTable::PtsID PointsToTable::intersectPts(PtsID lhs, PtsID rhs) {
+    if (lhs == rhs) {
+        retain(lhs);
+        return lhs;
+    }
+    if (lhs == EmptyPts || rhs == EmptyPts)
+        return EmptyPts;
+    if (lhs > rhs)
+        std::swap(lhs, rhs);
+
+    PtsID res;
+    if (lookupMemo(intersectMemo, lhs, rhs, res))
+        return res;
+    PointsTo pts = getPts(lhs);
+    pts &= getPts(rhs);
+    res = intern(pts);
+    addMemo(intersectMemo, lhs, rhs, res);
+    return res;
+}
+
+/*!
+ * Complement lhs - rhs
+ */
+PointsToTable::PtsID PointsToTable::complementPts(PtsID lhs, PtsID rhs) {
+    if (lhs == rhs || lhs == EmptyPts)
+        return EmptyPts;
+    if (rhs == EmptyPts) {
+        retain(lhs);
+        return lhs;
+    }
+
+    PtsID res;
+    if (lookupMemo(complementMemo, lhs, rhs, res))
+        return res;
+    PointsTo pts;
+    pts.intersectWithComplement(getPts(lhs), getPts(rhs));
+    res = intern(pts);
+    addMemo(complementMemo, lhs, rhs, res);
+    return res;
+}
+
+/*!
+ * Add a single element
+ */
+PointsToTable::PtsID PointsToTable::addElement(PtsID id, NodeID elem) {
+    PointsTo pts = getPts(id);
+    pts.set(elem);
+    return intern(pts);
+}
+
+/*!
+ * Remove a single element
+ */
+PointsToTable::PtsID PointsToTable::removeElement(PtsID id, NodeID elem) {
+    PointsTo pts = getPts(id);
+    pts.reset(elem);
+    return intern(pts);
+}
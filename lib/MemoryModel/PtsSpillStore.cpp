@@ -0,0 +1,280 @@
+//===- PtsSpillStore.cpp -- Out-of-core storage of points-to sets------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PtsSpillStore.cpp
+ */
+
+#include "MemoryModel/PtsSpillStore.h"
+#include "Util/SVFUtil.h"
+#include <algorithm>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace SVFUtil;
+
+static llvm::cl::opt<unsigned> PtsMemBudget("pts-mem-budget",  llvm::cl::init(0),
+        llvm::cl::value_desc("MB"),
+        llvm::cl::desc("Spill cold points-to sets when the resident memory exceeds the budget (0: no budget)"));
+
+static llvm::cl::opt<std::string> PtsSpillDir("pts-spill-dir",  llvm::cl::init(""),
+        llvm::cl::value_desc("dir"),
+        llvm::cl::desc("Spill points-to sets to a file in the directory instead of compressing them in memory"));
+
+/// Encodings of a spilled set
+enum SpillEncoding {
+    MemberList,		///< number of members, then the deltas of the members
+    ElementList		///< number of elements, then the index delta and the two words of each element
+};
+
+/// Estimated memory held by an element of a PointsTo, including its list links and malloc overhead
+static const u64_t ElementBytes = 48;
+
+/// Largest and smallest address range reserved for the arena
+static const u64_t MaxArenaSize = (u64_t)1 << 40;
+static const u64_t MinArenaSize = (u64_t)1 << 28;
+/// The spill file grows by at least this size
+static const u64_t FileGrowth = (u64_t)64 << 20;
+
+/// Variable-length integers, 7 bits per byte
+//@{
+static inline u32_t sizeOfVarInt(u64_t v) {
+    u32_t n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+static inline void writeVarInt(std::vector<unsigned char>& buf, u64_t v) {
+    while (v >= 0x80) {
+        buf.push_back((unsigned char)(v | 0x80));
+        v >>= 7;
+    }
+    buf.push_back((unsigned char)v);
+}
+static inline u64_t readVarInt(const unsigned char*& p) {
+    u64_t v = 0;
+    for (u32_t shift = 0;; shift += 7) {
+        unsigned char b = *p++;
+        v |= (u64_t)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0)
+            return v;
+    }
+}
+//@}
+
+static inline void writeWord(std::vector<unsigned char>& buf, u64_t w) {
+    for (u32_t i = 0; i < 8; ++i)
+        buf.push_back((unsigned char)(w >> (i * 8)));
+}
+static inline u64_t readWord(const unsigned char*& p) {
+    u64_t w = 0;
+    for (u32_t i = 0; i < 8; ++i)
+        w |= (u64_t)(*p++) << (i * 8);
+    return w;
+}
+
+/*!
+ * Reserve the address range of the arena, backed by a file in dir if given
+ */
+PtsSpillStore::PtsSpillStore(const std::string& dir): base(NULL), capacity(0), committed(0), used(0),
+    written(0), fd(-1), numOfChecks(0), numOfSpills(0), numOfFaults(0), numOfRounds(0), releasedBytes(0) {
+    if (!dir.empty()) {
+        std::string path = dir + "/svf-pts-spill-XXXXXX";
+        std::vector<char> name(path.begin(), path.end());
+        name.push_back('\0');
+        fd = mkstemp(&name[0]);
+        if (fd >= 0)
+            unlink(&name[0]);
+        else
+            wrnMsg("can not create a spill file in " + dir + ", points-to sets are compressed in memory");
+    }
+
+    for (u64_t size = MaxArenaSize; size >= MinArenaSize && base == NULL; size >>= 1) {
+        void* p = (fd >= 0) ? mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_NORESERVE, fd, 0)
+                  : mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (p != MAP_FAILED) {
+            base = (unsigned char*)p;
+            capacity = size;
+        }
+    }
+    if (base == NULL)
+        wrnMsg("can not reserve memory for spilling points-to sets");
+}
+
+PtsSpillStore::~PtsSpillStore() {
+    if (base)
+        munmap(base, capacity);
+    if (fd >= 0)
+        close(fd);
+}
+
+PtsSpillStore* PtsSpillStore::create() {
+    if (PtsMemBudget == 0)
+        return NULL;
+    return new PtsSpillStore(PtsSpillDir);
+}
+
+/*!
+ * Compare the resident memory with the budget, a tenth of the budget is released
+ * in addition to the excess so that spilling is not triggered again right away
+ */
+bool PtsSpillStore::isOverBudget(u64_t& overBytes) {
+    u32_t vmrss, vmsize;
+    if (PtsMemBudget == 0 || !getMemoryUsageKB(&vmrss, &vmsize))
+        return false;
+    u64_t budgetKB = (u64_t)PtsMemBudget * 1024;
+    if (vmrss <= budgetKB)
+        return false;
+    overBytes = (vmrss - budgetKB + budgetKB / 10) * 1024;
+    return true;
+}
+
+bool PtsSpillStore::reserve(u64_t size) {
+    if (base == NULL || used + size > capacity)
+        return false;
+    if (fd < 0 || used + size <= committed)
+        return true;
+    u64_t newSize = std::min(capacity, std::max(committed + FileGrowth, std::max(committed * 2, used + size)));
+    if (ftruncate(fd, newSize) != 0)
+        return false;
+    committed = newSize;
+    return true;
+}
+
+/*!
+ * Encode the members of pts, or its elements if they are denser
+ */
+bool PtsSpillStore::spill(const PointsTo& pts, Slot& slot, u64_t& released) {
+    buffer.clear();
+
+    u32_t numOfMembers = 0;
+    u64_t memberBytes = 0;
+    std::vector<u64_t> elements;	// index, word0, word1 of each element
+    u32_t prev = 0;
+    for (PointsTo::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it) {
+        u32_t member = *it;
+        memberBytes += sizeOfVarInt(member - prev);
+        prev = member;
+        numOfMembers++;
+
+        u64_t idx = member / 128;
+        if (elements.empty() || elements[elements.size() - 3] != idx) {
+            elements.push_back(idx);
+            elements.push_back(0);
+            elements.push_back(0);
+        }
+        elements[elements.size() - 2 + (member % 128) / 64] |= (u64_t)1 << (member % 64);
+    }
+    u32_t numOfElements = elements.size() / 3;
+
+    if (memberBytes <= (u64_t)numOfElements * 17) {
+        buffer.push_back(MemberList);
+        writeVarInt(buffer, numOfMembers);
+        prev = 0;
+        for (PointsTo::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it) {
+            writeVarInt(buffer, *it - prev);
+            prev = *it;
+        }
+    }
+    else {
+        buffer.push_back(ElementList);
+        writeVarInt(buffer, numOfElements);
+        u64_t prevIdx = 0;
+        for (u32_t i = 0; i < elements.size(); i += 3) {
+            writeVarInt(buffer, elements[i] - prevIdx);
+            prevIdx = elements[i];
+            writeWord(buffer, elements[i + 1]);
+            writeWord(buffer, elements[i + 2]);
+        }
+    }
+
+    if (!reserve(buffer.size()))
+        return false;
+    memcpy(base + used, &buffer[0], buffer.size());
+    slot.offset = used;
+    slot.size = buffer.size();
+    used += buffer.size();
+
+    numOfSpills++;
+    released += (u64_t)numOfElements * ElementBytes;
+    releasedBytes += (u64_t)numOfElements * ElementBytes;
+    return true;
+}
+
+/*!
+ * Members are set in ascending order, which is linear for PointsTo
+ */
+void PtsSpillStore::fault(const Slot& slot, PointsTo& pts) {
+    const unsigned char* p = base + slot.offset;
+    numOfFaults++;
+
+    if (*p++ == MemberList) {
+        u64_t num = readVarInt(p);
+        u32_t member = 0;
+        for (u64_t i = 0; i < num; ++i) {
+            member += readVarInt(p);
+            pts.set(member);
+        }
+    }
+    else {
+        u64_t num = readVarInt(p);
+        u64_t idx = 0;
+        for (u64_t i = 0; i < num; ++i) {
+            idx += readVarInt(p);
+            for (u32_t w = 0; w < 2; ++w) {
+                u64_t word = readWord(p);
+                for (u32_t b = 0; word != 0; ++b, word >>= 1) {
+                    if (word & 1)
+                        pts.set(idx * 128 + w * 64 + b);
+                }
+            }
+        }
+    }
+    assert(p == base + slot.offset + slot.size && "corrupted spilled points-to set");
+}
+
+/*!
+ * Write back the completed pages of the spill file and drop them from memory,
+ * they are read back from the file when a set on them is faulted
+ */
+void PtsSpillStore::endRound() {
+    numOfRounds++;
+    if (fd >= 0) {
+        u64_t pageSize = sysconf(_SC_PAGESIZE);
+        u64_t start = written & ~(pageSize - 1);
+        u64_t end = used & ~(pageSize - 1);
+        if (end > start && msync(base + start, end - start, MS_SYNC) == 0) {
+            madvise(base + start, end - start, MADV_DONTNEED);
+            written = end;
+        }
+    }
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
@@ -207,6 +207,17 @@ void ProgSlice::annotatePaths() {
     }
 }
 
+void ProgSlice::transferConds(PathCondAllocator* pa) {
+    SVFGNodeToCondMap sinkConds;
+    for(SVFGNodeSetIter it = sinksBegin(), eit = sinksEnd(); it!=eit; ++it) {
+        SVFGNodeToCondMap::const_iterator cit = svfgNodeToCondMap.find(*it);
+        if(cit!=svfgNodeToCondMap.end())
+            sinkConds[*it] = pa->transferCond(cit->second, pathAllocator);
+    }
+    svfgNodeToCondMap.swap(sinkConds);
+    finalCond = pa->transferCond(finalCond, pathAllocator);
+    pathAllocator = pa;
+}
 
 void ProgSlice::destroy() {
     /// TODO: how to clean bdd memory
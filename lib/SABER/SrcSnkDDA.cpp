@@ -30,6 +30,7 @@
 
 #include "SABER/SrcSnkDDA.h"
 #include "MSSA/SVFGStat.h"
+#include "Util/ParallelUtil.h"
 
 using namespace SVFUtil;
 
@@ -39,55 +40,151 @@ static llvm::cl::opt<bool> DumpSlice("dump-slice", llvm::cl::init(false),
 static llvm::cl::opt<unsigned> cxtLimit("cxtlimit",  llvm::cl::init(3),
                                   llvm::cl::desc("Source-Sink Analysis Contexts Limit"));
 
+static llvm::cl::opt<u32_t> SaberThreads("saber-threads",  llvm::cl::init(1),
+        llvm::cl::desc("Number of threads computing source-sink slices (0: all hardware threads)"));
+
+/*!
+ * Sources are processed in batches. The slices of a batch and their guards
+ * are computed concurrently, then bugs are reported in the order of the
+ * sources, so that the reports do not depend on the number of threads.
+ * Each thread computes guards with a worker of the path allocator, which has
+ * its own BDD manager, and the final conditions are transferred back to the
+ * path allocator for reporting.
+ */
 void SrcSnkDDA::analyze(SVFModule module) {
 
     initialize(module);
 
     ContextCond::setMaxCxtLen(cxtLimit);
 
-    for (SVFGNodeSetIter iter = sourcesBegin(), eiter = sourcesEnd();
-            iter != eiter; ++iter) {
-        setCurSlice(*iter);
+    u32_t numOfThreads = getNumOfWorkerThreads(SaberThreads);
+    /// Slices of a batch are kept alive until they are reported
+    u32_t batchSize = numOfThreads == 1 ? 1 : numOfThreads * 8;
 
-        DBOUT(DGENERAL, outs() << "Analysing slice:" << (*iter)->getId() << ")\n");
-        ContextCond cxt;
-        DPIm item((*iter)->getId(),cxt);
-        forwardTraverse(item);
+    std::vector<PathCondAllocator*> allocators;
+    if (numOfThreads > 1) {
+        for (u32_t i = 0; i < numOfThreads; ++i)
+            allocators.push_back(getPathAllocator()->createWorker(module));
+    }
 
-        /// do not consider there is bug when reaching a global SVFGNode
-        /// if we touch a global, then we assume the client uses this memory until the program exits.
-        if (getCurSlice()->isReachGlobal()) {
-            DBOUT(DSaber, outs() << "Forward analysis reaches globals for slice:" << (*iter)->getId() << ")\n");
+    SVFGNodeVector srcs(sourcesBegin(), sourcesEnd());
+    std::vector<ProgSlice*> slices;
+    for (u32_t begin = 0; begin < srcs.size(); begin += batchSize) {
+        u32_t end = std::min<u32_t>(begin + batchSize, srcs.size());
+
+        slices.clear();
+        for (u32_t i = begin; i < end; ++i)
+            slices.push_back(new ProgSlice(srcs[i], getPathAllocator(), getSVFG()));
+
+        /// Slicing only reads the SVFG, the sources and the sinks
+        parallelFor(slices.size(), numOfThreads, [&](u32_t i, u32_t tid) {
+            PhaseProfiler::Scope phase("SABER slicing");
+            if (PhaseProfiler::isEnabled())
+                phase.addCounter("source", slices[i]->getSource()->getId());
+            SrcSnkSliceSolver solver(this, slices[i]);
+            solver.solve();
+        }, 1);
+
+        if (numOfThreads > 1) {
+            parallelFor(slices.size(), numOfThreads, [&](u32_t i, u32_t tid) {
+                if (slices[i]->isReachGlobal())
+                    return;
+                PhaseProfiler::Scope phase("SABER guards");
+                if (PhaseProfiler::isEnabled())
+                    phase.addCounter("source", slices[i]->getSource()->getId());
+                slices[i]->transferConds(allocators[tid]);
+                solveGuards(slices[i]);
+            }, 1);
         }
-        else {
-            DBOUT(DSaber, outs() << "Forward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getForwardSliceSize() << ")\n");
-
-            for (SVFGNodeSetIter sit = getCurSlice()->sinksBegin(), esit =
-                        getCurSlice()->sinksEnd(); sit != esit; ++sit) {
-                ContextCond cxt;
-                DPIm item((*sit)->getId(),cxt);
-                backwardTraverse(item);
-            }
 
-            DBOUT(DSaber, outs() << "Backward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getBackwardSliceSize() << ")\n");
+        for (std::vector<ProgSlice*>::const_iterator it = slices.begin(), eit = slices.end(); it != eit; ++it) {
+            setCurSlice(*it);
 
-            AllPathReachability();
+            /// do not consider there is bug when reaching a global SVFGNode
+            /// if we touch a global, then we assume the client uses this memory until the program exits.
+            if (getCurSlice()->isReachGlobal()) {
+                DBOUT(DSaber, outs() << "Forward analysis reaches globals for slice:" << (*it)->getSource()->getId() << ")\n");
+            }
+            else {
+                if (numOfThreads > 1) {
+                    (*it)->transferConds(getPathAllocator());
+                    if (DumpSlice)
+                        annotateSlice(*it);
+                }
+                else {
+                    PhaseProfiler::Scope phase("SABER guards");
+                    if (PhaseProfiler::isEnabled())
+                        phase.addCounter("source", (*it)->getSource()->getId());
+                    AllPathReachability();
+                }
+
+                DBOUT(DSaber, outs() << "Guard computation for slice:" << (*it)->getSource()->getId() << ")\n");
+            }
 
-            DBOUT(DSaber, outs() << "Guard computation for slice:" << (*iter)->getId() << ")\n");
-        }
+            reportBug(getCurSlice());
 
-        reportBug(getCurSlice());
+            setCurSlice(NULL);
+            delete *it;
+        }
     }
 
+    for (std::vector<PathCondAllocator*>::const_iterator it = allocators.begin(), eit = allocators.end(); it != eit; ++it)
+        delete *it;
+
     finalize();
 }
 
+/*!
+ * Constructor
+ */
+SrcSnkSliceSolver::SrcSnkSliceSolver(SrcSnkDDA* d, ProgSlice* s): dda(d), slice(s) {
+    setGraph(const_cast<SVFG*>(dda->getSVFG()));
+}
+
+/*!
+ * Compute the forward and backward slices of a source
+ */
+void SrcSnkSliceSolver::solve() {
+    const SVFGNode* source = slice->getSource();
+
+    DBOUT(DGENERAL, outs() << "Analysing slice:" << source->getId() << ")\n");
+    ContextCond cxt;
+    DPIm item(source->getId(),cxt);
+    forwardTraverse(item);
+
+    if (slice->isReachGlobal())
+        return;
+
+    DBOUT(DSaber, outs() << "Forward process for slice:" << source->getId() << " (size = " << slice->getForwardSliceSize() << ")\n");
+
+    for (SVFGNodeSetIter sit = slice->sinksBegin(), esit = slice->sinksEnd(); sit != esit; ++sit) {
+        ContextCond cxt;
+        DPIm item((*sit)->getId(),cxt);
+        backwardTraverse(item);
+    }
+
+    DBOUT(DSaber, outs() << "Backward process for slice:" << source->getId() << " (size = " << slice->getBackwardSliceSize() << ")\n");
+}
+
+/*!
+ * Forward traverse
+ */
+void SrcSnkSliceSolver::forwardProcess(const DPIm& item) {
+    const SVFGNode* node = getNode(item.getCurNodeID());
+    if(dda->isSink(node)) {
+        slice->addToSinks(node);
+        slice->addToForwardSlice(node);
+        slice->setPartialReachable();
+    }
+    else
+        slice->addToForwardSlice(node);
+}
 
 /*!
  * Propagate information forward by matching context
  */
-void SrcSnkDDA::forwardpropagate(const DPIm& item, SVFGEdge* edge) {
-    DBOUT(DSaber,outs() << "\n##processing source: " << getCurSlice()->getSource()->getId() <<" forward propagate from (" << edge->getSrcID());
+void SrcSnkSliceSolver::forwardpropagate(const DPIm& item, SVFGEdge* edge) {
+    DBOUT(DSaber,outs() << "\n##processing source: " << slice->getSource()->getId() <<" forward propagate from (" << edge->getSrcID());
 
     // for indirect SVFGEdge, the propagation should follow the def-use chains
     // points-to on the edge indicate whether the object of source node can be propagated
@@ -96,8 +193,8 @@ void SrcSnkDDA::forwardpropagate(const DPIm& item, SVFGEdge* edge) {
     DPIm newItem(dstNode->getId(),item.getContexts());
 
     /// handle globals here
-    if(isGlobalSVFGNode(dstNode) || getCurSlice()->isReachGlobal()) {
-        getCurSlice()->setReachGlobal();
+    if(dda->isGlobalSVFGNode(dstNode) || slice->isReachGlobal()) {
+        slice->setReachGlobal();
         return;
     }
 
@@ -145,7 +242,7 @@ void SrcSnkDDA::forwardpropagate(const DPIm& item, SVFGEdge* edge) {
 /*!
  * Propagate information backward without matching context, as forward analysis already did it
  */
-void SrcSnkDDA::backwardpropagate(const DPIm& item, SVFGEdge* edge) {
+void SrcSnkSliceSolver::backwardpropagate(const DPIm& item, SVFGEdge* edge) {
     DBOUT(DSaber,outs() << "backward propagate from (" << edge->getDstID() << " --> " << edge->getSrcID() << ")\n");
     const SVFGNode* srcNode = edge->getSrcNode();
     if(backwardVisited(srcNode))
@@ -164,21 +261,15 @@ void SrcSnkDDA::AllPathReachability() {
     if(DumpSlice)
         annotateSlice(_curSlice);
 
-    _curSlice->AllPathReachableSolve();
-
-    if(isSatisfiableForAll(_curSlice)== true)
-        _curSlice->setAllReachable();
+    solveGuards(_curSlice);
 }
 
-/// Set current slice
-void SrcSnkDDA::setCurSlice(const SVFGNode* src) {
-    if(_curSlice!=NULL) {
-        delete _curSlice;
-        _curSlice = NULL;
-        clearVisitedMap();
-    }
+/// Compute the guards of a slice, which does not depend on the current slice
+void SrcSnkDDA::solveGuards(ProgSlice* slice) {
+    slice->AllPathReachableSolve();
 
-    _curSlice = new ProgSlice(src,getPathAllocator(), getSVFG());
+    if(isSatisfiableForAll(slice)== true)
+        slice->setAllReachable();
 }
 
 void SrcSnkDDA::annotateSlice(ProgSlice* slice) {
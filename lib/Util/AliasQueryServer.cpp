@@ -0,0 +1,362 @@
+//===- AliasQueryServer.cpp -- Resident server of alias queries--------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+
+/*
+ * AliasQueryServer.cpp
+ */
+
+#include "Util/AliasQueryServer.h"
+#include "Util/SVFUtil.h"
+#include "Util/CPPUtil.h"
+#include "MemoryModel/PointerAnalysis.h"
+#include <sstream>
+#include <algorithm>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <signal.h>
+#include <unistd.h>
+#include <string.h>
+
+using namespace SVFUtil;
+
+static llvm::cl::opt<bool> QueryServer("query-server", llvm::cl::init(false),
+                                       llvm::cl::desc("Keep the analysis resident and answer alias queries after it"));
+
+static llvm::cl::opt<std::string> QuerySocket("query-socket",  llvm::cl::init(""),
+        llvm::cl::value_desc("path"),
+        llvm::cl::desc("UNIX socket of the query server (stdin/stdout if not given)"));
+
+bool AliasQueryServer::isEnabled() {
+    return QueryServer;
+}
+
+/// Remove a socket left by a previous server, other files are kept
+static void unlinkSocket(const std::string& path) {
+    struct stat st;
+    if (lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode))
+        unlink(path.c_str());
+}
+
+/*!
+ * Serve stdin/stdout, or clients connected to the socket one after another
+ * until one of them asks to quit
+ */
+void AliasQueryServer::run() {
+    /// a client closing its connection early must not kill the server on the next write
+    struct sigaction ignore, saved;
+    memset(&ignore, 0, sizeof(ignore));
+    ignore.sa_handler = SIG_IGN;
+    sigaction(SIGPIPE, &ignore, &saved);
+    runServer();
+    sigaction(SIGPIPE, &saved, NULL);
+}
+
+void AliasQueryServer::runServer() {
+    if (QuerySocket.empty()) {
+        serve(STDIN_FILENO, STDOUT_FILENO);
+        return;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (QuerySocket.size() >= sizeof(addr.sun_path)) {
+        errs() << errMsg("query socket path is too long: ") << QuerySocket << "\n";
+        return;
+    }
+    strncpy(addr.sun_path, QuerySocket.c_str(), sizeof(addr.sun_path) - 1);
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlinkSocket(QuerySocket);
+    if (sock < 0 || bind(sock, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(sock, 1) != 0) {
+        errs() << errMsg("can not listen on query socket ") << QuerySocket << "\n";
+        if (sock >= 0)
+            close(sock);
+        return;
+    }
+
+    outs() << pasMsg("Query server listening on ") << QuerySocket << "\n";
+    outs().flush();
+    bool quit = false;
+    while (!quit) {
+        int client = accept(sock, NULL, NULL);
+        if (client < 0)
+            break;
+        quit = serve(client, client);
+        close(client);
+    }
+    close(sock);
+    unlinkSocket(QuerySocket);
+}
+
+/*!
+ * Answer the request lines read from inFd
+ */
+bool AliasQueryServer::serve(int inFd, int outFd) {
+    std::string buffer;
+    char chunk[4096];
+    while (true) {
+        std::string::size_type pos;
+        while ((pos = buffer.find('\n')) != std::string::npos) {
+            std::string line = buffer.substr(0, pos);
+            buffer.erase(0, pos + 1);
+            if (!line.empty() && line[line.size() - 1] == '\r')
+                line.erase(line.size() - 1);
+            if (line.empty())
+                continue;
+
+            std::string response = answer(line);
+            bool quit = (line == "quit");
+            response += "\n";
+            outs().flush();
+            for (size_t written = 0; written < response.size();) {
+                ssize_t n = write(outFd, response.data() + written, response.size() - written);
+                if (n <= 0)
+                    return false;
+                written += n;
+            }
+            if (quit)
+                return true;
+        }
+
+        ssize_t n = read(inFd, chunk, sizeof(chunk));
+        if (n <= 0)
+            return false;
+        buffer.append(chunk, n);
+    }
+}
+
+/*!
+ * Answer a request line
+ */
+std::string AliasQueryServer::answer(const std::string& request) {
+    std::vector<std::string> args;
+    std::istringstream ss(request);
+    std::string word;
+    while (ss >> word)
+        args.push_back(word);
+    if (args.empty())
+        return "error empty request";
+
+    const std::string& cmd = args[0];
+    if (cmd == "pts")
+        return answerPts(args);
+    else if (cmd == "alias")
+        return answerAlias(args);
+    else if (cmd == "callees")
+        return answerCallees(args);
+    else if (cmd == "mhp")
+        return answerMHP(args);
+    else if (cmd == "quit")
+        return "ok";
+    return "error unknown request " + cmd;
+}
+
+/*!
+ * Demand-driven analyses compute points-to of top-level pointers only,
+ * other nodes are answered by the fallback analysis
+ */
+PointerAnalysis* AliasQueryServer::getPTA(NodeID id) {
+    PAG* pag = pta->getPAG();
+    if (!pag->isValidTopLevelPtr(pag->getPAGNode(id)) && fallback)
+        return fallback;
+    pta->computeDDAPts(id);
+    return pta;
+}
+
+/*!
+ * Argument or instruction fun:%name, or instruction fun:#n
+ */
+const Value* AliasQueryServer::resolveLocal(const std::string& ref) {
+    std::string::size_type colon = ref.find(':');
+    if (colon == std::string::npos || colon + 1 >= ref.size())
+        return NULL;
+    const Function* fun = pta->getModule().getFunction(ref.substr(0, colon));
+    if (fun == NULL || fun->isDeclaration())
+        return NULL;
+
+    char kind = ref[colon + 1];
+    std::string name = ref.substr(colon + 2);
+    if (kind == '#') {
+        std::istringstream ss(name);
+        u32_t n;
+        if (!(ss >> n) || !ss.eof())
+            return NULL;
+        for (const_inst_iterator it = inst_begin(fun), eit = inst_end(fun); it != eit; ++it, --n) {
+            if (n == 0)
+                return &*it;
+        }
+        return NULL;
+    }
+    if (kind != '%')
+        return NULL;
+    for (Function::const_arg_iterator it = fun->arg_begin(), eit = fun->arg_end(); it != eit; ++it) {
+        if (it->getName() == name)
+            return &*it;
+    }
+    for (const_inst_iterator it = inst_begin(fun), eit = inst_end(fun); it != eit; ++it) {
+        if (it->getName() == name)
+            return &*it;
+    }
+    return NULL;
+}
+
+/*!
+ * PAG node ID, @global or a local reference
+ */
+bool AliasQueryServer::resolveValue(const std::string& ref, NodeID& id, std::string& err) {
+    PAG* pag = pta->getPAG();
+    if (isdigit(ref[0])) {
+        std::istringstream ss(ref);
+        if ((ss >> id) && ss.eof() && pag->hasGNode(id))
+            return true;
+        err = "unknown PAG node " + ref;
+        return false;
+    }
+
+    const Value* val = NULL;
+    if (ref[0] == '@') {
+        SVFModule module = pta->getModule();
+        for (u32_t i = 0; i < module.getModuleNum() && val == NULL; ++i)
+            val = module.getModule(i)->getNamedValue(ref.substr(1));
+    }
+    else
+        val = resolveLocal(ref);
+
+    if (val == NULL || !pag->hasValueNode(val)) {
+        err = "unknown value " + ref;
+        return false;
+    }
+    id = pag->getValueNode(val);
+    return true;
+}
+
+const Instruction* AliasQueryServer::resolveInst(const std::string& ref, std::string& err) {
+    const Instruction* inst = llvm::dyn_cast_or_null<Instruction>(resolveLocal(ref));
+    if (inst == NULL)
+        err = "unknown instruction " + ref;
+    return inst;
+}
+
+std::string AliasQueryServer::answerPts(const std::vector<std::string>& args) {
+    if (args.size() != 2)
+        return "error usage: pts <value>";
+    NodeID id;
+    std::string err;
+    if (!resolveValue(args[1], id, err))
+        return "error " + err;
+
+    const PointsTo& pts = getPTA(id)->getPts(id);
+    std::string response = "ok";
+    for (PointsTo::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it)
+        response += " " + llvm::utostr(*it);
+    return response;
+}
+
+/*!
+ * Both nodes are compared by the same analysis, the fallback one if
+ * pta can not answer either of them
+ */
+std::string AliasQueryServer::answerAlias(const std::vector<std::string>& args) {
+    if (args.size() != 3)
+        return "error usage: alias <value> <value>";
+    NodeID id1, id2;
+    std::string err;
+    if (!resolveValue(args[1], id1, err) || !resolveValue(args[2], id2, err))
+        return "error " + err;
+
+    PointerAnalysis* pta1 = getPTA(id1);
+    PointerAnalysis* pta2 = getPTA(id2);
+    PointerAnalysis* analysis = (pta1 == pta2) ? pta1 : fallback;
+    switch (analysis->alias(id1, id2)) {
+    case llvm::NoAlias:
+        return "ok NoAlias";
+    case llvm::MustAlias:
+        return "ok MustAlias";
+    case llvm::PartialAlias:
+        return "ok PartialAlias";
+    default:
+        return "ok MayAlias";
+    }
+}
+
+/*!
+ * Direct callee, or callees resolved from the points-to of the function
+ * pointer or the vtable pointer of an indirect callsite
+ */
+std::string AliasQueryServer::answerCallees(const std::vector<std::string>& args) {
+    if (args.size() != 2)
+        return "error usage: callees <inst>";
+    std::string err;
+    const Instruction* inst = resolveInst(args[1], err);
+    if (inst == NULL)
+        return "error " + err;
+    if (!isCallSite(inst))
+        return "error not a callsite " + args[1];
+
+    CallSite cs = getLLVMCallSite(inst);
+    PAG* pag = pta->getPAG();
+    PointerAnalysis::VFunSet callees;
+    if (const Function* callee = getCallee(cs))
+        callees.insert(callee);
+    else if (cppUtil::isVirtualCallSite(cs)) {
+        const Value* vtbl = cppUtil::getVCallVtblPtr(cs);
+        if (pag->hasValueNode(vtbl)) {
+            NodeID id = pag->getValueNode(vtbl);
+            pta->getVFnsFromPts(cs, getPTA(id)->getPts(id), callees);
+        }
+    }
+    else if (pag->isIndirectCallSites(cs)) {
+        NodeID id = pag->getFunPtr(cs);
+        const PointsTo& pts = getPTA(id)->getPts(id);
+        for (PointsTo::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it) {
+            const MemObj* obj = pag->getObject(*it);
+            if (obj && obj->isFunction())
+                callees.insert(SVFUtil::cast<Function>(obj->getRefVal()));
+        }
+    }
+
+    std::vector<std::string> names;
+    for (PointerAnalysis::VFunSet::const_iterator it = callees.begin(), eit = callees.end(); it != eit; ++it)
+        names.push_back((*it)->getName().str());
+    std::sort(names.begin(), names.end());
+
+    std::string response = "ok";
+    for (const std::string& name : names)
+        response += " " + name;
+    return response;
+}
+
+std::string AliasQueryServer::answerMHP(const std::vector<std::string>& args) {
+    if (args.size() != 3)
+        return "error usage: mhp <inst> <inst>";
+    if (!mhp)
+        return "error no may-happen-in-parallel analysis";
+    std::string err;
+    const Instruction* i1 = resolveInst(args[1], err);
+    const Instruction* i2 = i1 ? resolveInst(args[2], err) : NULL;
+    if (i2 == NULL)
+        return "error " + err;
+    return mhp(i1, i2) ? "ok true" : "ok false";
+}
@@ -0,0 +1,216 @@
+//===- AnalysisCache.cpp -- On-disk cache of analysis results----------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+
+/*
+ * AnalysisCache.cpp
+ */
+
+#include "Util/AnalysisCache.h"
+#include "Util/SVFUtil.h"
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+#include <unistd.h>
+#include <algorithm>
+
+using namespace SVFUtil;
+
+static llvm::cl::opt<std::string> AnalysisCacheDir("analysis-cache",  llvm::cl::init(""),
+        llvm::cl::value_desc("directory"),
+        llvm::cl::desc("Directory to store and reuse analysis results of the same input modules"));
+
+/// Hex MD5 of a string
+static std::string md5Of(StringRef data) {
+    llvm::MD5 hash;
+    hash.update(data);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> str;
+    llvm::MD5::stringifyResult(result, str);
+    return str.str().str();
+}
+
+bool AnalysisCache::isEnabled() {
+    return !AnalysisCacheDir.empty();
+}
+
+/*!
+ * Hash the bitcode of all modules, computed once as modules are not
+ * changed after they are loaded
+ */
+const std::string& AnalysisCache::getModuleHash(SVFModule module) {
+    static std::string moduleHash;
+    if (!moduleHash.empty())
+        return moduleHash;
+
+    LLVMModuleSet* modSet = module.getLLVMModuleSet();
+    std::string hashes;
+    for (u32_t i = 0; i < modSet->getModuleNum(); ++i) {
+        llvm::SmallVector<char, 0> buffer;
+        llvm::raw_svector_ostream OS(buffer);
+        WriteBitcodeToFile(modSet->getModuleRef(i), OS);
+        hashes += md5Of(StringRef(buffer.data(), buffer.size()));
+    }
+    moduleHash = md5Of(hashes);
+    return moduleHash;
+}
+
+/*!
+ * Values of the options that change how the PAG is built
+ */
+std::string AnalysisCache::getPAGOptions() {
+    static const char* boolOptions[] = {"preFieldSensitive", "vcall-cha", "blk", "locMM",
+                                        "modelConsts", "stride-only", "svfmain", "reachable-funs"
+                                       };
+    static const char* unsignedOptions[] = {"fieldlimit", "indCallLimit"};
+    static const char* listOptions[] = {"entry-funs"};
+
+    llvm::StringMap<llvm::cl::Option*>& opts = llvm::cl::getRegisteredOptions();
+    std::string str;
+    raw_string_ostream rawstr(str);
+    for (const char* name : boolOptions) {
+        llvm::StringMap<llvm::cl::Option*>::iterator it = opts.find(name);
+        if (it != opts.end())
+            rawstr << name << "=" << (bool)*static_cast<llvm::cl::opt<bool>*>(it->second) << ";";
+    }
+    for (const char* name : unsignedOptions) {
+        llvm::StringMap<llvm::cl::Option*>::iterator it = opts.find(name);
+        if (it != opts.end())
+            rawstr << name << "=" << (unsigned)*static_cast<llvm::cl::opt<unsigned>*>(it->second) << ";";
+    }
+    /// Values of a list are sorted as their order does not matter
+    for (const char* name : listOptions) {
+        llvm::StringMap<llvm::cl::Option*>::iterator it = opts.find(name);
+        if (it == opts.end())
+            continue;
+        llvm::cl::list<std::string>* list = static_cast<llvm::cl::list<std::string>*>(it->second);
+        std::vector<std::string> values(list->begin(), list->end());
+        std::sort(values.begin(), values.end());
+        rawstr << name << "=";
+        for (const std::string& value : values)
+            rawstr << value << ",";
+        rawstr << ";";
+    }
+    return rawstr.str();
+}
+
+/*!
+ * <dir>/<module hash>-<stage>-<option hash>
+ */
+std::string AnalysisCache::getArtifactPath(SVFModule module, const std::string& stage,
+        const std::string& stageOptions) {
+    return getPathInCache(getModuleHash(module) + "-" + stage + "-" + md5Of(getPAGOptions() + stageOptions));
+}
+
+/*!
+ * <dir>/<stage>-<option hash>
+ */
+std::string AnalysisCache::getStorePath(const std::string& stage, const std::string& stageOptions) {
+    return getPathInCache(stage + "-" + md5Of(getPAGOptions() + stageOptions));
+}
+
+std::string AnalysisCache::getPathInCache(const std::string& name) {
+    assert(isEnabled() && "analysis cache is not enabled!");
+    if (std::error_code err = llvm::sys::fs::create_directories(AnalysisCacheDir.getValue())) {
+        wrnMsg("cannot create analysis cache directory " + AnalysisCacheDir + ": " + err.message());
+    }
+    llvm::SmallString<256> path(AnalysisCacheDir.getValue());
+    llvm::sys::path::append(path, name);
+    return path.str().str();
+}
+
+/*!
+ * Hash the opcodes, types and operands of the instructions of a function.
+ * Arguments, blocks and instructions of the function are named by their
+ * positions, and other values by their names, so that the hash is not
+ * changed by renumbering or changes elsewhere in the module
+ */
+std::string AnalysisCache::getFunctionHash(const Function* fun) {
+    llvm::DenseMap<const Value*, u32_t> localIds;
+    u32_t id = 0;
+    for (Function::const_arg_iterator it = fun->arg_begin(), eit = fun->arg_end(); it != eit; ++it)
+        localIds[&*it] = id++;
+    for (Function::const_iterator bit = fun->begin(), ebit = fun->end(); bit != ebit; ++bit) {
+        localIds[&*bit] = id++;
+        for (BasicBlock::const_iterator it = bit->begin(), eit = bit->end(); it != eit; ++it)
+            localIds[&*it] = id++;
+    }
+
+    std::string str;
+    raw_string_ostream rawstr(str);
+    fun->getFunctionType()->print(rawstr);
+    rawstr << "\n";
+    for (Function::const_iterator bit = fun->begin(), ebit = fun->end(); bit != ebit; ++bit) {
+        for (BasicBlock::const_iterator it = bit->begin(), eit = bit->end(); it != eit; ++it) {
+            const Instruction& inst = *it;
+            rawstr << inst.getOpcodeName() << " ";
+            inst.getType()->print(rawstr);
+            if (const CmpInst* cmp = SVFUtil::dyn_cast<CmpInst>(&inst))
+                rawstr << " pred" << cmp->getPredicate();
+            else if (const AllocaInst* alloca = SVFUtil::dyn_cast<AllocaInst>(&inst)) {
+                rawstr << " ";
+                alloca->getAllocatedType()->print(rawstr);
+            }
+            else if (const GetElementPtrInst* gep = SVFUtil::dyn_cast<GetElementPtrInst>(&inst)) {
+                rawstr << " ";
+                gep->getSourceElementType()->print(rawstr);
+            }
+            for (User::const_op_iterator oit = inst.op_begin(), eoit = inst.op_end(); oit != eoit; ++oit) {
+                const Value* op = oit->get();
+                llvm::DenseMap<const Value*, u32_t>::const_iterator lit = localIds.find(op);
+                if (lit != localIds.end())
+                    rawstr << " %" << lit->second;
+                else if (const GlobalValue* global = SVFUtil::dyn_cast<GlobalValue>(op))
+                    rawstr << " @" << global->getName();
+                else if (SVFUtil::isa<Constant>(op)) {
+                    rawstr << " ";
+                    op->printAsOperand(rawstr, true);
+                }
+                else
+                    rawstr << " ?";
+            }
+            rawstr << "\n";
+        }
+    }
+    return md5Of(rawstr.str());
+}
+
+bool AnalysisCache::hasArtifact(const std::string& path) {
+    return llvm::sys::fs::exists(path);
+}
+
+std::string AnalysisCache::getTempPath(const std::string& path) {
+    return path + ".tmp" + std::to_string(::getpid());
+}
+
+/*!
+ * Move a completely written artifact to its path
+ */
+bool AnalysisCache::commitArtifact(const std::string& tempPath, const std::string& path) {
+    if (std::error_code err = llvm::sys::fs::rename(tempPath, path)) {
+        wrnMsg("cannot store analysis cache artifact " + path + ": " + err.message());
+        llvm::sys::fs::remove(tempPath);
+        return false;
+    }
+    return true;
+}
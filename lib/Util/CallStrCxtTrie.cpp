@@ -0,0 +1,154 @@
+//===- CallStrCxtTrie.cpp -- Interned call string contexts-------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CallStrCxtTrie.cpp
+ */
+
+#include "Util/CallStrCxtTrie.h"
+#include <algorithm>
+
+const CallStrCxtID CallStrCxtTrie::emptyCxt;
+CallStrCxtTrie::CxtNode* CallStrCxtTrie::chunks[CallStrCxtTrie::maxChunks];
+std::atomic<u32_t> CallStrCxtTrie::numOfCxts(1);
+CallStrCxtTrie::Shard CallStrCxtTrie::shards[CallStrCxtTrie::numOfShards];
+std::mutex CallStrCxtTrie::chunkMutex;
+
+/*!
+ * A new context is written before its ID is put in its shard or returned, and
+ * IDs are passed between threads under the lock of the shard or their own
+ * synchronization, so readers see the node
+ */
+CallStrCxtID CallStrCxtTrie::push(CallStrCxtID cxt, CallSiteID csId) {
+    u64_t key = getChildKey(cxt, csId);
+    Shard& shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::pair<llvm::DenseMap<u64_t, CallStrCxtID>::iterator, bool> res =
+        shard.children.insert(std::make_pair(key, emptyCxt));
+    if (res.second == false)
+        return res.first->second;
+
+    CallStrCxtID child = numOfCxts.fetch_add(1);
+    assert(child != 0 && "too many call string contexts!");
+    CxtNode* chunk;
+    {
+        std::lock_guard<std::mutex> chunkLock(chunkMutex);
+        CxtNode*& slot = chunks[child >> chunkBits];
+        if (slot == NULL)
+            slot = new CxtNode[chunkSize];
+        chunk = slot;
+    }
+
+    CxtNode& node = chunk[child & (chunkSize - 1)];
+    node.parent = cxt;
+    node.csId = csId;
+    node.front = (cxt == emptyCxt) ? csId : getNode(cxt).front;
+    node.size = size(cxt) + 1;
+    res.first->second = child;
+    return child;
+}
+
+/*!
+ * The call sites after the first one are pushed again onto the empty context
+ */
+CallStrCxtID CallStrCxtTrie::popFront(CallStrCxtID cxt) {
+    assert(cxt != emptyCxt && "pop front of an empty context!");
+    CallStrCxtID parent = pop(cxt);
+    if (parent == emptyCxt)
+        return emptyCxt;
+    return push(popFront(parent), back(cxt));
+}
+
+bool CallStrCxtTrie::contains(CallStrCxtID cxt, CallSiteID csId) {
+    for (; cxt != emptyCxt; cxt = pop(cxt)) {
+        if (back(cxt) == csId)
+            return true;
+    }
+    return false;
+}
+
+/*!
+ * Two contexts sharing a parent share all the call sites before it
+ */
+/*!
+ * Both contexts are popped to the same size. If they are the same there, the shorter
+ * one is a prefix of the other. Otherwise they are popped until their parents are
+ * the same, and the call sites below the common parent are the first that differ.
+ */
+bool CallStrCxtTrie::less(CallStrCxtID cxt1, CallStrCxtID cxt2) {
+    if (cxt1 == cxt2)
+        return false;
+    u32_t size1 = size(cxt1);
+    u32_t size2 = size(cxt2);
+    CallStrCxtID prefix1 = cxt1;
+    CallStrCxtID prefix2 = cxt2;
+    for (u32_t i = size1; i > size2; --i)
+        prefix1 = pop(prefix1);
+    for (u32_t i = size2; i > size1; --i)
+        prefix2 = pop(prefix2);
+    if (prefix1 == prefix2)
+        return size1 < size2;
+    while (pop(prefix1) != pop(prefix2)) {
+        prefix1 = pop(prefix1);
+        prefix2 = pop(prefix2);
+    }
+    return back(prefix1) < back(prefix2);
+}
+
+bool CallStrCxtTrie::matchSuffix(CallStrCxtID cxt1, CallStrCxtID cxt2) {
+    for (; cxt1 != cxt2 && cxt1 != emptyCxt && cxt2 != emptyCxt; cxt1 = pop(cxt1), cxt2 = pop(cxt2)) {
+        if (back(cxt1) != back(cxt2))
+            return false;
+    }
+    return true;
+}
+
+CallStrCxtID CallStrCxtTrie::getCxtID(const CallStrCxt& callStr) {
+    CallStrCxtID cxt = emptyCxt;
+    for (CallStrCxt::const_iterator it = callStr.begin(), eit = callStr.end(); it != eit; ++it)
+        cxt = push(cxt, *it);
+    return cxt;
+}
+
+CallStrCxt CallStrCxtTrie::getCallStr(CallStrCxtID cxt) {
+    CallStrCxt callStr;
+    for (; cxt != emptyCxt; cxt = pop(cxt))
+        callStr.push_back(back(cxt));
+    std::reverse(callStr.begin(), callStr.end());
+    return callStr;
+}
+
+std::string CallStrCxtTrie::toString(CallStrCxtID cxt) {
+    CallStrCxt callStr = getCallStr(cxt);
+    std::string str;
+    llvm::raw_string_ostream rawstr(str);
+    rawstr << "[:";
+    for (CallStrCxt::const_iterator it = callStr.begin(), eit = callStr.end(); it != eit; ++it) {
+        rawstr << *it << " ";
+    }
+    rawstr << " ]";
+    return rawstr.str();
+}
+
+u32_t CallStrCxtTrie::getNumOfCxts() {
+    return numOfCxts.load();
+}
@@ -34,6 +34,54 @@
 static llvm::cl::opt<unsigned> maxBddSize("maxbddsize",  llvm::cl::init(100000),
                                     llvm::cl::desc("Maximum context limit for DDA"));
 
+static llvm::cl::opt<unsigned> BddUniqueSlots("bdd-unique-slots",  llvm::cl::init(CUDD_UNIQUE_SLOTS),
+        llvm::cl::desc("Initial number of slots of each subtable of the BDD unique table"));
+
+static llvm::cl::opt<unsigned> BddCacheSlots("bdd-cache-slots",  llvm::cl::init(CUDD_CACHE_SLOTS),
+        llvm::cl::desc("Initial number of slots of the BDD computed table"));
+
+static llvm::cl::opt<bool> BddReorder("bdd-reorder", llvm::cl::init(false),
+                                      llvm::cl::desc("Reorder BDD variables dynamically by sifting"));
+
+static llvm::cl::opt<unsigned> BddReorderTime("bdd-reorder-time",  llvm::cl::init(10000),
+        llvm::cl::desc("Time budget (ms) of dynamic BDD variable reordering"));
+
+/// Stop reordering once the time spent on it exceeds the budget
+static int stopReorderingOverBudget(DdManager* mgr, const char*, void*) {
+    if (Cudd_ReadReorderingTime(mgr) >= (long)BddReorderTime)
+        Cudd_AutodynDisable(mgr);
+    return 1;
+}
+
+/*!
+ * Constructor
+ */
+BddCondManager::BddCondManager() {
+    m_bdd_mgr = Cudd_Init(0, 0, BddUniqueSlots, BddCacheSlots, 0);
+}
+
+void BddCondManager::enableReordering() {
+    if (!BddReorder)
+        return;
+    Cudd_AutodynEnable(m_bdd_mgr, CUDD_REORDER_SIFT);
+    Cudd_AddHook(m_bdd_mgr, stopReorderingOverBudget, CUDD_POST_REORDERING_HOOK);
+}
+
+/*!
+ * Variables keep their indices across managers, hence a transferred
+ * condition refers to the same branches
+ */
+DdNode* BddCondManager::transfer(DdNode* cond, const BddCondManager* from) {
+    if (cond == from->getTrueCond())
+        return getTrueCond();
+    else if (cond == from->getFalseCond())
+        return getFalseCond();
+    DdNode* res = Cudd_bddTransfer(from->m_bdd_mgr, m_bdd_mgr, cond);
+    assert(res && "fail to transfer a condition between BDD managers");
+    Cudd_Ref(res);
+    return res;
+}
+
 /// Operations on conditions.
 //@{
 /// use Cudd_bddAndLimit interface to avoid bdds blow up
@@ -0,0 +1,145 @@
+//===- GraphExportFile.cpp -- Binary graph export format---------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * GraphExportFile.cpp
+ */
+
+#include "Util/GraphExportFile.h"
+#include <string.h>
+
+const char GraphExportFile::Magic[8] = {'S', 'V', 'F', 'G', 'R', 'P', 'H', '\0'};
+
+/*!
+ * Records are buffered per chunk type, hence stdio buffering is not needed
+ */
+bool GraphExportWriter::open(const std::string& filename, GraphKind kind) {
+    file = fopen(filename.c_str(), "wb");
+    if (file == NULL)
+        return false;
+    setvbuf(file, NULL, _IONBF, 0);
+    nodes.reserve(ChunkBytes + sizeof(NodeRecord));
+    edges.reserve(ChunkBytes + sizeof(EdgeRecord));
+
+    Header header;
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.graphKind = kind;
+    write(&header, sizeof(header));
+    return !error;
+}
+
+void GraphExportWriter::write(const void* data, size_t size) {
+    if (!error && fwrite(data, 1, size, file) != size)
+        error = true;
+}
+
+void GraphExportWriter::writeChunk(ChunkType type, std::vector<char>& buf) {
+    ChunkHeader header;
+    header.type = type;
+    header.numOfRecords = numOfRecords[type];
+    header.size = buf.size();
+    write(&header, sizeof(header));
+    write(buf.data(), buf.size());
+    buf.clear();
+    numOfRecords[type] = 0;
+}
+
+bool GraphExportWriter::close() {
+    if (file == NULL)
+        return false;
+    if (!nodes.empty())
+        writeChunk(NodeChunk, nodes);
+    if (!edges.empty())
+        writeChunk(EdgeChunk, edges);
+    if (!pts.empty())
+        writeChunk(PtsChunk, pts);
+
+    ChunkHeader header;
+    header.type = EndChunk;
+    header.numOfRecords = 0;
+    header.size = sizeof(totals);
+    write(&header, sizeof(header));
+    write(&totals, sizeof(totals));
+    if (fclose(file) != 0)
+        error = true;
+    file = NULL;
+    return !error;
+}
+
+bool GraphExportReader::open(const std::string& filename) {
+    file = fopen(filename.c_str(), "rb");
+    if (file == NULL)
+        return false;
+    Header header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, Magic, sizeof(Magic)) != 0
+            || header.version != Version)
+        return false;
+    graphKind = header.graphKind;
+    return true;
+}
+
+/*!
+ * The size of a chunk is checked against its records, so that the
+ * accessors of the current chunk never read past its data. A chunk is
+ * larger than ChunkBytes only if it holds a large points-to set.
+ */
+bool GraphExportReader::nextChunk() {
+    if (file == NULL || complete)
+        return false;
+    if (fread(&chunk, sizeof(chunk), 1, file) != 1 || chunk.size > UINT32_MAX)
+        return false;
+    data.resize(chunk.size);
+    if (chunk.size && fread(&data[0], 1, chunk.size, file) != chunk.size)
+        return false;
+
+    switch (chunk.type) {
+    case NodeChunk:
+        totals.numOfNodes += chunk.numOfRecords;
+        return chunk.size == (uint64_t)chunk.numOfRecords * sizeof(NodeRecord);
+    case EdgeChunk:
+        totals.numOfEdges += chunk.numOfRecords;
+        return chunk.size == (uint64_t)chunk.numOfRecords * sizeof(EdgeRecord);
+    case PtsChunk: {
+        totals.numOfPts += chunk.numOfRecords;
+        uint64_t words = chunk.size / sizeof(uint32_t), pos = 0;
+        const uint32_t* p = (const uint32_t*)data.data();
+        for (uint32_t i = 0; i < chunk.numOfRecords; ++i) {
+            if (pos + 2 > words || pos + 2 + p[pos + 1] > words)
+                return false;
+            pos += 2 + p[pos + 1];
+        }
+        return pos == words && chunk.size % sizeof(uint32_t) == 0;
+    }
+    case EndChunk: {
+        Totals expected;
+        if (chunk.size != sizeof(expected))
+            return false;
+        memcpy(&expected, data.data(), sizeof(expected));
+        complete = expected.numOfNodes == totals.numOfNodes && expected.numOfEdges == totals.numOfEdges
+                   && expected.numOfPts == totals.numOfPts;
+        return false;
+    }
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,73 @@
+//===- GraphExporter.cpp -- Export graphs in the binary graph format---------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * GraphExporter.cpp
+ */
+
+#include "Util/GraphExporter.h"
+#include "MemoryModel/ConsG.h"
+#include "MSSA/SVFG.h"
+#include "Util/ICFG.h"
+
+static llvm::cl::opt<std::string> ExportPAG("export-pag",  llvm::cl::init(""),
+        llvm::cl::value_desc("file"),
+        llvm::cl::desc("Export the final PAG in the binary graph format"));
+
+static llvm::cl::opt<std::string> ExportConsG("export-consG",  llvm::cl::init(""),
+        llvm::cl::value_desc("file"),
+        llvm::cl::desc("Export the final constraint graph in the binary graph format"));
+
+static llvm::cl::opt<std::string> ExportSVFG("export-svfg",  llvm::cl::init(""),
+        llvm::cl::value_desc("file"),
+        llvm::cl::desc("Export the SVFG in the binary graph format"));
+
+static llvm::cl::opt<std::string> ExportICFG("export-icfg",  llvm::cl::init(""),
+        llvm::cl::value_desc("file"),
+        llvm::cl::desc("Export the ICFG in the binary graph format"));
+
+static llvm::cl::opt<bool> ExportPts("export-pts", llvm::cl::init(false),
+                                     llvm::cl::desc("Export points-to sets of the nodes of exported PAG and constraint graph"));
+
+bool GraphExporter::exportPts() {
+    return ExportPts;
+}
+
+void GraphExporter::exportPAG(PAG* pag, PointerAnalysis* pta) {
+    if (!ExportPAG.empty())
+        exportGraphToFile(ExportPAG, GraphExportFile::PAGKind, pag, exportPts() ? pta : NULL);
+}
+
+void GraphExporter::exportConsG(ConstraintGraph* consCG, PointerAnalysis* pta) {
+    if (!ExportConsG.empty())
+        exportGraphToFile(ExportConsG, GraphExportFile::ConsGKind, consCG, exportPts() ? pta : NULL);
+}
+
+void GraphExporter::exportSVFG(SVFG* svfg) {
+    if (!ExportSVFG.empty())
+        exportGraphToFile(ExportSVFG, GraphExportFile::SVFGKind, svfg, (PointerAnalysis*)NULL);
+}
+
+void GraphExporter::exportICFG(ICFG* icfg) {
+    if (!ExportICFG.empty())
+        exportGraphToFile(ExportICFG, GraphExportFile::ICFGKind, icfg, (PointerAnalysis*)NULL);
+}
@@ -42,6 +42,9 @@ static llvm::cl::opt<bool> DumpICFG("dump-icfg", llvm::cl::init(false),
 static llvm::cl::opt<bool> DumpLLVMInst("dump-inst", llvm::cl::init(false),
                              llvm::cl::desc("Dump LLVM instruction for each ICFG Node"));
 
+static llvm::cl::opt<bool> FreezeICFG("freeze-icfg", llvm::cl::init(true),
+                             llvm::cl::desc("Store the edges of the built ICFG compactly"));
+
 /*!
  * Constructor
  *  * Build ICFG
@@ -56,6 +59,8 @@ ICFG::ICFG(PTACallGraph* cg): totalICFGNode(0), callgraph(cg), pag(PAG::getPAG()
     DBOUT(DGENERAL, outs() << pasMsg("\tCreate ICFG ...\n"));
 	build();
 	addVFGToICFG();
+	if (FreezeICFG)
+		freeze();
 }
 
 /*!
@@ -194,7 +199,7 @@ void ICFG::build(){
     SVFModule svfModule = pag->getModule();
     for (SVFModule::const_iterator iter = svfModule.begin(), eiter = svfModule.end(); iter != eiter; ++iter) {
         const Function *fun = *iter;
-        if (SVFUtil::isExtCall(fun))
+        if (SVFUtil::isExtCall(fun) || !pag->isBuiltFunction(fun))
             continue;
         WorkList worklist;
         processFunEntry(fun,worklist);
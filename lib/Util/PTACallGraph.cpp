@@ -30,6 +30,7 @@
 
 #include "Util/SVFModule.h"
 #include "Util/PTACallGraph.h"
+#include "MemoryModel/PAG.h"
 
 using namespace SVFUtil;
 
@@ -84,21 +85,29 @@ void PTACallGraph::buildCallGraph(SVFModule svfModule) {
         addCallGraphNode(*F);
     }
 
-    /// create edges
+    /// create edges, functions not built yet are connected once they are built
+    PAG* pag = PAG::getPAG();
     for (SVFModule::iterator F = svfModule.begin(), E = svfModule.end(); F != E; ++F) {
-        Function *fun = *F;
-        for (inst_iterator II = inst_begin(*fun), E = inst_end(*fun); II != E; ++II) {
-            const Instruction *inst = &*II;
-            if (isNonInstricCallSite(inst)) {
-                if(getCallee(inst))
-                    addDirectCallGraphEdge(inst);
-            }
-        }
+        if (pag->isBuiltFunction(*F))
+            PTACallGraph::addDirectCallEdges(*F);
     }
 
     dump("callgraph_initial");
 }
 
+/*!
+ * Connect direct call edges of a function
+ */
+void PTACallGraph::addDirectCallEdges(const Function* fun) {
+    for (const_inst_iterator II = inst_begin(*fun), E = inst_end(*fun); II != E; ++II) {
+        const Instruction *inst = &*II;
+        if (isNonInstricCallSite(inst)) {
+            if(getCallee(inst))
+                addDirectCallGraphEdge(inst);
+        }
+    }
+}
+
 /*!
  *  Memory has been cleaned up at GenericGraph
  */
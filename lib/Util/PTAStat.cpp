@@ -28,11 +28,28 @@
  */
 
 #include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
 #include "Util/PTACallGraph.h"
 #include "Util/PTAStat.h"
 #include "MemoryModel/PointerAnalysis.h"
 #include "MemoryModel/PAG.h"
 
+static llvm::cl::opt<std::string> TracePhases("trace-phases",  llvm::cl::init(""),
+        llvm::cl::value_desc("file"),
+        llvm::cl::desc("Write the analysis phases as Chrome Trace Event JSON"));
+
+static llvm::cl::opt<std::string> PhaseSummary("phase-summary",  llvm::cl::init(""),
+        llvm::cl::value_desc("file"),
+        llvm::cl::desc("Write the time and peak RSS of each analysis phase as JSON"));
+
 const char* PTAStat:: TotalAnalysisTime = "TotalTime";	///< PAG value nodes
 const char* PTAStat:: SCCDetectionTime = "SCCDetectTime"; ///< Total SCC detection time
 const char* PTAStat:: SCCMergeTime = "SCCMergeTime"; ///< Total SCC merge time
@@ -330,3 +347,229 @@ void PTAStat::branchStat() {
     generalNumMap["BBWith2Succ"] = numOfBB_2Succ;
     generalNumMap["BBWith3Succ"] = numOfBB_3Succ;
 }
+
+std::atomic<PhaseProfiler::State> PhaseProfiler::state(PhaseProfiler::Unknown);
+
+namespace {
+
+/// A finished phase, or a counter value if isCounter is set
+struct PhaseEvent {
+    const char* name;
+    u32_t tid;
+    bool isCounter;
+    u64_t start;			///< start time in microseconds
+    u64_t duration;			///< duration in microseconds, the value of a counter
+    u64_t rssStart;			///< RSS in KB at the start
+    u64_t rssEnd;			///< RSS in KB at the end
+    PhaseProfiler::CounterVector counters;
+};
+
+/// Per-phase aggregation of the summary
+struct PhaseSummaryItem {
+    u64_t count;
+    u64_t total;
+    u64_t max;
+    u64_t maxRSS;			///< max RSS at the end of the phases
+    u64_t rssGrowth;		///< max RSS growth during a phase
+    PhaseSummaryItem(): count(0), total(0), max(0), maxRSS(0), rssGrowth(0) {}
+};
+
+std::vector<PhaseEvent> phaseEvents;
+std::mutex phaseEventsMutex;
+std::chrono::steady_clock::time_point profilerStart;
+std::atomic<u32_t> numOfProfiledThreads(0);
+
+/// Microseconds since the profiler is enabled
+inline u64_t getTimeInUS() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - profilerStart).count();
+}
+
+/// Small ID of the calling thread, 0 is the first profiled thread
+inline u32_t getProfiledThreadId() {
+    static thread_local u32_t tid = numOfProfiledThreads++;
+    return tid;
+}
+
+std::string escapeJSON(const char* str) {
+    std::string escaped;
+    for (const char* c = str; *c; ++c) {
+        if (*c == '"' || *c == '\\')
+            escaped += '\\';
+        escaped += *c;
+    }
+    return escaped;
+}
+
+void flushPhaseProfiler() {
+    PhaseProfiler::flush();
+}
+
+/// Count, time and RSS of the phases of each name
+void printSummaryOf(const std::vector<PhaseEvent>& events, std::ostream& out) {
+    std::map<std::string, PhaseSummaryItem> summary;
+    for (std::vector<PhaseEvent>::const_iterator it = events.begin(), eit = events.end(); it != eit; ++it) {
+        if (it->isCounter)
+            continue;
+        PhaseSummaryItem& item = summary[it->name];
+        item.count++;
+        item.total += it->duration;
+        item.max = std::max(item.max, it->duration);
+        item.maxRSS = std::max(item.maxRSS, it->rssEnd);
+        if (it->rssEnd > it->rssStart)
+            item.rssGrowth = std::max(item.rssGrowth, it->rssEnd - it->rssStart);
+    }
+
+    out << "{\"wallTimeMs\":" << getTimeInUS() / 1000.0 << ",\"peakRSSKB\":" << PhaseProfiler::getPeakRSS() << ",\"phases\":[";
+    for (std::map<std::string, PhaseSummaryItem>::const_iterator it = summary.begin(), eit = summary.end(); it != eit; ++it) {
+        out << (it == summary.begin() ? "\n" : ",\n");
+        out << "{\"name\":\"" << escapeJSON(it->first.c_str()) << "\",\"count\":" << it->second.count
+            << ",\"totalMs\":" << it->second.total / 1000.0 << ",\"maxMs\":" << it->second.max / 1000.0
+            << ",\"maxRSSAtEndKB\":" << it->second.maxRSS << ",\"maxRSSGrowthKB\":" << it->second.rssGrowth << "}";
+    }
+    out << "\n]}";
+}
+
+}
+
+/*!
+ * Enable the profiler if any output file is given
+ */
+PhaseProfiler::State PhaseProfiler::initialize() {
+    static std::once_flag initialized;
+    std::call_once(initialized, []() {
+        State unknown = Unknown;
+        if (TracePhases.empty() && PhaseSummary.empty()) {
+            state.compare_exchange_strong(unknown, Disabled);
+            return;
+        }
+        profilerStart = std::chrono::steady_clock::now();
+        state.store(Enabled, std::memory_order_release);
+        atexit(flushPhaseProfiler);
+    });
+    return state.load(std::memory_order_acquire);
+}
+
+void PhaseProfiler::enable() {
+    if (state.load(std::memory_order_acquire) == Enabled)
+        return;
+    profilerStart = std::chrono::steady_clock::now();
+    state.store(Enabled, std::memory_order_release);
+}
+
+u64_t PhaseProfiler::getPeakRSS() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    return usage.ru_maxrss;
+}
+
+/*!
+ * The second field of /proc/self/statm is the number of resident pages
+ */
+u64_t PhaseProfiler::getCurrentRSS() {
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm == NULL)
+        return 0;
+    unsigned long long size = 0, resident = 0;
+    int num = fscanf(statm, "%llu %llu", &size, &resident);
+    fclose(statm);
+    if (num != 2)
+        return 0;
+    return resident * (u64_t)sysconf(_SC_PAGESIZE) / 1024;
+}
+
+void PhaseProfiler::beginPhase(Scope& scope) {
+    scope.start = getTimeInUS();
+    scope.rss = getCurrentRSS();
+}
+
+void PhaseProfiler::endPhase(Scope& scope) {
+    PhaseEvent event;
+    event.name = scope.name;
+    event.tid = getProfiledThreadId();
+    event.isCounter = false;
+    event.start = scope.start;
+    event.duration = getTimeInUS() - scope.start;
+    event.rssStart = scope.rss;
+    event.rssEnd = getCurrentRSS();
+    event.counters.swap(scope.counters);
+
+    std::lock_guard<std::mutex> lock(phaseEventsMutex);
+    phaseEvents.push_back(event);
+}
+
+void PhaseProfiler::counter(const char* name, u64_t value) {
+    if (!isEnabled())
+        return;
+    PhaseEvent event;
+    event.name = name;
+    event.tid = getProfiledThreadId();
+    event.isCounter = true;
+    event.start = getTimeInUS();
+    event.duration = value;
+    event.rssStart = event.rssEnd = 0;
+
+    std::lock_guard<std::mutex> lock(phaseEventsMutex);
+    phaseEvents.push_back(event);
+}
+
+/*!
+ * Write the trace of the recorded phases and counters, and the summary of the phases
+ */
+void PhaseProfiler::flush() {
+    if (state != Enabled)
+        return;
+    std::lock_guard<std::mutex> lock(phaseEventsMutex);
+
+    if (!TracePhases.empty()) {
+        std::ofstream out(TracePhases.c_str());
+        if (!out.is_open()) {
+            SVFUtil::errs() << SVFUtil::errMsg("can not write phase trace ") << TracePhases << "\n";
+        }
+        else {
+            out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            for (u32_t i = 0; i < phaseEvents.size(); ++i) {
+                const PhaseEvent& event = phaseEvents[i];
+                out << (i ? ",\n" : "\n");
+                out << "{\"name\":\"" << escapeJSON(event.name) << "\",\"cat\":\"svf\",\"pid\":1"
+                    << ",\"tid\":" << event.tid << ",\"ts\":" << event.start;
+                if (event.isCounter) {
+                    out << ",\"ph\":\"C\",\"args\":{\"value\":" << event.duration << "}}";
+                    continue;
+                }
+                out << ",\"ph\":\"X\",\"dur\":" << event.duration
+                    << ",\"args\":{\"rssKB\":" << event.rssEnd;
+                for (CounterVector::const_iterator it = event.counters.begin(), eit = event.counters.end(); it != eit; ++it)
+                    out << ",\"" << escapeJSON(it->first) << "\":" << it->second;
+                out << "}}";
+            }
+            out << "\n]}\n";
+        }
+    }
+
+    if (!PhaseSummary.empty()) {
+        std::ofstream out(PhaseSummary.c_str());
+        if (!out.is_open()) {
+            SVFUtil::errs() << SVFUtil::errMsg("can not write phase summary ") << PhaseSummary << "\n";
+            return;
+        }
+        printSummaryOf(phaseEvents, out);
+        out << "\n";
+    }
+}
+
+void PhaseProfiler::printSummary(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(phaseEventsMutex);
+    printSummaryOf(phaseEvents, out);
+}
+
+u32_t PhaseProfiler::getNumOfPhases(const char* name) {
+    std::lock_guard<std::mutex> lock(phaseEventsMutex);
+    u32_t num = 0;
+    for (std::vector<PhaseEvent>::const_iterator it = phaseEvents.begin(), eit = phaseEvents.end(); it != eit; ++it) {
+        if (!it->isCounter && strcmp(it->name, name) == 0)
+            num++;
+    }
+    return num;
+}
@@ -36,9 +36,9 @@
 
 using namespace SVFUtil;
 
-u64_t DPItem::maximumBudget = ULONG_MAX - 1;
+thread_local u64_t DPItem::maximumBudget = ULONG_MAX - 1;
 u32_t ContextCond::maximumCxtLen = 0;
-u32_t ContextCond::maximumCxt = 0;
+std::atomic<u32_t> ContextCond::maximumCxt(0);
 u32_t VFPathCond::maximumPathLen = 0;
 u32_t VFPathCond::maximumPath = 0;
 
@@ -71,6 +71,39 @@ void PathCondAllocator::allocate(const SVFModule M) {
     DBOUT(DGENERAL,outs() << pasMsg("path condition allocation ends\n"));
 }
 
+/*!
+ * Constructor of a worker, the branch conditions of the master are copied into
+ * the BDD manager of the worker
+ */
+PathCondAllocator::PathCondAllocator(PathCondAllocator* m): funToExitBBsMap(m->funToExitBBsMap),
+    curEvalVal(NULL), condMgr(new BddCondManager()), master(m), cfInfoComplete(true) {
+    for (BBCondMap::const_iterator it = m->bbConds.begin(), eit = m->bbConds.end(); it != eit; ++it) {
+        CondPosMap& condPosMap = bbConds[it->first];
+        for (CondPosMap::const_iterator cit = it->second.begin(), ecit = it->second.end(); cit != ecit; ++cit)
+            condPosMap[cit->first] = transferCond(cit->second, m);
+    }
+}
+
+/*!
+ * Control-flow information is computed lazily, which is not thread-safe,
+ * hence it is computed for all functions before a worker is created
+ */
+PathCondAllocator* PathCondAllocator::createWorker(const SVFModule module) {
+    assert(master == NULL && "create a worker of a worker?");
+    if (!cfInfoComplete) {
+        for (SVFModule::const_iterator fit = module.begin(); fit != module.end(); ++fit) {
+            const Function* fun = *fit;
+            if (SVFUtil::isExtCall(fun))
+                continue;
+            getDT(fun);
+            getPostDT(fun);
+            getLoopInfo(fun);
+        }
+        cfInfoComplete = true;
+    }
+    return new PathCondAllocator(this);
+}
+
 /*!
  * Allocate conditions for a basic block and propagate its condition to its successors.
  */
@@ -366,7 +399,7 @@ PathCondAllocator::Condition* PathCondAllocator::getPHIComplementCond(const Basi
         return condNeg(cond);
     }
 
-    return trueCond();
+    return getTrueCond();
 }
 
 /*!
@@ -454,6 +487,10 @@ PathCondAllocator::Condition* PathCondAllocator::ComputeIntraVFGGuard(const Basi
  * Release memory
  */
 void PathCondAllocator::destroy() {
+    if (master) {
+        delete condMgr;
+        return;
+    }
     delete bddCondMgr;
     bddCondMgr = NULL;
 }
@@ -30,6 +30,8 @@
 #include <queue>
 #include "Util/SVFModule.h"
 #include "Util/SVFUtil.h"
+#include "Util/ParallelUtil.h"
+#include "Util/PTAStat.h"
 
 using namespace std;
 
@@ -54,6 +56,8 @@ using namespace std;
 static llvm::cl::opt<std::string> Graphtxt("graphtxt", llvm::cl::value_desc("filename"),
 		llvm::cl::desc("graph txt file to build PAG"));
 static llvm::cl::opt<bool> SVFMain("svfmain", llvm::cl::init(false), llvm::cl::desc("add svf.main()"));
+static llvm::cl::opt<unsigned> ModuleLoadThreads("module-load-threads", llvm::cl::init(1),
+		llvm::cl::desc("Number of threads parsing input modules, each into its own LLVMContext (0: all hardware threads)"));
 
 LLVMModuleSet *SVFModule::llvmModuleSet = NULL;
 std::string SVFModule::pagReadFromTxt = "";
@@ -98,7 +102,17 @@ void LLVMModuleSet::build(const vector<string> &moduleNameVec) {
 }
 
 void LLVMModuleSet::loadModules(const std::vector<std::string> &moduleNameVec) {
+    PhaseProfiler::Scope phase("Module loading");
     moduleNum = moduleNameVec.size();
+    if (PhaseProfiler::isEnabled())
+        phase.addCounter("modules", moduleNum);
+
+    u32_t numOfThreads = SVFUtil::getNumOfWorkerThreads(ModuleLoadThreads);
+    if (numOfThreads > 1 && moduleNum > 1) {
+        loadModulesInParallel(moduleNameVec, numOfThreads);
+        return;
+    }
+
     //
     // To avoid the following type bugs (t1 != t3) when parsing multiple modules,
     // We should use only one LLVMContext object for multiple modules in the same thread.
@@ -130,6 +144,44 @@ void LLVMModuleSet::loadModules(const std::vector<std::string> &moduleNameVec) {
     }
 }
 
+/*!
+ * An LLVMContext can not be shared by threads, so every module is parsed into
+ * a context of its own. Types are then only unique within a module, e.g., a
+ * struct declared by two modules has two Type objects, which SVF treats as two
+ * types of the same name. Functions and globals are still linked across
+ * modules by name (see buildFunToFunMap and buildGlobalDefToRepMap).
+ *
+ * The largest files are parsed first, so that the loading time is bounded by
+ * the largest module rather than by a large module picked up last. Modules
+ * keep the order of moduleNameVec regardless of thread scheduling.
+ */
+void LLVMModuleSet::loadModulesInParallel(const std::vector<std::string> &moduleNameVec, u32_t numOfThreads) {
+    cxts = new LLVMContext[moduleNum];
+    modules = new unique_ptr<Module>[moduleNum];
+
+    std::vector<std::pair<u64_t, u32_t> > sizeToIdx(moduleNum);
+    for (u32_t i = 0; i < moduleNum; ++i) {
+        uint64_t size = 0;
+        llvm::sys::fs::file_size(moduleNameVec[i], size);
+        sizeToIdx[i] = std::make_pair(size, i);
+    }
+    std::stable_sort(sizeToIdx.begin(), sizeToIdx.end(),
+                     [](const std::pair<u64_t, u32_t>& a, const std::pair<u64_t, u32_t>& b) {
+                         return a.first > b.first;
+                     });
+
+    SVFUtil::parallelFor(moduleNum, numOfThreads, [&](u32_t n, u32_t) {
+        u32_t i = sizeToIdx[n].second;
+        SMDiagnostic Err;
+        modules[i] = parseIRFile(moduleNameVec[i], Err, cxts[i]);
+    }, 1);
+
+    for (u32_t i = 0; i < moduleNum; ++i) {
+        if (!modules[i])
+            SVFUtil::errs() << "load module: " << moduleNameVec[i] << "failed\n";
+    }
+}
+
 void LLVMModuleSet::initialize() {
    if (SVFMain)
 	addSVFMain();
@@ -220,139 +272,75 @@ void LLVMModuleSet::addSVFMain(){
 }
 
 
+/*!
+ * Link function declarations to the definitions of the same name.
+ * Symbols are indexed by hashing the names owned by the functions, which
+ * are visited once in the order of FunctionSet. A declaration is linked to
+ * the first definition of its name if several modules define it, while every
+ * definition is mapped to the declarations of its name.
+ */
 void LLVMModuleSet::buildFunToFunMap() {
-    std::set<Function*> funDecls, funDefs;
-    std::set<string> declNames, defNames, intersectNames;
-    typedef std::map<string, Function*> NameToFunDefMapTy;
-    typedef std::map<string, std::set<Function*>> NameToFunDeclsMapTy;
+    struct FunSymbol {
+        FunctionSetType defs;
+        FunctionSetType decls;
+    };
+    llvm::StringMap<FunSymbol> nameToFunSymbol(FunctionSet.size());
 
     for (FunctionSetType::iterator it = FunctionSet.begin(),
             eit = FunctionSet.end(); it != eit; ++it) {
         Function *fun = *it;
-        if (fun->isDeclaration()) {
-            funDecls.insert(fun);
-            declNames.insert(fun->getName().str());
-        } else {
-            funDefs.insert(fun);
-            defNames.insert(fun->getName().str());
-        }
-    }
-    // Find the intersectNames
-    std::set<string>::iterator declIter, defIter;
-    declIter = declNames.begin();
-    defIter = defNames.begin();
-    while (declIter != declNames.end() && defIter != defNames.end()) {
-        if (*declIter < *defIter) {
-            declIter++;
-        } else {
-            if (!(*defIter < *declIter)) {
-                intersectNames.insert(*declIter);
-                declIter++;
-            }
-            defIter++;
-        }
-    }
-
-    ///// name to def map
-    NameToFunDefMapTy nameToFunDefMap;
-    for (std::set<Function*>::iterator it = funDefs.begin(),
-            eit = funDefs.end(); it != eit; ++it) {
-        Function *fdef = *it;
-        string funName = fdef->getName().str();
-        if (intersectNames.find(funName) == intersectNames.end())
-            continue;
-        nameToFunDefMap[funName] = fdef;
-    }
-
-    ///// name to decls map
-    NameToFunDeclsMapTy nameToFunDeclsMap;
-    for (std::set<Function*>::iterator it = funDecls.begin(),
-            eit = funDecls.end(); it != eit; ++it) {
-        Function *fdecl = *it;
-        string funName = fdecl->getName().str();
-        if (intersectNames.find(funName) == intersectNames.end())
-            continue;
-        NameToFunDeclsMapTy::iterator mit = nameToFunDeclsMap.find(funName);
-        if (mit == nameToFunDeclsMap.end()) {
-            std::set<Function*> decls;
-            decls.insert(fdecl);
-            nameToFunDeclsMap[funName] = decls;
-        } else {
-            std::set<Function*> &decls = mit->second;
-            decls.insert(fdecl);
-        }
-    }
-
-    /// Fun decl --> def
-    for (std::set<Function*>::iterator it = funDecls.begin(),
-            eit = funDecls.end(); it != eit; ++it) {
-        Function *fdecl = *it;
-        string funName = fdecl->getName().str();
-        if (intersectNames.find(funName) == intersectNames.end())
-            continue;
-        NameToFunDefMapTy::iterator mit = nameToFunDefMap.find(funName);
-        if (mit == nameToFunDefMap.end())
-            continue;
-        FunDeclToDefMap[fdecl] = mit->second;
+        FunSymbol &sym = nameToFunSymbol[fun->getName()];
+        if (fun->isDeclaration())
+            sym.decls.push_back(fun);
+        else
+            sym.defs.push_back(fun);
     }
 
-    /// Fun def --> decls
-    for (std::set<Function*>::iterator it = funDefs.begin(),
-            eit = funDefs.end(); it != eit; ++it) {
-        Function *fdef = *it;
-        string funName = fdef->getName().str();
-        if (intersectNames.find(funName) == intersectNames.end())
-            continue;
-        NameToFunDeclsMapTy::iterator mit = nameToFunDeclsMap.find(funName);
-        if (mit == nameToFunDeclsMap.end())
+    for (llvm::StringMap<FunSymbol>::iterator it = nameToFunSymbol.begin(),
+            eit = nameToFunSymbol.end(); it != eit; ++it) {
+        FunSymbol &sym = it->second;
+        if (sym.defs.empty() || sym.decls.empty())
             continue;
-        FunctionSetType decls;
-        for (std::set<Function*>::iterator sit = mit->second.begin(),
-                seit = mit->second.end(); sit != seit; ++sit) {
-            decls.push_back(*sit);
-        }
-        FunDefToDeclsMap[fdef] = decls;
+        /// Fun decl --> def
+        for (FunctionSetType::iterator dit = sym.decls.begin(),
+                deit = sym.decls.end(); dit != deit; ++dit)
+            FunDeclToDefMap[*dit] = sym.defs.front();
+        /// Fun def --> decls
+        for (FunctionSetType::iterator dit = sym.defs.begin(),
+                deit = sym.defs.end(); dit != deit; ++dit)
+            FunDefToDeclsMap[*dit] = sym.decls;
     }
 }
 
+/*!
+ * Map every non-private global to a representative of its name, the first
+ * global with an initializer in the order of GlobalSet, or else the first one.
+ */
 void LLVMModuleSet::buildGlobalDefToRepMap() {
-    typedef std::map<string, std::set<GlobalVariable*>> NameToGlobalsMapTy;
-    NameToGlobalsMapTy nameToGlobalsMap;
+    typedef llvm::StringMap<GlobalSetType> NameToGlobalsMapTy;
+    NameToGlobalsMapTy nameToGlobalsMap(GlobalSet.size());
     for (GlobalSetType::iterator it = GlobalSet.begin(),
             eit = GlobalSet.end(); it != eit; ++it) {
         GlobalVariable *global = *it;
         if (global->hasPrivateLinkage())
             continue;
-        string name = global->getName().str();
-        NameToGlobalsMapTy::iterator mit = nameToGlobalsMap.find(name);
-        if (mit == nameToGlobalsMap.end()) {
-            std::set<GlobalVariable*> globals;
-            globals.insert(global);
-            nameToGlobalsMap[name] = globals;
-        } else {
-            std::set<GlobalVariable*> &globals = mit->second;
-            globals.insert(global);
-        }
+        nameToGlobalsMap[global->getName()].push_back(global);
     }
 
     for (NameToGlobalsMapTy::iterator it = nameToGlobalsMap.begin(),
             eit = nameToGlobalsMap.end(); it != eit; ++it) {
-        std::set<GlobalVariable*> &globals = it->second;
-        GlobalVariable *rep = *(globals.begin());
-        std::set<GlobalVariable*>::iterator repit = globals.begin();
-        while (repit != globals.end()) {
-            GlobalVariable *cur = *repit;
-            if (cur->hasInitializer()) {
-                rep = cur;
+        GlobalSetType &globals = it->second;
+        GlobalVariable *rep = globals.front();
+        for (GlobalSetType::iterator sit = globals.begin(),
+                seit = globals.end(); sit != seit; ++sit) {
+            if ((*sit)->hasInitializer()) {
+                rep = *sit;
                 break;
             }
-            repit++;
-        }
-        for (std::set<GlobalVariable*>::iterator sit = globals.begin(),
-                seit = globals.end(); sit != seit; ++sit) {
-            GlobalVariable *cur = *sit;
-            GlobalDefToRepMap[cur] = rep;
         }
+        for (GlobalSetType::iterator sit = globals.begin(),
+                seit = globals.end(); sit != seit; ++sit)
+            GlobalDefToRepMap[*sit] = rep;
     }
 }
 
@@ -45,43 +45,53 @@ ThreadCallGraph::ThreadCallGraph(SVFModule svfModule) :
  * Start building Thread Call Graph
  */
 void ThreadCallGraph::build(SVFModule svfModule) {
-    // create thread fork edges and record fork sites
+    // create thread fork edges and record fork and join sites, functions not
+    // built yet are handled once they are built
+    PAG* pag = PAG::getPAG();
     for (SVFModule::const_iterator fi = svfModule.begin(), efi = svfModule.end(); fi != efi; ++fi) {
-        const Function *fun = *fi;
-        for (const_inst_iterator II = inst_begin(*fun), E = inst_end(*fun); II != E; ++II) {
-            const Instruction *inst = &*II;
-            if (tdAPI->isTDFork(inst)) {
-                addForksite(inst);
-                const Function* forkee = SVFUtil::dyn_cast<Function>(tdAPI->getForkedFun(inst));
-                if (forkee) {
-                    addDirectForkEdge(inst);
-                }
-                // indirect call to the start routine function
-                else {
-                    addThreadForkEdgeSetMap(inst,NULL);
-                }
+        if (pag->isBuiltFunction(*fi))
+            addThreadCallEdges(*fi);
+    }
+}
+
+/*!
+ * Connect direct call and thread edges of a function built on the fly
+ */
+void ThreadCallGraph::addDirectCallEdges(const Function* fun) {
+    PTACallGraph::addDirectCallEdges(fun);
+    addThreadCallEdges(fun);
+}
+
+/*!
+ * Create thread fork and parallel for edges and record fork and join sites of a function
+ */
+void ThreadCallGraph::addThreadCallEdges(const Function* fun) {
+    for (const_inst_iterator II = inst_begin(*fun), E = inst_end(*fun); II != E; ++II) {
+        const Instruction *inst = &*II;
+        if (tdAPI->isTDFork(inst)) {
+            addForksite(inst);
+            const Function* forkee = SVFUtil::dyn_cast<Function>(tdAPI->getForkedFun(inst));
+            if (forkee) {
+                addDirectForkEdge(inst);
             }
-            else if (tdAPI->isHareParFor(inst)) {
-                addParForSite(inst);
-                const Function* taskFunc = SVFUtil::dyn_cast<Function>(tdAPI->getTaskFuncAtHareParForSite(inst));
-                if (taskFunc) {
-                    addDirectParForEdge(inst);
-                }
-                // indirect call to the start routine function
-                else {
-                    addHareParForEdgeSetMap(inst,NULL);
-                }
+            // indirect call to the start routine function
+            else {
+                addThreadForkEdgeSetMap(inst,NULL);
             }
         }
-    }
-    // record join sites
-    for (SVFModule::const_iterator fi = svfModule.begin(), efi = svfModule.end(); fi != efi; ++fi) {
-        const Function *fun = *fi;
-        for (const_inst_iterator II = inst_begin(*fun), E = inst_end(*fun); II != E; ++II) {
-            const Instruction *inst = &*II;
-            if (tdAPI->isTDJoin(inst)) {
-                addJoinsite(inst);
+        else if (tdAPI->isHareParFor(inst)) {
+            addParForSite(inst);
+            const Function* taskFunc = SVFUtil::dyn_cast<Function>(tdAPI->getTaskFuncAtHareParForSite(inst));
+            if (taskFunc) {
+                addDirectParForEdge(inst);
             }
+            // indirect call to the start routine function
+            else {
+                addHareParForEdgeSetMap(inst,NULL);
+            }
+        }
+        else if (tdAPI->isTDJoin(inst)) {
+            addJoinsite(inst);
         }
     }
 }
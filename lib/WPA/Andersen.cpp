@@ -29,6 +29,8 @@
 
 #include "WPA/Andersen.h"
 #include "Util/SVFUtil.h"
+#include "Util/AnalysisCache.h"
+#include "MemoryModel/PAGBuilder.h"
 
 using namespace SVFUtil;
 
@@ -57,6 +59,8 @@ static llvm::cl::opt<string> WriteAnder("write-ander",  llvm::cl::init(""),
                                   llvm::cl::desc("Write Andersen's analysis results to a file"));
 static llvm::cl::opt<string> ReadAnder("read-ander",  llvm::cl::init(""),
                                  llvm::cl::desc("Read Andersen's analysis results from a file"));
+static llvm::cl::opt<string> AnderDiff("ander-diff",  llvm::cl::init(""),
+                                 llvm::cl::desc("Update the results of -read-ander with the constraint changes in a file"));
 static llvm::cl::opt<bool> PtsDiff("diff",  llvm::cl::init(true),
                                     llvm::cl::desc("Disable diff pts propagation"));
 static llvm::cl::opt<bool> MergePWC("merge-pwc",  llvm::cl::init(true),
@@ -70,9 +74,16 @@ void Andersen::analyze(SVFModule svfModule) {
     /// Initialization for the Solver
     initialize(svfModule);
     
+    /// Results are keyed by the analysis kind, as typed variants compute different results,
+    /// and by the solver options which change the results, as set up by initialize
+    std::string cacheStage = "ander" + std::to_string(getAnalysisTy());
+    std::string cacheStageOptions = std::string("merge-pwc=") + (mergePWC() ? "1" : "0") + ";";
+
     bool readResultsFromFile = false;
     if(!ReadAnder.empty())
         readResultsFromFile = this->readFromFile(ReadAnder);
+    else if(AnalysisCache::isEnabled())
+        readResultsFromFile = this->readFromCache(cacheStage, cacheStageOptions);
 
 	if(!readResultsFromFile) {
 		// Start solving constraints
@@ -82,6 +93,20 @@ void Andersen::analyze(SVFModule svfModule) {
 
 		// Finalize the analysis
 		finalize();
+
+		if(AnalysisCache::isEnabled())
+			this->writeToCache(cacheStage, cacheStageOptions);
+	}
+	else if(!AnderDiff.empty()) {
+		// Update the loaded results for the changed constraints only
+		ConstraintChanges added, removed;
+		if(readConstraintChanges(AnderDiff, added, removed)) {
+			DBOUT(DGENERAL, outs() << SVFUtil::pasMsg("Start Incremental Solving\n"));
+			rederiveLoadStoreEdges();
+			updateSolution(added, removed);
+			DBOUT(DGENERAL, outs() << SVFUtil::pasMsg("Finish Incremental Solving\n"));
+			finalize();
+		}
 	}
 
 	if (!WriteAnder.empty())
@@ -115,6 +140,8 @@ void Andersen::processNode(NodeID nodeId) {
     if (sccRepNode(nodeId) != nodeId)
         return;
 
+    checkPtsMemBudget(nodeId);
+
     ConstraintNode* node = consCG->getConstraintNode(nodeId);
     double insertStart = stat->getClk();
     handleLoadStore(node);
@@ -127,6 +154,15 @@ void Andersen::processNode(NodeID nodeId) {
     timeOfProcessCopyGep += (propEnd - propStart) / TIMEINTERVAL;
 }
 
+/*!
+ * Sets of the node being processed and the nodes on the worklist are hot
+ */
+void Andersen::spillColdPts(NodeID nodeId) {
+    spillPtsOverBudget([this, nodeId](NodeID id) {
+        return id == nodeId || isInWorklist(id);
+    });
+}
+
 /*!
  * Process copy and gep edges
  */
@@ -450,6 +486,7 @@ bool Andersen::collapseField(NodeID nodeId)
  */
 NodeStack& Andersen::SCCDetect() {
     numOfSCCDetection++;
+    PhaseProfiler::Scope phase("SCC detection");
 
     double sccStart = stat->getClk();
     WPAConstraintSolver::SCCDetect();
@@ -465,6 +502,8 @@ NodeStack& Andersen::SCCDetect() {
 
     timeOfSCCMerges +=  (mergeEnd - mergeStart)/TIMEINTERVAL;
 
+    if (PhaseProfiler::isEnabled())
+        phase.addCounter("nodes", getSCCDetector()->topoNodeStack().size());
     return getSCCDetector()->topoNodeStack();
 }
 
@@ -473,6 +512,7 @@ NodeStack& Andersen::SCCDetect() {
  */
 bool Andersen::updateCallGraph(const CallSiteToFunPtrMap& callsites) {
 
+    PhaseProfiler::Scope phase("updateCallGraph");
     double cgUpdateStart = stat->getClk();
 
     CallEdgeMap newEdges;
@@ -487,9 +527,12 @@ bool Andersen::updateCallGraph(const CallSiteToFunPtrMap& callsites) {
     for(NodePairSet::iterator it = cpySrcNodes.begin(), eit = cpySrcNodes.end(); it!=eit; ++it) {
         pushIntoWorklist(it->first);
     }
+    buildReachedCallees(newEdges);
 
     double cgUpdateEnd = stat->getClk();
     timeOfUpdateCallGraph += (cgUpdateEnd - cgUpdateStart) / TIMEINTERVAL;
+    if (PhaseProfiler::isEnabled())
+        phase.addCounter("callsites", newEdges.size());
 
     return (!newEdges.empty());
 }
@@ -566,6 +609,88 @@ void Andersen::connectCaller2CalleeParams(CallSite cs, const Function *F, NodePa
     }
 }
 
+/*!
+ * Build the callees resolved for the first time together with the functions they
+ * reach through direct calls, then add their constraints to the constraint graph
+ * and propagate the points-to sets computed so far along them.
+ */
+void Andersen::buildReachedCallees(const CallEdgeMap& newEdges) {
+    if (!pag->isReachableOnly())
+        return;
+
+    PAGBuilder::FunctionList worklist, built;
+    for(CallEdgeMap::const_iterator it = newEdges.begin(), eit = newEdges.end(); it!=eit; ++it ) {
+        for(FunctionSet::const_iterator cit = it->second.begin(), ecit = it->second.end(); cit!=ecit; ++cit) {
+            if (!pag->isBuiltFunction(*cit))
+                worklist.push_back(*cit);
+        }
+    }
+    if (worklist.empty())
+        return;
+
+    PhaseProfiler::Scope phase("Andersen reached functions");
+    PAGBuilder builder;
+    builder.buildReachableFunctions(getModule(), worklist, built);
+    for (PAGBuilder::FunctionList::iterator it = built.begin(), eit = built.end(); it != eit; ++it)
+        getPTACallGraph()->addDirectCallEdges(*it);
+
+    PAG::PAGEdgeVector& edges = pag->getOnTheFlyPTAEdges();
+    for (PAG::PAGEdgeVector::iterator it = edges.begin(), eit = edges.end(); it != eit; ++it)
+        addReachedPTAEdge(*it);
+    if (PhaseProfiler::isEnabled()) {
+        phase.addCounter("functions", built.size());
+        phase.addCounter("edges", edges.size());
+    }
+    edges.clear();
+}
+
+/*!
+ * Add the constraint of a PAG edge of a function built on the fly, as buildCG does
+ */
+void Andersen::addReachedPTAEdge(const PAGEdge* edge) {
+    /// nodes created while building the function, e.g., dummy nodes of external calls
+    NodeID ids[2] = {edge->getSrcID(), edge->getDstID()};
+    for (u32_t i = 0; i < 2; ++i) {
+        if (sccRepNode(ids[i]) == ids[i] && !consCG->hasConstraintNode(ids[i]))
+            consCG->addConstraintNode(new ConstraintNode(ids[i]), ids[i]);
+    }
+
+    ConstraintChange change = {ConstraintEdge::Copy, edge->getSrcID(), edge->getDstID(), 0};
+    switch (edge->getEdgeKind()) {
+    case PAGEdge::Addr:
+        change.kind = ConstraintEdge::Addr;
+        break;
+    case PAGEdge::Copy:
+    case PAGEdge::Call:
+    case PAGEdge::Ret:
+    case PAGEdge::ThreadFork:
+    case PAGEdge::ThreadJoin:
+        break;
+    case PAGEdge::NormalGep: {
+        /// the location set is kept as a whole, which the offset of a change is not
+        NodeID src = sccRepNode(edge->getSrcID());
+        NodeID dst = sccRepNode(edge->getDstID());
+        consCG->addNormalGepCGEdge(src, dst, SVFUtil::cast<NormalGepPE>(edge)->getLocationSet());
+        ConstraintEdge* gep = consCG->getEdge(consCG->getConstraintNode(src), consCG->getConstraintNode(dst), ConstraintEdge::NormalGep);
+        processGepPts(getPts(src), SVFUtil::cast<GepCGEdge>(gep));
+        return;
+    }
+    case PAGEdge::VariantGep:
+        change.kind = ConstraintEdge::VariantGep;
+        break;
+    case PAGEdge::Load:
+        change.kind = ConstraintEdge::Load;
+        break;
+    case PAGEdge::Store:
+        change.kind = ConstraintEdge::Store;
+        break;
+    default:
+        /// not a constraint
+        return;
+    }
+    addConstraint(change);
+}
+
 /*!
  * merge nodeId to newRepId. Return true if the newRepId is a PWC node
  */
@@ -0,0 +1,367 @@
+//===- AndersenInc.cpp -- Incremental update of Andersen's analysis-----------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenInc.cpp
+ *
+ *  Update a solved Andersen's analysis after constraint edges are added or removed.
+ *  Added edges are propagated forward from their sources. For removed edges, the
+ *  nodes reachable from their targets are reset and recomputed from their
+ *  unaffected predecessors, so the work depends on the part of the graph
+ *  influenced by the change rather than on the whole program.
+ */
+
+#include "WPA/Andersen.h"
+#include "Util/SVFUtil.h"
+#include <fstream>
+#include <sstream>
+
+using namespace SVFUtil;
+
+Size_t Andersen::numOfIncAffectedNodes = 0;
+double Andersen::timeOfIncUpdate = 0;
+
+/*!
+ * Read changes, one per line
+ *  + copy 12 34
+ *  - load 5 6
+ *  + gep 7 8 16
+ * where kind is one of addr, copy, load, store, gep (normal gep with an offset) and vgep.
+ * Empty lines and lines starting with '#' are skipped.
+ */
+bool Andersen::readConstraintChanges(const std::string& filename, ConstraintChanges& added, ConstraintChanges& removed) {
+    std::ifstream F(filename.c_str());
+    if (!F.is_open()) {
+        outs() << "  error opening file '" << filename << "' for reading!\n";
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(F, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream ss(line);
+        std::string op, kind;
+        ConstraintChange change;
+        change.offset = 0;
+        ss >> op >> kind >> change.src >> change.dst;
+        if (ss.fail() || (op != "+" && op != "-")) {
+            wrnMsg("ill-formed constraint change: " + line);
+            return false;
+        }
+
+        if (kind == "addr")
+            change.kind = ConstraintEdge::Addr;
+        else if (kind == "copy")
+            change.kind = ConstraintEdge::Copy;
+        else if (kind == "load")
+            change.kind = ConstraintEdge::Load;
+        else if (kind == "store")
+            change.kind = ConstraintEdge::Store;
+        else if (kind == "gep") {
+            change.kind = ConstraintEdge::NormalGep;
+            ss >> change.offset;
+        }
+        else if (kind == "vgep")
+            change.kind = ConstraintEdge::VariantGep;
+        else {
+            wrnMsg("unknown constraint edge kind: " + line);
+            return false;
+        }
+
+        if (op == "+")
+            added.push_back(change);
+        else
+            removed.push_back(change);
+    }
+    return true;
+}
+
+/*!
+ * Copy edges added when solving loads and stores are not part of a result file.
+ * Re-create them for a solution loaded from a file, no propagation is needed as
+ * the loaded points-to sets are already a fixed point.
+ */
+void Andersen::rederiveLoadStoreEdges() {
+    for (ConstraintGraph::const_iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it) {
+        NodeID nodeId = it->first;
+        if (sccRepNode(nodeId) != nodeId)
+            continue;
+        ConstraintNode* node = it->second;
+        if (node->getLoadOutEdges().empty() && node->getStoreInEdges().empty())
+            continue;
+        const PointsTo& pts = getPts(nodeId);
+        for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit) {
+            for (ConstraintEdge* load : node->getLoadOutEdges())
+                processLoad(*pit, load);
+            for (ConstraintEdge* store : node->getStoreInEdges())
+                processStore(*pit, store);
+        }
+    }
+}
+
+/*!
+ * Collect the copy edges derived by the loads and stores of a pointer
+ *	ptr --load--> dst, obj \in pts(ptr)  ==>  obj --copy--> dst
+ *	src --store--> ptr, obj \in pts(ptr) ==>  src --copy--> obj
+ * An object merged into a cycle is skipped, as its edges cannot be told apart
+ * from those of the other members of the cycle.
+ */
+void Andersen::collectDerivedEdges(NodeID ptr, NodePairVec& derivedEdges) {
+    ConstraintNode* node = consCG->getConstraintNode(ptr);
+    if (node->getLoadOutEdges().empty() && node->getStoreInEdges().empty())
+        return;
+    const PointsTo& pts = getPts(ptr);
+    for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit) {
+        NodeID obj = *pit;
+        if (sccRepNode(obj) != obj)
+            continue;
+        for (ConstraintEdge* load : node->getLoadOutEdges())
+            derivedEdges.push_back(std::make_pair(obj, sccRepNode(load->getDstID())));
+        for (ConstraintEdge* store : node->getStoreInEdges())
+            derivedEdges.push_back(std::make_pair(sccRepNode(store->getSrcID()), obj));
+    }
+}
+
+/*!
+ * Whether a copy edge is still derived by some load or store
+ */
+bool Andersen::isDerivedByLoadStore(NodeID src, NodeID dst) {
+    ConstraintNode* dstNode = consCG->getConstraintNode(dst);
+    for (ConstraintEdge* load : dstNode->getLoadInEdges()) {
+        if (getPts(load->getSrcID()).test(src))
+            return true;
+    }
+    ConstraintNode* srcNode = consCG->getConstraintNode(src);
+    for (ConstraintEdge* store : srcNode->getStoreOutEdges()) {
+        if (getPts(store->getDstID()).test(dst))
+            return true;
+    }
+    return false;
+}
+
+/*!
+ * Remove a constraint edge.
+ * The nodes whose points-to sets may shrink are collected into seeds, and the
+ * copy edges derived by a removed load or store into derivedEdges.
+ */
+void Andersen::removeConstraint(const ConstraintChange& change, NodeBS& seeds, NodePairVec& derivedEdges) {
+    NodeID src = sccRepNode(change.src);
+    NodeID dst = sccRepNode(change.dst);
+    ConstraintNode* srcNode = consCG->getConstraintNode(src);
+    ConstraintNode* dstNode = consCG->getConstraintNode(dst);
+
+    ConstraintEdge* edge = NULL;
+    if (consCG->hasEdge(srcNode, dstNode, change.kind))
+        edge = consCG->getEdge(srcNode, dstNode, change.kind);
+
+    switch (change.kind) {
+    case ConstraintEdge::Addr:
+        seeds.set(dst);
+        if (edge)
+            consCG->removeAddrEdge(SVFUtil::cast<AddrCGEdge>(edge));
+        break;
+    case ConstraintEdge::Copy:
+    case ConstraintEdge::NormalGep:
+    case ConstraintEdge::VariantGep:
+        seeds.set(dst);
+        if (edge)
+            consCG->removeDirectEdge(edge);
+        break;
+    case ConstraintEdge::Load: {
+        seeds.set(dst);
+        const PointsTo& pts = getPts(src);
+        for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit) {
+            if (sccRepNode(*pit) == *pit)
+                derivedEdges.push_back(std::make_pair(*pit, dst));
+        }
+        if (edge)
+            consCG->removeLoadEdge(SVFUtil::cast<LoadCGEdge>(edge));
+        break;
+    }
+    case ConstraintEdge::Store: {
+        const PointsTo& pts = getPts(dst);
+        for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit) {
+            seeds.set(sccRepNode(*pit));
+            if (sccRepNode(*pit) == *pit)
+                derivedEdges.push_back(std::make_pair(src, *pit));
+        }
+        if (edge)
+            consCG->removeStoreEdge(SVFUtil::cast<StoreCGEdge>(edge));
+        break;
+    }
+    default:
+        assert(false && "unknown constraint edge kind!");
+    }
+}
+
+/*!
+ * Add a constraint edge and propagate points-to along it
+ */
+void Andersen::addConstraint(const ConstraintChange& change) {
+    NodeID src = sccRepNode(change.src);
+    NodeID dst = sccRepNode(change.dst);
+
+    switch (change.kind) {
+    case ConstraintEdge::Addr: {
+        consCG->addAddrCGEdge(src, dst);
+        ConstraintEdge* edge = consCG->getEdge(consCG->getConstraintNode(src), consCG->getConstraintNode(dst), change.kind);
+        processAddr(SVFUtil::cast<AddrCGEdge>(edge));
+        break;
+    }
+    case ConstraintEdge::Copy:
+        /// the propagated set of src is adjusted, so pts(src) reaches dst when src is processed
+        addCopyEdge(src, dst);
+        pushIntoWorklist(src);
+        break;
+    case ConstraintEdge::NormalGep:
+    case ConstraintEdge::VariantGep: {
+        if (change.kind == ConstraintEdge::NormalGep)
+            consCG->addNormalGepCGEdge(src, dst, LocationSet(change.offset));
+        else
+            consCG->addVariantGepCGEdge(src, dst);
+        ConstraintEdge* edge = consCG->getEdge(consCG->getConstraintNode(src), consCG->getConstraintNode(dst), change.kind);
+        processGepPts(getPts(src), SVFUtil::cast<GepCGEdge>(edge));
+        break;
+    }
+    case ConstraintEdge::Load:
+        consCG->addLoadCGEdge(src, dst);
+        pushIntoWorklist(src);
+        break;
+    case ConstraintEdge::Store:
+        consCG->addStoreCGEdge(src, dst);
+        pushIntoWorklist(dst);
+        break;
+    default:
+        assert(false && "unknown constraint edge kind!");
+    }
+}
+
+/*!
+ * Update a solved analysis for constraint edges added and removed.
+ * (1) Removed edges are deleted; their targets are the seeds of the affected nodes.
+ * (2) Every node reachable from an affected node along copy, gep and load edges is affected,
+ *     so are the objects pointed to by an affected pointer that is stored into.
+ * (3) Affected points-to sets are reset, and the copy edges derived by the loads and stores
+ *     of affected pointers are removed unless an unaffected load or store still derives them.
+ * (4) Affected nodes are recomputed from their address edges and unaffected predecessors.
+ * (5) Added edges are inserted and propagated forward.
+ * Merged cycles, collapsed fields and resolved indirect calls are kept, which is sound
+ * but may be less precise than solving from scratch.
+ */
+void Andersen::updateSolution(const ConstraintChanges& added, const ConstraintChanges& removed) {
+    double updateStart = stat->getClk();
+
+    NodeBS seeds;
+    NodePairVec derivedEdges;
+    for (const ConstraintChange& change : removed)
+        removeConstraint(change, seeds, derivedEdges);
+
+    /// (2) collect affected nodes
+    NodeBS affected;
+    WorkList affectedList;
+    for (NodeBS::iterator it = seeds.begin(), eit = seeds.end(); it != eit; ++it) {
+        if (affected.test_and_set(*it))
+            affectedList.push(*it);
+    }
+    while (!affectedList.empty()) {
+        NodeID nodeId = affectedList.pop();
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        NodeBS succs;
+        for (ConstraintEdge* edge : node->getDirectOutEdges())
+            succs.set(sccRepNode(edge->getDstID()));
+        for (ConstraintEdge* edge : node->getLoadOutEdges())
+            succs.set(sccRepNode(edge->getDstID()));
+        if (!node->getStoreInEdges().empty()) {
+            const PointsTo& pts = getPts(nodeId);
+            for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit)
+                succs.set(sccRepNode(*pit));
+        }
+        for (NodeBS::iterator it = succs.begin(), eit = succs.end(); it != eit; ++it) {
+            if (affected.test_and_set(*it))
+                affectedList.push(*it);
+        }
+    }
+    numOfIncAffectedNodes += affected.count();
+
+    /// (3) reset affected nodes and remove their derived edges
+    for (NodeBS::iterator it = affected.begin(), eit = affected.end(); it != eit; ++it)
+        collectDerivedEdges(*it, derivedEdges);
+    for (NodeBS::iterator it = affected.begin(), eit = affected.end(); it != eit; ++it) {
+        getPts(*it).clear();
+        clearPropaPts(*it);
+    }
+    for (const NodePair& derived : derivedEdges) {
+        ConstraintNode* srcNode = consCG->getConstraintNode(derived.first);
+        ConstraintNode* dstNode = consCG->getConstraintNode(derived.second);
+        if (consCG->hasEdge(srcNode, dstNode, ConstraintEdge::Copy)
+                && !isDerivedByLoadStore(derived.first, derived.second))
+            consCG->removeDirectEdge(consCG->getEdge(srcNode, dstNode, ConstraintEdge::Copy));
+    }
+
+    /// (4) recompute affected nodes from outside
+    for (NodeBS::iterator it = affected.begin(), eit = affected.end(); it != eit; ++it) {
+        NodeID nodeId = *it;
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        for (ConstraintEdge* edge : node->getAddrInEdges())
+            processAddr(SVFUtil::cast<AddrCGEdge>(edge));
+        for (ConstraintEdge* edge : node->getCopyInEdges()) {
+            NodeID src = sccRepNode(edge->getSrcID());
+            if (!affected.test(src))
+                unionPts(nodeId, getPts(src));
+        }
+        for (ConstraintEdge* edge : node->getGepInEdges()) {
+            NodeID src = sccRepNode(edge->getSrcID());
+            if (!affected.test(src))
+                processGepPts(getPts(src), SVFUtil::cast<GepCGEdge>(edge));
+        }
+        pushIntoWorklist(nodeId);
+    }
+
+    /// (5) add new edges
+    for (const ConstraintChange& change : added)
+        addConstraint(change);
+
+    solveIncrementally();
+
+    double updateEnd = stat->getClk();
+    timeOfIncUpdate += (updateEnd - updateStart) / TIMEINTERVAL;
+}
+
+/*!
+ * Process the worklist only, the main solvers of some variants start each
+ * round with a pass over the whole graph
+ */
+void Andersen::solveIncrementally() {
+    do {
+        reanalyze = false;
+        while (!isWorklistEmpty()) {
+            NodeID nodeId = popFromWorklist();
+            collapsePWCNode(nodeId);
+            Andersen::processNode(nodeId);
+            collapseFields();
+        }
+        if (updateCallGraph())
+            reanalyze = true;
+    } while (reanalyze);
+}
@@ -259,6 +259,7 @@ bool AndersenSCD::updateCallGraph(const PointerAnalysis::CallSiteToFunPtrMap& ca
             connectCaller2CalleeParams(cs,*cit,cpySrcNodes);
         }
     }
+    buildReachedCallees(newEdges);
 
     double cgUpdateEnd = stat->getClk();
     timeOfUpdateCallGraph += (cgUpdateEnd - cgUpdateStart) / TIMEINTERVAL;
@@ -303,6 +303,10 @@ void AndersenStat::performStat() {
     timeStatMap[ProcessLoadStoreTime] =  Andersen::timeOfProcessLoadStore;
     timeStatMap[ProcessCopyGepTime] =  Andersen::timeOfProcessCopyGep;
     timeStatMap[UpdateCallGraphTime] =  Andersen::timeOfUpdateCallGraph;
+    if (Andersen::numOfIncAffectedNodes) {
+        timeStatMap["IncUpdateTime"] = Andersen::timeOfIncUpdate;
+        PTNumStatMap["IncAffectedNodes"] = Andersen::numOfIncAffectedNodes;
+    }
 
     PTNumStatMap[TotalNumOfPointers] = pag->getValueNodeNum() + pag->getFieldValNodeNum();
     PTNumStatMap[TotalNumOfObjects] = pag->getObjectNodeNum() + pag->getFieldObjNodeNum();
@@ -341,6 +345,61 @@ void AndersenStat::performStat() {
     PTNumStatMap["PointsToConstPtr"] = _NumOfConstantPtr;
     PTNumStatMap["PointsToBlkPtr"] = _NumOfBlackholePtr;
 
+    if (const PtsSpillStore* spill = pta->getPtsSpillStore()) {
+        PTNumStatMap["NumOfPtsSpillRounds"] = spill->getNumOfRounds();
+        PTNumStatMap["NumOfSpilledPts"] = spill->getNumOfSpills();
+        PTNumStatMap["NumOfPtsFaults"] = spill->getNumOfFaults();
+        PTNumStatMap["SpilledPtsKB"] = spill->getSpilledBytes() / 1024;
+        PTNumStatMap["ReleasedPtsKB"] = spill->getReleasedBytes() / 1024;
+    }
+
+    if (pag->isReachableOnly())
+        PTNumStatMap["NumOfBuiltFunctions"] = pag->getNumOfBuiltFunctions();
+
     PTAStat::printStat("Andersen Pointer Analysis Stats");
+
+    if (SVFUtil::isa<AndersenWaveDiffPar>(pta))
+        parallelWaveStat();
+}
+
+/*!
+ * Per-phase time and per-thread work of the parallel wave propagation
+ */
+void AndersenStat::parallelWaveStat() {
+    AndersenWaveDiffPar* parPta = SVFUtil::cast<AndersenWaveDiffPar>(pta);
+    u32_t numOfThreads = parPta->getNumOfThreads();
+
+    timeStatMap["WaveLevelTime"] = AndersenWaveDiffPar::timeOfWaveLevels;
+    timeStatMap["ParDiffTime"] = AndersenWaveDiffPar::timeOfParDiff;
+    timeStatMap["ParCopyTime"] = AndersenWaveDiffPar::timeOfParCopy;
+    timeStatMap["MergeCopyTime"] = AndersenWaveDiffPar::timeOfMergeCopy;
+    timeStatMap["SeqGepTime"] = AndersenWaveDiffPar::timeOfSeqGep;
+    timeStatMap[ProcessLoadStoreTime] = Andersen::timeOfProcessLoadStore;
+    timeStatMap[SCCDetectionTime] = Andersen::timeOfSCCDetection;
+
+    PTNumStatMap["NumOfThreads"] = numOfThreads;
+    PTNumStatMap["NumOfWaveLevels"] = AndersenWaveDiffPar::numOfWaveLevels;
+    PTNumStatMap["MaxWaveWidth"] = AndersenWaveDiffPar::maxWaveWidth;
+
+    /// Names are built first as the stat maps keep the raw string pointers
+    threadStatNames.clear();
+    for (u32_t tid = 0; tid < numOfThreads; ++tid) {
+        threadStatNames.push_back("T" + std::to_string(tid) + "Nodes");
+        threadStatNames.push_back("T" + std::to_string(tid) + "Copys");
+    }
+    u64_t totalCopys = 0;
+    u64_t maxCopys = 0;
+    for (u32_t tid = 0; tid < numOfThreads; ++tid) {
+        u64_t copys = AndersenWaveDiffPar::threadProcessedCopys[tid];
+        PTNumStatMap[threadStatNames[2 * tid].c_str()] = AndersenWaveDiffPar::threadProcessedNodes[tid];
+        PTNumStatMap[threadStatNames[2 * tid + 1].c_str()] = copys;
+        totalCopys += copys;
+        if (copys > maxCopys)
+            maxCopys = copys;
+    }
+    /// ideal balance is 100%, i.e., the busiest thread does 1/numOfThreads of the copy work
+    PTNumStatMap["CopyWorkBalance(%)"] = maxCopys == 0 ? 100 : (u32_t)(100 * totalCopys / (maxCopys * numOfThreads));
+
+    PTAStat::printStat("Parallel Wave Propagation Stats");
 }
 
@@ -42,14 +42,7 @@ void AndersenWaveDiff::solveWorklist() {
     NodeStack& nodeStack = SCCDetect();
 
     // Process nodeStack and put the changed nodes into workList.
-    while (!nodeStack.empty()) {
-        NodeID nodeId = nodeStack.top();
-        nodeStack.pop();
-        collapsePWCNode(nodeId);
-        // process nodes in nodeStack
-        processNode(nodeId);
-        collapseFields();
-    }
+    propagateWave(nodeStack);
 
     // This modification is to make WAVE feasible to handle PWC analysis
     if (!mergePWC()) {
@@ -77,6 +70,20 @@ void AndersenWaveDiff::solveWorklist() {
     }
 }
 
+/*!
+ * Propagate points-to along copy/gep edges in topological order
+ */
+void AndersenWaveDiff::propagateWave(NodeStack& nodeStack) {
+    while (!nodeStack.empty()) {
+        NodeID nodeId = nodeStack.top();
+        nodeStack.pop();
+        collapsePWCNode(nodeId);
+        // process nodes in nodeStack
+        processNode(nodeId);
+        collapseFields();
+    }
+}
+
 /*!
  * Process edge PAGNode
  */
@@ -86,6 +93,8 @@ void AndersenWaveDiff::processNode(NodeID nodeId) {
     if (sccRepNode(nodeId) != nodeId)
         return;
 
+    checkPtsMemBudget(nodeId);
+
     double propStart = stat->getClk();
     ConstraintNode* node = consCG->getConstraintNode(nodeId);
     handleCopyGep(node);
@@ -207,6 +216,7 @@ bool AndersenWaveDiff::updateCallGraph(const CallSiteToFunPtrMap& callsites) {
         unionPts(dst, src);
         pushIntoWorklist(dst);
     }
+    buildReachedCallees(newEdges);
 
     double cgUpdateEnd = stat->getClk();
     timeOfUpdateCallGraph += (cgUpdateEnd - cgUpdateStart) / TIMEINTERVAL;
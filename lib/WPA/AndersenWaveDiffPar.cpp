@@ -0,0 +1,255 @@
+//===- AndersenWaveDiffPar.cpp -- Parallel wave propagation based Andersen's analysis--//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===--------------------------------------------------------------------------------===//
+
+/*
+ * AndersenWaveDiffPar.cpp
+ *
+ * The wave of AndersenWaveDiff visits the collapsed constraint graph in topological
+ * order. Nodes are grouped into levels such that no direct edge connects two nodes
+ * of the same level. For each level:
+ *  1. the diff points-to of every node is computed in parallel (each worker only
+ *     touches the sets of its own node);
+ *  2. the copy edges are processed in parallel, grouped by destination so that
+ *     every destination set has exactly one writer;
+ *  3. reverse points-to and worklist updates are merged sequentially in a fixed order;
+ *  4. gep edges and field collapsing, which may create or merge nodes, run sequentially.
+ * Load/store edges are still handled by the sequential post-processing of AndersenWaveDiff.
+ */
+
+#include "WPA/Andersen.h"
+#include "Util/ParallelUtil.h"
+
+using namespace SVFUtil;
+
+static llvm::cl::opt<u32_t> AnderThreads("ander-threads",  llvm::cl::init(0),
+        llvm::cl::desc("Number of threads used by parallel wave propagation (0: all hardware threads)"));
+
+AndersenWaveDiffPar* AndersenWaveDiffPar::parDiffWave = NULL;
+
+double AndersenWaveDiffPar::timeOfWaveLevels = 0;
+double AndersenWaveDiffPar::timeOfParDiff = 0;
+double AndersenWaveDiffPar::timeOfParCopy = 0;
+double AndersenWaveDiffPar::timeOfMergeCopy = 0;
+double AndersenWaveDiffPar::timeOfSeqGep = 0;
+Size_t AndersenWaveDiffPar::numOfWaveLevels = 0;
+Size_t AndersenWaveDiffPar::maxWaveWidth = 0;
+AndersenWaveDiffPar::ThreadWork AndersenWaveDiffPar::threadProcessedNodes;
+AndersenWaveDiffPar::ThreadWork AndersenWaveDiffPar::threadProcessedCopys;
+
+/*!
+ * Constructor
+ */
+AndersenWaveDiffPar::AndersenWaveDiffPar(PTATY type) :
+    AndersenWaveDiff(type), numOfThreads(getNumOfWorkerThreads(AnderThreads)) {
+    threadProcessedNodes.assign(numOfThreads, 0);
+    threadProcessedCopys.assign(numOfThreads, 0);
+}
+
+/*!
+ * Process the wave level by level
+ */
+void AndersenWaveDiffPar::propagateWave(NodeStack& nodeStack) {
+    WaveLevels levels;
+    computeWaveLevels(nodeStack, levels);
+
+    double propStart = stat->getClk();
+    for (WaveLevels::const_iterator it = levels.begin(), eit = levels.end(); it != eit; ++it)
+        processWaveLevel(*it);
+    double propEnd = stat->getClk();
+    timeOfProcessCopyGep += (propEnd - propStart) / TIMEINTERVAL;
+}
+
+/*!
+ * The level of a node is the length of the longest direct-edge path reaching it.
+ * Nodes are popped in topological order, so all predecessors of a node are
+ * visited before the node itself.
+ */
+void AndersenWaveDiffPar::computeWaveLevels(NodeStack& nodeStack, WaveLevels& levels) {
+    double levelStart = stat->getClk();
+
+    llvm::DenseMap<NodeID, u32_t> nodeToLevel;
+    while (!nodeStack.empty()) {
+        NodeID nodeId = nodeStack.top();
+        nodeStack.pop();
+        u32_t level = nodeToLevel[nodeId];
+        if (levels.size() <= level)
+            levels.resize(level + 1);
+        levels[level].push_back(nodeId);
+
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        for (ConstraintEdge* edge : node->getDirectOutEdges()) {
+            NodeID dst = sccRepNode(edge->getDstID());
+            if (dst == nodeId)
+                continue;
+            u32_t& dstLevel = nodeToLevel[dst];
+            if (dstLevel <= level)
+                dstLevel = level + 1;
+        }
+    }
+    numOfWaveLevels += levels.size();
+
+    double levelEnd = stat->getClk();
+    timeOfWaveLevels += (levelEnd - levelStart) / TIMEINTERVAL;
+}
+
+/*!
+ * Propagate diff points-to of all nodes in a level
+ */
+void AndersenWaveDiffPar::processWaveLevel(const NodeVector& level) {
+    // PWC collapsing may merge nodes, so it is done before the level is partitioned.
+    for (NodeVector::const_iterator it = level.begin(), eit = level.end(); it != eit; ++it)
+        collapsePWCNode(*it);
+
+    NodeVector srcs;
+    llvm::DenseSet<NodeID> srcSet;
+    for (NodeVector::const_iterator it = level.begin(), eit = level.end(); it != eit; ++it) {
+        NodeID nodeId = *it;
+        if (sccRepNode(nodeId) == nodeId && srcSet.insert(nodeId).second)
+            srcs.push_back(nodeId);
+    }
+    if (srcs.empty())
+        return;
+    if ((Size_t)srcs.size() > maxWaveWidth)
+        maxWaveWidth = srcs.size();
+
+    /// Points-to maps must not be modified by the workers,
+    /// hence all the sets they touch are resolved here.
+    u32_t numOfSrcs = srcs.size();
+    std::vector<PointsTo*> srcPts(numOfSrcs);
+    std::vector<PointsTo*> srcDiffPts(numOfSrcs);
+    std::vector<PointsTo*> srcPropaPts(numOfSrcs);
+    for (u32_t i = 0; i < numOfSrcs; ++i) {
+        srcPts[i] = &getPTDataTy()->getPts(srcs[i]);
+        if (enableDiff()) {
+            srcDiffPts[i] = &getDiffPTDataTy()->getDiffPts(srcs[i]);
+            srcPropaPts[i] = &getDiffPTDataTy()->getPropaPts(srcs[i]);
+        }
+        else {
+            srcDiffPts[i] = srcPts[i];
+            srcPropaPts[i] = NULL;
+        }
+    }
+
+    /// 1. compute diff points-to in parallel
+    double diffStart = stat->getClk();
+    std::vector<char> hasDiff(numOfSrcs, 0);
+    bool diff = enableDiff();
+    parallelFor(numOfSrcs, numOfThreads, [&](u32_t i, u32_t tid) {
+        if (diff) {
+            PointsTo& diffPts = *srcDiffPts[i];
+            diffPts.clear();
+            diffPts.intersectWithComplement(*srcPts[i], *srcPropaPts[i]);
+            *srcPropaPts[i] = *srcPts[i];
+        }
+        hasDiff[i] = !srcDiffPts[i]->empty();
+        threadProcessedNodes[tid]++;
+    });
+    double diffEnd = stat->getClk();
+    timeOfParDiff += (diffEnd - diffStart) / TIMEINTERVAL;
+
+    /// 2. group copy edges by destination and propagate in parallel
+    double copyStart = stat->getClk();
+    llvm::DenseMap<NodeID, u32_t> dstToIdx;
+    NodeVector dsts;
+    std::vector<std::vector<u32_t> > dstSrcs;
+    for (u32_t i = 0; i < numOfSrcs; ++i) {
+        if (!hasDiff[i])
+            continue;
+        ConstraintNode* node = consCG->getConstraintNode(srcs[i]);
+        for (ConstraintEdge* edge : node->getCopyOutEdges()) {
+            if (!SVFUtil::isa<CopyCGEdge>(edge))
+                continue;
+            processCast(edge);
+            NodeID dst = sccRepNode(edge->getDstID());
+            llvm::DenseMap<NodeID, u32_t>::iterator it = dstToIdx.find(dst);
+            u32_t idx;
+            if (it == dstToIdx.end()) {
+                idx = dsts.size();
+                dstToIdx[dst] = idx;
+                dsts.push_back(dst);
+                dstSrcs.push_back(std::vector<u32_t>());
+            }
+            else
+                idx = it->second;
+            dstSrcs[idx].push_back(i);
+        }
+    }
+
+    u32_t numOfDsts = dsts.size();
+    std::vector<PointsTo*> dstPts(numOfDsts);
+    std::vector<u32_t> parDsts;
+    std::vector<u32_t> seqDsts;
+    for (u32_t d = 0; d < numOfDsts; ++d) {
+        dstPts[d] = &getPTDataTy()->getPts(dsts[d]);
+        // A destination inside this level (only possible after nodes have been merged)
+        // may be read as a source by other workers, so it is updated after them.
+        if (srcSet.count(dsts[d]))
+            seqDsts.push_back(d);
+        else
+            parDsts.push_back(d);
+    }
+
+    std::vector<char> dstChanged(numOfDsts, 0);
+    auto propagateToDst = [&](u32_t d, u32_t tid) {
+        PointsTo& pts = *dstPts[d];
+        const std::vector<u32_t>& fromSrcs = dstSrcs[d];
+        for (std::vector<u32_t>::const_iterator it = fromSrcs.begin(), eit = fromSrcs.end(); it != eit; ++it) {
+            if (pts |= *srcDiffPts[*it])
+                dstChanged[d] = 1;
+        }
+        threadProcessedCopys[tid] += fromSrcs.size();
+    };
+    parallelFor(parDsts.size(), numOfThreads, [&](u32_t i, u32_t tid) {
+        propagateToDst(parDsts[i], tid);
+    });
+    for (std::vector<u32_t>::const_iterator it = seqDsts.begin(), eit = seqDsts.end(); it != eit; ++it)
+        propagateToDst(*it, 0);
+    double copyEnd = stat->getClk();
+    timeOfParCopy += (copyEnd - copyStart) / TIMEINTERVAL;
+
+    /// 3. merge reverse points-to and worklist updates in a fixed order
+    double mergeStart = stat->getClk();
+    for (u32_t d = 0; d < numOfDsts; ++d) {
+        const std::vector<u32_t>& fromSrcs = dstSrcs[d];
+        for (std::vector<u32_t>::const_iterator it = fromSrcs.begin(), eit = fromSrcs.end(); it != eit; ++it)
+            getPTDataTy()->updateRevPts(dsts[d], *srcDiffPts[*it]);
+        numOfProcessedCopy += fromSrcs.size();
+        if (dstChanged[d])
+            pushIntoWorklist(dsts[d]);
+    }
+    double mergeEnd = stat->getClk();
+    timeOfMergeCopy += (mergeEnd - mergeStart) / TIMEINTERVAL;
+
+    /// 4. gep edges may create gep objects and collapse fields, hence handled sequentially
+    double gepStart = stat->getClk();
+    for (u32_t i = 0; i < numOfSrcs; ++i) {
+        if (!hasDiff[i])
+            continue;
+        ConstraintNode* node = consCG->getConstraintNode(srcs[i]);
+        for (ConstraintEdge* edge : node->getGepOutEdges())
+            if (GepCGEdge* gepEdge = SVFUtil::dyn_cast<GepCGEdge>(edge))
+                processGep(srcs[i], gepEdge);
+    }
+    collapseFields();
+    double gepEnd = stat->getClk();
+    timeOfSeqGep += (gepEnd - gepStart) / TIMEINTERVAL;
+}
@@ -0,0 +1,418 @@
+//===- FlowSensitivePar.cpp -- Parallel sparse flow-sensitive pointer analysis//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * FlowSensitivePar.cpp
+ *
+ * The IN/OUT sets are hash-consed in the PointsToTable, which is not thread-safe.
+ * Hence workers never update a set: they compute the new targets of a node as
+ * plain PointsTo (e.g., IN[store:o] - OUT[store:o]) and the sets are updated
+ * afterwards in a fixed order. Nodes whose results are always empty thus never
+ * reach the table, and the results do not depend on thread scheduling.
+ */
+
+#include "WPA/FlowSensitive.h"
+#include "WPA/WPAStat.h"
+#include "Util/ParallelUtil.h"
+#include <map>
+
+using namespace SVFUtil;
+
+static llvm::cl::opt<u32_t> FSThreads("fs-threads",  llvm::cl::init(0),
+        llvm::cl::desc("Number of threads used by parallel flow-sensitive analysis (0: all hardware threads)"));
+
+FlowSensitivePar* FlowSensitivePar::fsparpta = NULL;
+
+double FlowSensitivePar::timeOfLevels = 0;
+double FlowSensitivePar::timeOfParProcess = 0;
+double FlowSensitivePar::timeOfSeqProcess = 0;
+double FlowSensitivePar::timeOfParPropagation = 0;
+double FlowSensitivePar::timeOfMergePropagation = 0;
+Size_t FlowSensitivePar::numOfLevels = 0;
+Size_t FlowSensitivePar::numOfRounds = 0;
+Size_t FlowSensitivePar::maxRoundWidth = 0;
+FlowSensitivePar::ThreadWork FlowSensitivePar::threadProcessedNodes;
+FlowSensitivePar::ThreadWork FlowSensitivePar::threadPropagatedNodes;
+
+/*!
+ * Constructor
+ */
+FlowSensitivePar::FlowSensitivePar(PTATY type) :
+    FlowSensitive(type), numOfThreads(getNumOfWorkerThreads(FSThreads)) {
+    threadProcessedNodes.assign(numOfThreads, 0);
+    threadPropagatedNodes.assign(numOfThreads, 0);
+}
+
+/*!
+ * Solve all SVFG nodes level by level.
+ * The SVFG does not change during solving, so a node is only pushed
+ * into its own level (inside an SCC) or a later level.
+ */
+void FlowSensitivePar::solve() {
+    NodeStack& nodeStack = SCCDetect();
+
+    SVFGLevels levels;
+    computeLevels(nodeStack, levels);
+
+    /// All nodes are solved in each pass, the same as FlowSensitive
+    for (SVFGLevels::const_iterator it = levels.begin(), eit = levels.end(); it != eit; ++it)
+        for (NodeVector::const_iterator nIt = it->begin(), nEit = it->end(); nIt != nEit; ++nIt)
+            pendingNodes.set(*nIt);
+
+    for (SVFGLevels::const_iterator it = levels.begin(), eit = levels.end(); it != eit; ++it) {
+        const NodeVector& level = *it;
+        while (true) {
+            NodeVector nodes;
+            for (NodeVector::const_iterator nIt = level.begin(), nEit = level.end(); nIt != nEit; ++nIt) {
+                if (pendingNodes.test(*nIt)) {
+                    pendingNodes.reset(*nIt);
+                    nodes.push_back(*nIt);
+                }
+            }
+            if (nodes.empty())
+                break;
+            processRound(nodes);
+        }
+    }
+    assert(pendingNodes.empty() && "a node is pushed into a level which has been solved?");
+}
+
+/*!
+ * The level of an SCC is the length of the longest path reaching it.
+ * Nodes are popped in topological order and the nodes of an SCC are
+ * popped together, so all predecessors of an SCC are visited before it.
+ */
+void FlowSensitivePar::computeLevels(NodeStack& nodeStack, SVFGLevels& levels) {
+    double levelStart = stat->getClk();
+
+    llvm::DenseMap<NodeID, u32_t> repToLevel;
+    while (!nodeStack.empty()) {
+        NodeID nodeId = nodeStack.top();
+        nodeStack.pop();
+        NodeID rep = getSCCDetector()->repNode(nodeId);
+        u32_t level = repToLevel[rep];
+        if (levels.size() <= level)
+            levels.resize(level + 1);
+        levels[level].push_back(nodeId);
+
+        SVFGNode* node = svfg->getSVFGNode(nodeId);
+        for (SVFGNode::const_iterator it = node->OutEdgeBegin(), eit = node->OutEdgeEnd(); it != eit; ++it) {
+            NodeID dstRep = getSCCDetector()->repNode((*it)->getDstID());
+            if (dstRep == rep)
+                continue;
+            u32_t& dstLevel = repToLevel[dstRep];
+            if (dstLevel <= level)
+                dstLevel = level + 1;
+        }
+    }
+    numOfLevels += levels.size();
+
+    double levelEnd = stat->getClk();
+    timeOfLevels += (levelEnd - levelStart) / TIMEINTERVAL;
+}
+
+/*!
+ * Solve one round of the pending nodes of a level
+ */
+void FlowSensitivePar::processRound(const NodeVector& nodes) {
+    numOfRounds++;
+    if ((Size_t)nodes.size() > maxRoundWidth)
+        maxRoundWidth = nodes.size();
+
+    /// 1. load and store nodes are computed in parallel.
+    /// Points-to maps must not be modified by the workers,
+    /// hence the sets of top-level pointers they read are resolved here.
+    double parStart = stat->getClk();
+    static const u32_t NoWork = ~0U;
+    std::vector<u32_t> nodeToWork(nodes.size(), NoWork);
+    std::vector<LoadStoreWork> works;
+    for (u32_t i = 0; i < nodes.size(); ++i) {
+        const SVFGNode* node = svfg->getSVFGNode(nodes[i]);
+        const StmtSVFGNode* stmt = NULL;
+        if (const LoadSVFGNode* load = SVFUtil::dyn_cast<LoadSVFGNode>(node))
+            stmt = load;
+        else if (const StoreSVFGNode* store = SVFUtil::dyn_cast<StoreSVFGNode>(node)) {
+            /// Stores with an empty pointer are skipped by processStore
+            if (!getPts(store->getPAGDstNodeID()).empty())
+                stmt = store;
+        }
+        if (stmt == NULL)
+            continue;
+
+        nodeToWork[i] = works.size();
+        works.push_back(LoadStoreWork());
+        LoadStoreWork& work = works.back();
+        work.node = node;
+        work.srcPts = &getPts(stmt->getPAGSrcNodeID());
+        work.dstPts = &getPts(stmt->getPAGDstNodeID());
+        work.isSU = SVFUtil::isa<StoreSVFGNode>(node) && isStrongUpdate(node, work.singleton);
+    }
+    parallelFor(works.size(), numOfThreads, [&](u32_t i, u32_t tid) {
+        LoadStoreWork& work = works[i];
+        if (SVFUtil::isa<LoadSVFGNode>(work.node))
+            computeLoad(work);
+        else
+            computeStore(work);
+        threadProcessedNodes[tid]++;
+    }, 1);
+    double parEnd = stat->getClk();
+    timeOfParProcess += (parEnd - parStart) / TIMEINTERVAL;
+
+    /// 2. commit load/store nodes and process the other nodes in a fixed order.
+    /// Gep nodes may create gep objects, hence they are processed sequentially.
+    double seqStart = stat->getClk();
+    NodeVector changedNodes;
+    for (u32_t i = 0; i < nodes.size(); ++i) {
+        bool changed = false;
+        if (nodeToWork[i] == NoWork)
+            changed = processSVFGNode(svfg->getSVFGNode(nodes[i]));
+        else if (SVFUtil::isa<LoadSVFGNode>(works[nodeToWork[i]].node))
+            changed = commitLoad(works[nodeToWork[i]]);
+        else
+            changed = commitStore(works[nodeToWork[i]]);
+        if (changed)
+            changedNodes.push_back(nodes[i]);
+    }
+    double seqEnd = stat->getClk();
+    timeOfSeqProcess += (seqEnd - seqStart) / TIMEINTERVAL;
+
+    /// 3. direct edges are cheap and handled here, indirect edges are grouped
+    /// by destination and computed in parallel
+    double propStart = stat->getClk();
+    llvm::DenseMap<NodeID, u32_t> dstToWork;
+    std::vector<PropagationWork> propWorks;
+    for (NodeVector::const_iterator it = changedNodes.begin(), eit = changedNodes.end(); it != eit; ++it) {
+        SVFGNode* node = svfg->getSVFGNode(*it);
+        for (SVFGNode::const_iterator eIt = node->OutEdgeBegin(), eEit = node->OutEdgeEnd(); eIt != eEit; ++eIt) {
+            SVFGEdge* edge = *eIt;
+            NodeID dst = edge->getDstID();
+            if (DirectSVFGEdge* dirEdge = SVFUtil::dyn_cast<DirectSVFGEdge>(edge)) {
+                if (propAlongDirectEdge(dirEdge))
+                    pushIntoWorklist(dst);
+            }
+            else if (IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge)) {
+                llvm::DenseMap<NodeID, u32_t>::iterator wIt = dstToWork.find(dst);
+                u32_t idx;
+                if (wIt == dstToWork.end()) {
+                    idx = propWorks.size();
+                    dstToWork[dst] = idx;
+                    propWorks.push_back(PropagationWork());
+                    propWorks.back().dst = dst;
+                }
+                else
+                    idx = wIt->second;
+                propWorks[idx].edges.push_back(indEdge);
+            }
+            else
+                assert(false && "new kind of svfg edge?");
+        }
+    }
+    parallelFor(propWorks.size(), numOfThreads, [&](u32_t i, u32_t tid) {
+        computePropagation(propWorks[i]);
+        threadPropagatedNodes[tid]++;
+    }, 4);
+    double propEnd = stat->getClk();
+    timeOfParPropagation += (propEnd - propStart) / TIMEINTERVAL;
+
+    /// 4. commit IN sets in a fixed order
+    double mergeStart = stat->getClk();
+    for (std::vector<PropagationWork>::const_iterator it = propWorks.begin(), eit = propWorks.end(); it != eit; ++it) {
+        if (commitPropagation(*it))
+            pushIntoWorklist(it->dst);
+    }
+    for (NodeVector::const_iterator it = nodes.begin(), eit = nodes.end(); it != eit; ++it)
+        clearAllDFOutVarFlag(svfg->getSVFGNode(*it));
+    double mergeEnd = stat->getClk();
+    timeOfMergePropagation += (mergeEnd - mergeStart) / TIMEINTERVAL;
+}
+
+/*!
+ * Variables whose points-to is carried by an object.
+ * The fields of every field-insensitive object have been recorded when the PAG
+ * was built, so the lookup does not modify the PAG.
+ */
+void FlowSensitivePar::getObjVars(NodeID obj, NodeVector& vars) {
+    vars.push_back(obj);
+    if (isFIObjNode(obj)) {
+        const NodeBS& allFields = getAllFieldsObjNode(obj);
+        for (NodeBS::iterator it = allFields.begin(), eit = allFields.end(); it != eit; ++it)
+            vars.push_back(*it);
+    }
+}
+
+/*!
+ * New points-to of a load's pointer from the IN set of the load,
+ * the same as processLoad
+ */
+void FlowSensitivePar::computeLoad(LoadStoreWork& work) {
+    const IncDFPTDataTy* dfPT = getDFPTDataTy();
+    NodeID loc = work.node->getId();
+
+    NodeVector vars;
+    for (PointsTo::iterator it = work.srcPts->begin(), eit = work.srcPts->end(); it != eit; ++it) {
+        NodeID ptd = *it;
+        if (pag->isConstantObj(ptd) || pag->isNonPointerObj(ptd))
+            continue;
+        getObjVars(ptd, vars);
+    }
+
+    for (NodeVector::const_iterator it = vars.begin(), eit = vars.end(); it != eit; ++it) {
+        NodeID var = *it;
+        if (!dfPT->hasNewDFInPts(loc, var))
+            continue;
+        work.consumedVars.push_back(var);
+        if (const InternedPointsTo* inPts = dfPT->findDFInPtsSet(loc, var))
+            work.loadPts |= inPts->getPts();
+    }
+    work.loadPts.intersectWithComplement(*work.dstPts);
+}
+
+/*!
+ * New points-to of a store's OUT set, the same as processStore:
+ * the stored pointer's points-to flows into OUT[store:ptd], and IN flows into
+ * OUT for every variable except the one killed by a strong update.
+ */
+void FlowSensitivePar::computeStore(LoadStoreWork& work) {
+    const IncDFPTDataTy* dfPT = getDFPTDataTy();
+    NodeID loc = work.node->getId();
+
+    auto addOutPts = [&](NodeID var, const PointsTo& pts) {
+        PointsTo newPts = pts;
+        if (const InternedPointsTo* outPts = dfPT->findDFOutPtsSet(loc, var))
+            newPts.intersectWithComplement(outPts->getPts());
+        if (!newPts.empty())
+            work.outPts.push_back(VarPts(var, newPts));
+    };
+
+    if (!work.srcPts->empty()) {
+        for (PointsTo::iterator it = work.dstPts->begin(), eit = work.dstPts->end(); it != eit; ++it) {
+            NodeID ptd = *it;
+            if (pag->isConstantObj(ptd) || pag->isNonPointerObj(ptd))
+                continue;
+            addOutPts(ptd, *work.srcPts);
+        }
+    }
+
+    NodeVector vars;
+    dfPT->getNewDFInVars(loc, vars);
+    for (NodeVector::const_iterator it = vars.begin(), eit = vars.end(); it != eit; ++it) {
+        NodeID var = *it;
+        if (work.isSU && var == work.singleton)
+            continue;
+        work.consumedVars.push_back(var);
+        if (const InternedPointsTo* inPts = dfPT->findDFInPtsSet(loc, var))
+            addOutPts(var, inPts->getPts());
+    }
+}
+
+/*!
+ * New points-to of the IN set of a destination from all its changed predecessors,
+ * the same as propAlongIndirectEdge
+ */
+void FlowSensitivePar::computePropagation(PropagationWork& work) {
+    const IncDFPTDataTy* dfPT = getDFPTDataTy();
+
+    /// ordered by variable so that the commit order is fixed
+    std::map<NodeID, PointsTo> varToPts;
+    NodeVector vars;
+    for (std::vector<const IndirectSVFGEdge*>::const_iterator it = work.edges.begin(), eit = work.edges.end(); it != eit; ++it) {
+        const IndirectSVFGEdge* edge = *it;
+        NodeID srcLoc = edge->getSrcID();
+        bool fromOut = SVFUtil::isa<StoreSVFGNode>(edge->getSrcNode());
+
+        vars.clear();
+        const PointsTo& pts = edge->getPointsTo();
+        for (PointsTo::iterator ptdIt = pts.begin(), ptdEit = pts.end(); ptdIt != ptdEit; ++ptdIt)
+            getObjVars(*ptdIt, vars);
+
+        for (NodeVector::const_iterator vIt = vars.begin(), vEit = vars.end(); vIt != vEit; ++vIt) {
+            NodeID var = *vIt;
+            const InternedPointsTo* srcPts = NULL;
+            if (fromOut) {
+                if (dfPT->hasNewDFOutPts(srcLoc, var))
+                    srcPts = dfPT->findDFOutPtsSet(srcLoc, var);
+            }
+            else {
+                if (dfPT->hasNewDFInPts(srcLoc, var))
+                    srcPts = dfPT->findDFInPtsSet(srcLoc, var);
+            }
+            if (srcPts && !srcPts->empty())
+                varToPts[var] |= srcPts->getPts();
+        }
+    }
+
+    for (std::map<NodeID, PointsTo>::iterator it = varToPts.begin(), eit = varToPts.end(); it != eit; ++it) {
+        PointsTo& newPts = it->second;
+        if (const InternedPointsTo* dstPts = dfPT->findDFInPtsSet(work.dst, it->first))
+            newPts.intersectWithComplement(dstPts->getPts());
+        if (!newPts.empty())
+            work.inPts.push_back(VarPts(it->first, newPts));
+    }
+}
+
+/*!
+ * Commit a load node
+ */
+bool FlowSensitivePar::commitLoad(const LoadStoreWork& work) {
+    numOfProcessedLoad++;
+    const LoadSVFGNode* load = SVFUtil::cast<LoadSVFGNode>(work.node);
+    IncDFPTDataTy* dfPT = getDFPTDataTy();
+    for (NodeVector::const_iterator it = work.consumedVars.begin(), eit = work.consumedVars.end(); it != eit; ++it)
+        dfPT->clearDFInUpdatedVar(load->getId(), *it);
+    return unionPts(load->getPAGDstNodeID(), work.loadPts);
+}
+
+/*!
+ * Commit a store node
+ */
+bool FlowSensitivePar::commitStore(const LoadStoreWork& work) {
+    numOfProcessedStore++;
+    NodeID loc = work.node->getId();
+    IncDFPTDataTy* dfPT = getDFPTDataTy();
+    for (NodeVector::const_iterator it = work.consumedVars.begin(), eit = work.consumedVars.end(); it != eit; ++it)
+        dfPT->clearDFInUpdatedVar(loc, *it);
+
+    bool changed = false;
+    for (VarPtsVector::const_iterator it = work.outPts.begin(), eit = work.outPts.end(); it != eit; ++it) {
+        if (dfPT->unionDFOutPts(loc, it->first, it->second))
+            changed = true;
+    }
+
+    if (work.isSU)
+        svfgHasSU.set(loc);
+    else
+        svfgHasSU.reset(loc);
+    return changed;
+}
+
+/*!
+ * Commit the IN set of a destination node
+ */
+bool FlowSensitivePar::commitPropagation(const PropagationWork& work) {
+    IncDFPTDataTy* dfPT = getDFPTDataTy();
+    bool changed = false;
+    for (VarPtsVector::const_iterator it = work.inPts.begin(), eit = work.inPts.end(); it != eit; ++it) {
+        if (dfPT->unionDFInPts(work.dst, it->first, it->second))
+            changed = true;
+    }
+    return changed;
+}
@@ -230,6 +230,14 @@ void FlowSensitiveStat::performStat()
     timeStatMap["AvgINPtsSize"] = _AvgInOutPtsSize[IN];
     timeStatMap["AvgOUTPtsSize"] = _AvgInOutPtsSize[OUT];
 
+    /// IN/OUT sets are hash-consed in the PointsToTable
+    const PointsToTable& ptsTable = PointsToTable::getTable();
+    PTNumStatMap["DistinctPtsSets"] = ptsTable.getNumOfDistinctPts();
+    PTNumStatMap["PtsSetRefs"] = ptsTable.getNumOfPtsRefs();
+    PTNumStatMap["PtsMemoHits"] = ptsTable.getNumOfMemoHits();
+    PTNumStatMap["PtsMemoMisses"] = ptsTable.getNumOfMemoMisses();
+    timeStatMap["PtsSharingRatio"] = ptsTable.getSharingRatio();
+
     PTNumStatMap["ProcessedAddr"] = fspta->numOfProcessedAddr;
     PTNumStatMap["ProcessedCopy"] = fspta->numOfProcessedCopy;
     PTNumStatMap["ProcessedGep"] = fspta->numOfProcessedGep;
@@ -248,6 +256,49 @@ void FlowSensitiveStat::performStat()
 
     std::cout << "\n****Flow-Sensitive Pointer Analysis Statistics****\n";
     PTAStat::printStat();
+
+    if (SVFUtil::isa<FlowSensitivePar>(fspta))
+        parallelStat();
+}
+
+/*!
+ * Per-phase time and per-thread work of the parallel flow-sensitive analysis
+ */
+void FlowSensitiveStat::parallelStat() {
+    FlowSensitivePar* parPta = SVFUtil::cast<FlowSensitivePar>(fspta);
+    u32_t numOfThreads = parPta->getNumOfThreads();
+
+    timeStatMap["LevelTime"] = FlowSensitivePar::timeOfLevels;
+    timeStatMap["ParProcessTime"] = FlowSensitivePar::timeOfParProcess;
+    timeStatMap["SeqProcessTime"] = FlowSensitivePar::timeOfSeqProcess;
+    timeStatMap["ParPropaTime"] = FlowSensitivePar::timeOfParPropagation;
+    timeStatMap["MergePropaTime"] = FlowSensitivePar::timeOfMergePropagation;
+
+    PTNumStatMap["NumOfThreads"] = numOfThreads;
+    PTNumStatMap["NumOfLevels"] = FlowSensitivePar::numOfLevels;
+    PTNumStatMap["NumOfRounds"] = FlowSensitivePar::numOfRounds;
+    PTNumStatMap["MaxRoundWidth"] = FlowSensitivePar::maxRoundWidth;
+
+    /// Names are built first as the stat maps keep the raw string pointers
+    threadStatNames.clear();
+    for (u32_t tid = 0; tid < numOfThreads; ++tid) {
+        threadStatNames.push_back("T" + std::to_string(tid) + "Nodes");
+        threadStatNames.push_back("T" + std::to_string(tid) + "Dsts");
+    }
+    u64_t totalDsts = 0;
+    u64_t maxDsts = 0;
+    for (u32_t tid = 0; tid < numOfThreads; ++tid) {
+        u64_t dsts = FlowSensitivePar::threadPropagatedNodes[tid];
+        PTNumStatMap[threadStatNames[2 * tid].c_str()] = FlowSensitivePar::threadProcessedNodes[tid];
+        PTNumStatMap[threadStatNames[2 * tid + 1].c_str()] = dsts;
+        totalDsts += dsts;
+        if (dsts > maxDsts)
+            maxDsts = dsts;
+    }
+    /// ideal balance is 100%, i.e., the busiest thread does 1/numOfThreads of the propagation
+    PTNumStatMap["PropaWorkBalance(%)"] = maxDsts == 0 ? 100 : (u32_t)(100 * totalDsts / (maxDsts * numOfThreads));
+
+    PTAStat::printStat("Parallel Flow-Sensitive Analysis Stats");
 }
 
 void FlowSensitiveStat::statNullPtr()
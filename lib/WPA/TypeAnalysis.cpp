@@ -33,6 +33,7 @@
 #include "Util/PTAStat.h"
 #include "Util/ICFGStat.h"
 #include "Util/VFG.h"
+#include "Util/GraphExporter.h"
 
 using namespace SVFUtil;
 using namespace cppUtil;
@@ -43,13 +44,16 @@ llvm::cl::opt<bool> genICFG("genicfg", llvm::cl::init(true), llvm::cl::desc("Gen
 /// Initialize analysis
 void TypeAnalysis::initialize(SVFModule svfModule) {
     Andersen::initialize(svfModule);
-	if (genICFG) {
-		icfg = new ICFG(ptaCallGraph);
-		icfg->dump("icfg_initial");
-		icfg->getVFG()->dump("vfg_initial");
-		if (print_stat)
-			icfg->getStat()->performStat();
-	}
+}
+
+/// Build ICFG once the call graph is resolved, as it covers built functions only with -reachable-funs
+void TypeAnalysis::buildICFG() {
+	icfg = new ICFG(ptaCallGraph);
+	icfg->dump("icfg_initial");
+	GraphExporter::exportICFG(icfg);
+	icfg->getVFG()->dump("vfg_initial");
+	if (print_stat)
+		icfg->getStat()->performStat();
 }
 
 /// Finalize analysis
@@ -63,6 +67,14 @@ void TypeAnalysis::analyze(SVFModule svfModule){
 	initialize(svfModule);
     CallEdgeMap newEdges;
 	callGraphSolveBasedOnCHA(getIndirectCallsites(), newEdges);
+	/// callees resolved with -reachable-funs are built, and their virtual calls resolved in turn
+	while (pag->isReachableOnly() && !newEdges.empty()) {
+		buildReachedCallees(newEdges);
+		newEdges.clear();
+		callGraphSolveBasedOnCHA(getIndirectCallsites(), newEdges);
+	}
+	if (genICFG)
+		buildICFG();
 	finalize();
 }
 
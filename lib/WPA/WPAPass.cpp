@@ -40,6 +40,7 @@
 #include "WPA/AndersenSFR.h"
 #include "WPA/FlowSensitive.h"
 #include "WPA/TypeAnalysis.h"
+#include "Util/AliasQueryServer.h"
 
 char WPAPass::ID = 0;
 
@@ -60,7 +61,9 @@ static llvm::cl::bits<PointerAnalysis::PTATY> PASelected(llvm::cl::desc("Select
             clEnumValN(PointerAnalysis::AndersenWaveDiff_WPA, "wander", "Wave propagation inclusion-based analysis"),
             clEnumValN(PointerAnalysis::AndersenWaveDiff_WPA, "ander", "Diff wave propagation inclusion-based analysis"),
             clEnumValN(PointerAnalysis::AndersenWaveDiffWithType_WPA, "andertype", "Diff wave propagation with type inclusion-based analysis"),
+            clEnumValN(PointerAnalysis::AndersenWaveDiffPar_WPA, "pwander", "Parallel diff wave propagation inclusion-based analysis"),
             clEnumValN(PointerAnalysis::FSSPARSE_WPA, "fspta", "Sparse flow sensitive pointer analysis"),
+            clEnumValN(PointerAnalysis::FSSPARSEPar_WPA, "pfspta", "Parallel sparse flow sensitive pointer analysis"),
 			clEnumValN(PointerAnalysis::TypeCPP_WPA, "type", "Type-based fast analysis for Callgraph, PAG and CHA")
         ));
 
@@ -100,49 +103,59 @@ void WPAPass::runOnModule(SVFModule svfModule) {
             runPointerAnalysis(svfModule, i);
     }
     assert(!ptaVector.empty() && "No pointer analysis is specified.\n");
+
+    if (AliasQueryServer::isEnabled()) {
+        AliasQueryServer server(_pta);
+        server.run();
+    }
 }
 
 
 /*!
- * Create pointer analysis according to a specified kind and then analyze the module.
+ * Create pointer analysis according to a specified kind
  */
-void WPAPass::runPointerAnalysis(SVFModule svfModule, u32_t kind)
+PointerAnalysis* WPAPass::createPointerAnalysis(u32_t kind)
 {
-    /// Initialize pointer analysis.
     switch (kind) {
         case PointerAnalysis::Andersen_WPA:
-            _pta = new Andersen();
-            break;
+            return new Andersen();
         case PointerAnalysis::AndersenLCD_WPA:
-            _pta = new AndersenLCD();
-            break;
+            return new AndersenLCD();
         case PointerAnalysis::AndersenHCD_WPA:
-            _pta = new AndersenHCD();
-            break;
+            return new AndersenHCD();
         case PointerAnalysis::AndersenHLCD_WPA:
-            _pta = new AndersenHLCD();
-            break;
+            return new AndersenHLCD();
         case PointerAnalysis::AndersenSCD_WPA:
-            _pta = new AndersenSCD();
-            break;
+            return new AndersenSCD();
         case PointerAnalysis::AndersenSFR_WPA:
-            _pta = new AndersenSFR();
-            break;
+            return new AndersenSFR();
         case PointerAnalysis::AndersenWaveDiff_WPA:
-            _pta = new AndersenWaveDiff();
-            break;
+            return new AndersenWaveDiff();
         case PointerAnalysis::AndersenWaveDiffWithType_WPA:
-            _pta = new AndersenWaveDiffWithType();
-            break;
+            return new AndersenWaveDiffWithType();
+        case PointerAnalysis::AndersenWaveDiffPar_WPA:
+            return new AndersenWaveDiffPar();
         case PointerAnalysis::FSSPARSE_WPA:
-            _pta = new FlowSensitive();
-            break;
+            return new FlowSensitive();
+        case PointerAnalysis::FSSPARSEPar_WPA:
+            return new FlowSensitivePar();
         case PointerAnalysis::TypeCPP_WPA:
-            _pta = new TypeAnalysis();
-            break;
+            return new TypeAnalysis();
         default:
-            assert(false && "This pointer analysis has not been implemented yet.\n");
-            return;
+            return NULL;
+    }
+}
+
+/*!
+ * Create pointer analysis according to a specified kind and then analyze the module.
+ */
+void WPAPass::runPointerAnalysis(SVFModule svfModule, u32_t kind)
+{
+    /// Initialize pointer analysis.
+    _pta = createPointerAnalysis(kind);
+    if (_pta == NULL) {
+        assert(false && "This pointer analysis has not been implemented yet.\n");
+        return;
     }
 
     ptaVector.push_back(_pta);
@@ -0,0 +1,596 @@
+//===- svf-bench.cpp -- Benchmark driver of the analyses ---------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // Benchmark driver
+ //
+ // Runs a matrix of analyses on the programs listed in a manifest, each run
+ // in a forked process so that runs do not share the analysis singletons and
+ // the peak RSS of every run is measured on its own. The manifest lists one
+ // program per line as its bitcode files separated by spaces, lines starting
+ // with '#' are ignored. The results are printed as JSON:
+ //
+ //   svf-bench -bench-analyses=nander,wander,fspta -bench-repeat=5 manifest.txt
+ //
+ // A parallel analysis is checked against its sequential reference (e.g.,
+ // pwander against wander): the checksum of its points-to results must be the
+ // same, otherwise the driver reports the mismatch and exits with 1.
+ //
+ // With -bench-worklists, it instead compares the dense worklists of
+ // Util/WorkList.h with the std::set based ones on a solver-like trace.
+ */
+
+#include "WPA/WPAPass.h"
+#include "WPA/Andersen.h"
+#include "SABER/LeakChecker.h"
+#include "SABER/FileChecker.h"
+#include "SABER/DoubleFreeChecker.h"
+#include "Util/PTAStat.h"
+#include "Util/WorkList.h"
+#ifdef SVF_ENABLE_DDA_MTA
+#include "DDA/ContextDDA.h"
+#include "DDA/DDAClient.h"
+#include "MTA/MTA.h"
+#endif
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace llvm;
+using namespace std;
+
+static llvm::cl::opt<std::string> ManifestFile(cl::Positional,
+        llvm::cl::desc("<manifest>"), llvm::cl::init(""));
+
+static llvm::cl::list<std::string> BenchAnalyses("bench-analyses", llvm::cl::CommaSeparated,
+        llvm::cl::desc("Analyses to run (default wander)"));
+
+static llvm::cl::opt<u32_t> BenchRepeat("bench-repeat",  llvm::cl::init(3),
+                                        llvm::cl::desc("Number of runs of every analysis on every program"));
+
+static llvm::cl::opt<std::string> BenchOutput("bench-out",  llvm::cl::init(""),
+        llvm::cl::value_desc("file"),
+        llvm::cl::desc("Write the results to a file instead of stdout"));
+
+static llvm::cl::opt<bool> BenchVerbose("bench-verbose",  llvm::cl::init(false),
+                                        llvm::cl::desc("Keep the output of the analyses"));
+
+static llvm::cl::opt<bool> BenchCheckReference("bench-check-reference",  llvm::cl::init(true),
+        llvm::cl::desc("Check the results of parallel analyses against their sequential references"));
+
+static llvm::cl::opt<bool> BenchWorkLists("bench-worklists",  llvm::cl::init(false),
+        llvm::cl::desc("Compare the dense worklists with the std::set based ones instead of running analyses"));
+
+static llvm::cl::opt<u32_t> BenchWorkListIDs("bench-worklist-ids",  llvm::cl::init(1000000),
+        llvm::cl::desc("Number of distinct IDs of the worklist benchmark"));
+
+/// Kinds of analyses run by the driver
+enum BenchKind {
+    BenchWPA, BenchDDA, BenchSaber, BenchMTA
+};
+
+struct BenchAnalysis {
+    const char* name;
+    BenchKind kind;
+    u32_t type;			///< PointerAnalysis::PTATY of pointer analyses
+    const char* desc;
+    const char* reference;	///< analysis computing the same results sequentially, NULL if none
+};
+
+/// Names follow the options of wpa, dda, saber and mta
+static const BenchAnalysis benchAnalyses[] = {
+    {"nander", BenchWPA, PointerAnalysis::Andersen_WPA, "Standard inclusion-based analysis", NULL},
+    {"lander", BenchWPA, PointerAnalysis::AndersenLCD_WPA, "Lazy cycle detection inclusion-based analysis", NULL},
+    {"hander", BenchWPA, PointerAnalysis::AndersenHCD_WPA, "Hybrid cycle detection inclusion-based analysis", NULL},
+    {"hlander", BenchWPA, PointerAnalysis::AndersenHLCD_WPA, "Hybrid lazy cycle detection inclusion-based analysis", NULL},
+    {"sander", BenchWPA, PointerAnalysis::AndersenSCD_WPA, "Selective cycle detection inclusion-based analysis", NULL},
+    {"sfrander", BenchWPA, PointerAnalysis::AndersenSFR_WPA, "Stride-based field representation inclusion-based analysis", NULL},
+    {"wander", BenchWPA, PointerAnalysis::AndersenWaveDiff_WPA, "Diff wave propagation inclusion-based analysis", NULL},
+    {"andertype", BenchWPA, PointerAnalysis::AndersenWaveDiffWithType_WPA, "Diff wave propagation with type inclusion-based analysis", NULL},
+    {"pwander", BenchWPA, PointerAnalysis::AndersenWaveDiffPar_WPA, "Parallel diff wave propagation inclusion-based analysis", "wander"},
+    {"fspta", BenchWPA, PointerAnalysis::FSSPARSE_WPA, "Sparse flow sensitive pointer analysis", NULL},
+    {"pfspta", BenchWPA, PointerAnalysis::FSSPARSEPar_WPA, "Parallel sparse flow sensitive pointer analysis", "fspta"},
+    {"cxt", BenchDDA, PointerAnalysis::Cxt_DDA, "Demand-driven context- flow- sensitive analysis of all pointers", NULL},
+    {"leak", BenchSaber, 0, "Memory leak detection", NULL},
+    {"fileck", BenchSaber, 1, "File open/close detection", NULL},
+    {"dfree", BenchSaber, 2, "Double free detection", NULL},
+    {"mta", BenchMTA, 0, "Analysis for multithreaded programs", NULL},
+};
+
+static const BenchAnalysis* getBenchAnalysis(const std::string& name) {
+    for (u32_t i = 0; i < sizeof(benchAnalyses) / sizeof(benchAnalyses[0]); ++i) {
+        if (name == benchAnalyses[i].name)
+            return &benchAnalyses[i];
+    }
+    return NULL;
+}
+
+/// DDA and MTA libraries are only linked when enabled in lib/CMakeLists.txt
+static bool isBuiltIn(const BenchAnalysis& analysis) {
+#ifdef SVF_ENABLE_DDA_MTA
+    return true;
+#else
+    return analysis.kind != BenchDDA && analysis.kind != BenchMTA;
+#endif
+}
+
+static std::string escapeJSON(const std::string& str) {
+    std::string escaped;
+    for (std::string::const_iterator it = str.begin(), eit = str.end(); it != eit; ++it) {
+        if (*it == '"' || *it == '\\')
+            escaped += '\\';
+        escaped += *it;
+    }
+    return escaped;
+}
+
+/*!
+ * FNV-1a hash of the points-to sets of nodes in the order of their IDs
+ */
+static u64_t getPtsChecksum(PointerAnalysis* pta, const NodeSet& nodes) {
+    u64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](u64_t value) {
+        for (u32_t i = 0; i < 8; ++i, value >>= 8) {
+            hash ^= (value & 0xff);
+            hash *= 1099511628211ULL;
+        }
+    };
+    for (NodeSet::const_iterator it = nodes.begin(), eit = nodes.end(); it != eit; ++it) {
+        const PointsTo& pts = pta->getPts(*it);
+        if (pts.empty())
+            continue;
+        mix(*it);
+        for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit)
+            mix(*pit);
+    }
+    return hash;
+}
+
+static u64_t getPtsChecksum(PointerAnalysis* pta) {
+    NodeSet nodes;
+    PAG* pag = pta->getPAG();
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        nodes.insert(it->first);
+    return getPtsChecksum(pta, nodes);
+}
+
+/*!
+ * Run an analysis on a program in this process, and return its result as JSON
+ */
+static std::string runAnalysis(const BenchAnalysis& analysis, const std::vector<std::string>& moduleNames) {
+    std::vector<std::string> names(moduleNames);
+    SVFModule* svfModule;
+    {
+        PhaseProfiler::Scope phase("module load");
+        svfModule = new SVFModule(names);
+    }
+
+    u64_t checksum = 0;
+    switch (analysis.kind) {
+    case BenchWPA: {
+        PointerAnalysis* pta = WPAPass::createPointerAnalysis(analysis.type);
+        pta->analyze(*svfModule);
+        checksum = getPtsChecksum(pta);
+        break;
+    }
+    case BenchSaber: {
+        LeakChecker* saber;
+        if (analysis.type == 1)
+            saber = new FileChecker();
+        else if (analysis.type == 2)
+            saber = new DoubleFreeChecker();
+        else
+            saber = new LeakChecker();
+        saber->runOnModule(*svfModule);
+        checksum = getPtsChecksum(AndersenWaveDiff::createAndersenWaveDiff(*svfModule));
+        break;
+    }
+#ifdef SVF_ENABLE_DDA_MTA
+    case BenchDDA: {
+        VFPathCond::setMaxPathLen(100000);
+        ContextCond::setMaxCxtLen(3);
+        DDAClient* client = new DDAClient(*svfModule);
+        client->initialise(*svfModule);
+        ContextDDA* pta = new ContextDDA(*svfModule, client);
+        pta->initialize(*svfModule);
+        client->answerQueries(pta);
+        pta->finalize();
+        checksum = getPtsChecksum(pta, client->getCandidateQueries());
+        break;
+    }
+    case BenchMTA: {
+        MTA mta;
+        mta.runOnModule(*svfModule);
+        checksum = getPtsChecksum(AndersenWaveDiff::createAndersenWaveDiff(*svfModule));
+        break;
+    }
+#endif
+    default:
+        assert(false && "analysis is not built in this driver");
+        break;
+    }
+
+    std::ostringstream out;
+    out << "{\"checksum\":\"" << std::hex << checksum << std::dec << "\""
+        << ",\"iterations\":" << PhaseProfiler::getNumOfPhases("solve iteration")
+        << ",\"profile\":";
+    PhaseProfiler::printSummary(out);
+    out << "}";
+    return out.str();
+}
+
+/// Result of a run
+struct BenchRun {
+    std::string status;
+    double wallMs;
+    u64_t peakRSS;
+    std::string result;		///< JSON returned by the analysis process
+    std::string checksum;
+};
+
+/*!
+ * Run an analysis in a forked process, measuring its wall time and peak RSS
+ */
+static BenchRun forkAnalysis(const BenchAnalysis& analysis, const std::vector<std::string>& moduleNames) {
+    BenchRun run;
+    run.wallMs = 0;
+    run.peakRSS = 0;
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        run.status = "pipe failed";
+        return run;
+    }
+    SVFUtil::outs().flush();
+    SVFUtil::errs().flush();
+    std::cout.flush();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        run.status = "fork failed";
+        return run;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        if (!BenchVerbose) {
+            int null = open("/dev/null", O_WRONLY);
+            dup2(null, STDOUT_FILENO);
+            dup2(null, STDERR_FILENO);
+        }
+        PhaseProfiler::enable();
+        std::string result = runAnalysis(analysis, moduleNames);
+        for (size_t written = 0; written < result.size();) {
+            ssize_t n = write(fds[1], result.data() + written, result.size() - written);
+            if (n <= 0)
+                break;
+            written += n;
+        }
+        close(fds[1]);
+        _exit(0);
+    }
+
+    close(fds[1]);
+    char chunk[4096];
+    ssize_t n;
+    while ((n = read(fds[0], chunk, sizeof(chunk))) > 0)
+        run.result.append(chunk, n);
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    run.wallMs = std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - start).count() / 1000.0;
+    run.peakRSS = usage.ru_maxrss;
+
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && !run.result.empty())
+        run.status = "ok";
+    else if (WIFSIGNALED(status))
+        run.status = "killed by signal " + std::to_string(WTERMSIG(status));
+    else
+        run.status = "failed";
+
+    std::string::size_type pos = run.result.find("\"checksum\":\"");
+    if (pos != std::string::npos) {
+        pos += 12;
+        run.checksum = run.result.substr(pos, run.result.find('"', pos) - pos);
+    }
+    return run;
+}
+
+/*!
+ * Priority worklists of the benchmark, the priority of an ID is fixed by
+ * priorities, as a topological order is in the solvers
+ */
+//@{
+static const std::vector<u32_t>* priorities = NULL;
+
+class DensePriorityBench {
+public:
+    inline bool empty() const {
+        return worklist.empty();
+    }
+    inline bool push(u32_t id) {
+        return worklist.push(id, (*priorities)[id]);
+    }
+    inline u32_t pop() {
+        return worklist.pop();
+    }
+private:
+    DensePriorityWorkList worklist;
+};
+
+class SetPriorityBench {
+public:
+    inline bool empty() const {
+        return worklist.empty();
+    }
+    inline bool push(u32_t id) {
+        return worklist.insert(std::make_pair((*priorities)[id], id)).second;
+    }
+    inline u32_t pop() {
+        u32_t id = worklist.begin()->second;
+        worklist.erase(worklist.begin());
+        return id;
+    }
+private:
+    std::set<std::pair<u32_t, u32_t> > worklist;
+};
+//@}
+
+/*!
+ * Replay a trace as a solver does: the first numOfSeeds IDs are pushed,
+ * then every pop pushes the next two IDs of the trace (often already in the list).
+ * Return the hash of the popped IDs in their order.
+ */
+template<class WorkList>
+static u64_t replayTrace(const std::vector<u32_t>& trace, u32_t numOfSeeds, double& wallMs) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    u64_t hash = 0;
+    {
+        WorkList worklist;
+        size_t next = 0;
+        for (; next < numOfSeeds && next < trace.size(); ++next)
+            worklist.push(trace[next]);
+        while (!worklist.empty()) {
+            hash = hash * 1099511628211ULL + (u32_t)worklist.pop();
+            for (u32_t i = 0; i < 2 && next < trace.size(); ++i)
+                worklist.push(trace[next++]);
+        }
+    }
+    wallMs = std::chrono::duration_cast<std::chrono::microseconds>(
+                 std::chrono::steady_clock::now() - start).count() / 1000.0;
+    return hash;
+}
+
+/*!
+ * Median wall time of replaying a trace by a dense worklist and a std::set based one.
+ * FIFOWorkList<u64_t> and FILOWorkList<u64_t> are not specialised, so they are the std::set based ones.
+ */
+template<class DenseWorkList, class SetWorkList>
+static void benchWorkList(const char* name, const std::vector<u32_t>& trace, u32_t numOfSeeds, std::ostream& out) {
+    std::vector<double> denseTimes, setTimes;
+    bool sameOrder = true;
+    u32_t repeat = BenchRepeat == 0 ? 1 : BenchRepeat;
+    for (u32_t i = 0; i < repeat; ++i) {
+        double denseMs = 0, setMs = 0;
+        u64_t denseHash = replayTrace<DenseWorkList>(trace, numOfSeeds, denseMs);
+        u64_t setHash = replayTrace<SetWorkList>(trace, numOfSeeds, setMs);
+        sameOrder &= (denseHash == setHash);
+        denseTimes.push_back(denseMs);
+        setTimes.push_back(setMs);
+    }
+    std::sort(denseTimes.begin(), denseTimes.end());
+    std::sort(setTimes.begin(), setTimes.end());
+    double denseMs = denseTimes[denseTimes.size() / 2];
+    double setMs = setTimes[setTimes.size() / 2];
+    out << "{\"worklist\":\"" << name << "\",\"denseMedianMs\":" << denseMs << ",\"setMedianMs\":" << setMs
+        << ",\"speedup\":" << (denseMs > 0 ? setMs / denseMs : 0) << ",\"sameOrder\":" << (sameOrder ? "true" : "false") << "}";
+}
+
+/*!
+ * Worklist microbenchmark over a random trace of 4 * BenchWorkListIDs pushes of BenchWorkListIDs distinct IDs
+ */
+static std::string benchWorkLists() {
+    u32_t numOfIDs = BenchWorkListIDs == 0 ? 1 : BenchWorkListIDs;
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<u32_t> dist(0, numOfIDs - 1);
+    std::vector<u32_t> trace(4 * (size_t)numOfIDs);
+    for (size_t i = 0; i < trace.size(); ++i)
+        trace[i] = dist(rng);
+    std::vector<u32_t> order(numOfIDs);
+    for (u32_t i = 0; i < numOfIDs; ++i)
+        order[i] = dist(rng);
+    priorities = &order;
+
+    u32_t numOfSeeds = numOfIDs / 4;
+    std::ostringstream out;
+    out << "{\"ids\":" << numOfIDs << ",\"pushes\":" << trace.size() << ",\"repeat\":" << BenchRepeat << ",\"results\":[\n";
+    benchWorkList<FIFOWorkList<u32_t>, FIFOWorkList<u64_t> >("fifo", trace, numOfSeeds, out);
+    out << ",\n";
+    benchWorkList<FILOWorkList<u32_t>, FILOWorkList<u64_t> >("filo", trace, numOfSeeds, out);
+    out << ",\n";
+    benchWorkList<DensePriorityBench, SetPriorityBench>("priority", trace, numOfSeeds, out);
+    out << "\n]}\n";
+    return out.str();
+}
+
+/*!
+ * Read the programs of a manifest, each as the list of its bitcode files
+ */
+static bool readManifest(const std::string& file, std::vector<std::vector<std::string> >& programs) {
+    std::ifstream in(file.c_str());
+    if (!in.is_open())
+        return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream ss(line);
+        std::vector<std::string> modules;
+        std::string module;
+        while (ss >> module)
+            modules.push_back(module);
+        if (!modules.empty() && modules[0][0] != '#')
+            programs.push_back(modules);
+    }
+    return true;
+}
+
+int main(int argc, char ** argv) {
+
+    cl::ParseCommandLineOptions(argc, argv, "Benchmark driver of the analyses\n");
+
+    if (BenchWorkLists) {
+        std::cout << benchWorkLists();
+        return 0;
+    }
+    if (ManifestFile.empty()) {
+        SVFUtil::errs() << SVFUtil::errMsg("no manifest given") << "\n";
+        return 1;
+    }
+
+    std::vector<std::string> analysisNames(BenchAnalyses.begin(), BenchAnalyses.end());
+    if (analysisNames.empty())
+        analysisNames.push_back("wander");
+    std::vector<const BenchAnalysis*> analyses;
+    for (std::vector<std::string>::const_iterator it = analysisNames.begin(), eit = analysisNames.end(); it != eit; ++it) {
+        const BenchAnalysis* analysis = getBenchAnalysis(*it);
+        if (analysis && !isBuiltIn(*analysis)) {
+            SVFUtil::errs() << SVFUtil::errMsg("analysis is not built in this driver: ") << *it
+                            << ", build with SVF_ENABLE_DDA_MTA defined\n";
+            return 1;
+        }
+        if (analysis == NULL) {
+            SVFUtil::errs() << SVFUtil::errMsg("unknown analysis ") << *it << ", available analyses:\n";
+            for (u32_t i = 0; i < sizeof(benchAnalyses) / sizeof(benchAnalyses[0]); ++i)
+                SVFUtil::errs() << "  " << benchAnalyses[i].name << "\t" << benchAnalyses[i].desc << "\n";
+            return 1;
+        }
+        analyses.push_back(analysis);
+    }
+
+    std::vector<std::vector<std::string> > programs;
+    if (!readManifest(ManifestFile, programs)) {
+        SVFUtil::errs() << SVFUtil::errMsg("can not read manifest ") << ManifestFile << "\n";
+        return 1;
+    }
+
+    std::ostringstream out;
+    out << "{\"manifest\":\"" << escapeJSON(ManifestFile) << "\",\"repeat\":" << BenchRepeat << ",\"results\":[";
+    bool first = true;
+    bool allMatchReferences = true;
+    for (std::vector<std::vector<std::string> >::const_iterator pit = programs.begin(), epit = programs.end(); pit != epit; ++pit) {
+        /// checksums of the analyses run on this program, reused as references
+        std::map<std::string, std::string> checksums;
+        for (std::vector<const BenchAnalysis*>::const_iterator ait = analyses.begin(), eait = analyses.end(); ait != eait; ++ait) {
+            SVFUtil::errs() << "svf-bench: " << (*ait)->name << " on " << pit->front() << "\n";
+
+            std::vector<BenchRun> runs;
+            for (u32_t i = 0; i < BenchRepeat; ++i)
+                runs.push_back(forkAnalysis(**ait, *pit));
+
+            /// the wall time of a configuration is the median of its runs
+            std::vector<double> wallTimes;
+            u64_t peakRSS = 0;
+            bool stable = true;
+            for (std::vector<BenchRun>::const_iterator rit = runs.begin(), erit = runs.end(); rit != erit; ++rit) {
+                wallTimes.push_back(rit->wallMs);
+                peakRSS = std::max(peakRSS, rit->peakRSS);
+                stable &= (rit->checksum == runs.front().checksum);
+            }
+            std::sort(wallTimes.begin(), wallTimes.end());
+            if (stable && !runs.empty() && runs.front().status == "ok")
+                checksums[(*ait)->name] = runs.front().checksum;
+
+            /// the reference is run once if it is not one of the analyses run before
+            std::string referenceChecksum;
+            bool matchesReference = true;
+            if (BenchCheckReference && (*ait)->reference) {
+                std::map<std::string, std::string>::const_iterator cit = checksums.find((*ait)->reference);
+                if (cit != checksums.end()) {
+                    referenceChecksum = cit->second;
+                }
+                else {
+                    SVFUtil::errs() << "svf-bench: reference " << (*ait)->reference << " on " << pit->front() << "\n";
+                    BenchRun refRun = forkAnalysis(*getBenchAnalysis((*ait)->reference), *pit);
+                    if (refRun.status == "ok")
+                        referenceChecksum = checksums[(*ait)->reference] = refRun.checksum;
+                }
+                for (std::vector<BenchRun>::const_iterator rit = runs.begin(), erit = runs.end(); rit != erit; ++rit)
+                    matchesReference &= (!referenceChecksum.empty() && rit->checksum == referenceChecksum);
+                if (!matchesReference) {
+                    allMatchReferences = false;
+                    SVFUtil::errs() << SVFUtil::errMsg("results differ from the reference ") << (*ait)->reference
+                                    << ": " << (*ait)->name << " on " << pit->front() << "\n";
+                }
+            }
+
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"program\":[";
+            for (u32_t i = 0; i < pit->size(); ++i)
+                out << (i ? "," : "") << "\"" << escapeJSON((*pit)[i]) << "\"";
+            out << "],\"analysis\":\"" << (*ait)->name << "\"";
+            if (!wallTimes.empty()) {
+                out << ",\"medianWallMs\":" << wallTimes[wallTimes.size() / 2]
+                    << ",\"minWallMs\":" << wallTimes.front();
+            }
+            out << ",\"peakRSSKB\":" << peakRSS << ",\"checksumStable\":" << (stable ? "true" : "false");
+            if (BenchCheckReference && (*ait)->reference) {
+                out << ",\"reference\":\"" << (*ait)->reference << "\",\"referenceChecksum\":\"" << referenceChecksum
+                    << "\",\"matchesReference\":" << (matchesReference ? "true" : "false");
+            }
+            out << ",\"runs\":[";
+            for (u32_t i = 0; i < runs.size(); ++i) {
+                out << (i ? ",\n" : "\n") << "{\"status\":\"" << escapeJSON(runs[i].status) << "\""
+                    << ",\"wallMs\":" << runs[i].wallMs << ",\"peakRSSKB\":" << runs[i].peakRSS
+                    << ",\"result\":" << (runs[i].result.empty() ? "null" : runs[i].result) << "}";
+            }
+            out << "]}";
+        }
+    }
+    out << "\n]}\n";
+
+    if (BenchOutput.empty()) {
+        std::cout << out.str();
+    }
+    else {
+        std::ofstream file(BenchOutput.c_str());
+        if (!file.is_open()) {
+            SVFUtil::errs() << SVFUtil::errMsg("can not write results to ") << BenchOutput << "\n";
+            return 1;
+        }
+        file << out.str();
+    }
+
+    return allMatchReferences ? 0 : 1;
+}